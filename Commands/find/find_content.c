@@ -0,0 +1,269 @@
+/*
+ * find_content.c - find 파일 내용 검색 모듈
+ *
+ * 문자열 검색의 후보 거르기 (SSE2):
+ *   문자열의 rare1, rare2 위치 바이트를 16개씩 복제한 레지스터와
+ *   본문의 (i + rare1), (i + rare2)부터 읽은 16바이트를 각각 비교하고 AND하면,
+ *   두 바이트가 모두 맞는 시작 위치 i만 비트로 남습니다.
+ *   드문 바이트를 고를수록 후보가 적어 memcmp 호출이 줄어듭니다.
+ */
+
+#include "find_content.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+int content_check_regex(const char *pattern) {
+    regex_t regex;
+    int err = regcomp(&regex, pattern, REG_EXTENDED | REG_NOSUB | REG_NEWLINE);
+    if (err != 0) {
+        char message[256];
+        regerror(err, &regex, message, sizeof(message));
+        fprintf(stderr, "오류: -G 정규식이 잘못되었습니다: %s\n", message);
+        return -1;
+    }
+    regfree(&regex);
+    return 0;
+}
+
+/**
+ * 바이트가 일반적인 파일에 얼마나 자주 나오는지 대략적인 순위 (클수록 흔함)
+ */
+static int byte_rank(unsigned char c) {
+    if (c == ' ' || c == '\n' || c == '\0') {
+        return 250;
+    }
+    if (strchr("etaoinsrhl", c)) {
+        return 220;
+    }
+    if (c >= 'a' && c <= 'z') {
+        return 180;
+    }
+    if (strchr("\t_.,;:()=/-\"'*", c)) {
+        return 160;
+    }
+    if (c >= '0' && c <= '9') {
+        return 140;
+    }
+    if (c >= 'A' && c <= 'Z') {
+        return 120;
+    }
+    return 60;  // 그 외 기호, 제어 문자, 0x80 이상
+}
+
+void content_compile(find_content_t *content, char *literal, const char *regex) {
+    memset(content, 0, sizeof(*content));
+
+    if (!literal) {
+        content->is_regex = true;
+        // 옵션 파싱에서 이미 검사했으므로 실패하지 않음
+        regcomp(&content->regex, regex, REG_EXTENDED | REG_NOSUB | REG_NEWLINE);
+        return;
+    }
+
+    content->needle = literal;
+    content->len = strlen(literal);
+    if (content->len < 2) {
+        return;  // 한 바이트는 memchr로 검사
+    }
+
+    // 가장 드문 바이트 두 개의 위치 선택
+    size_t best = 0, second = 1;
+    if (byte_rank((unsigned char)literal[1]) < byte_rank((unsigned char)literal[0])) {
+        best = 1;
+        second = 0;
+    }
+    for (size_t i = 2; i < content->len; i++) {
+        int rank = byte_rank((unsigned char)literal[i]);
+        if (rank < byte_rank((unsigned char)literal[best])) {
+            second = best;
+            best = i;
+        } else if (rank < byte_rank((unsigned char)literal[second])) {
+            second = i;
+        }
+    }
+    content->rare1 = best < second ? best : second;
+    content->rare2 = best < second ? second : best;
+}
+
+/**
+ * 본문에서 문자열을 찾는 내부 함수
+ *
+ * @return 찾으면 true
+ */
+static bool find_literal(const find_content_t *content, const char *hay, size_t n) {
+    const char *needle = content->needle;
+    size_t len = content->len;
+
+    if (len == 0) {
+        return true;
+    }
+    if (n < len) {
+        return false;
+    }
+    if (len == 1) {
+        return memchr(hay, needle[0], n) != NULL;
+    }
+
+    size_t r1 = content->rare1, r2 = content->rare2;
+    size_t last = n - len;  // 가능한 마지막 시작 위치
+    size_t pos = 0;
+
+#ifdef __SSE2__
+    const __m128i first = _mm_set1_epi8(needle[r1]);
+    const __m128i second = _mm_set1_epi8(needle[r2]);
+
+    // 시작 위치 pos..pos+15의 후보를 한 번에 검사 (읽는 범위가 본문 안에 있을 때까지)
+    while (pos + 15 <= last) {
+        __m128i a = _mm_loadu_si128((const __m128i *)(hay + pos + r1));
+        __m128i b = _mm_loadu_si128((const __m128i *)(hay + pos + r2));
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, first),
+                                                                  _mm_cmpeq_epi8(b, second)));
+        while (mask) {
+            size_t cand = pos + (size_t)__builtin_ctz(mask);
+            if (memcmp(hay + cand, needle, len) == 0) {
+                return true;
+            }
+            mask &= mask - 1;
+        }
+        pos += 16;
+    }
+#endif
+
+    // 남은 부분 (또는 SSE2가 없는 환경 전체)
+    for (; pos <= last; pos++) {
+        if (hay[pos + r1] == needle[r1] && hay[pos + r2] == needle[r2] &&
+            memcmp(hay + pos, needle, len) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * 줄 단위 본문에 정규식이 일치하는지 검사하는 내부 함수 (NUL 바이트가 있어도 끝까지 검사)
+ * hay[n]에 '\0'을 쓰므로 버퍼는 n + 1바이트 이상이어야 함
+ */
+static bool find_regex(const find_content_t *content, char *hay, size_t n) {
+    regmatch_t range;
+    hay[n] = '\0';  // REG_STARTEND를 모르는 구현을 위해 끝 표시
+    range.rm_so = 0;
+    range.rm_eo = (regoff_t)n;
+    return regexec(&content->regex, hay, 1, &range, REG_STARTEND) == 0;
+}
+
+/**
+ * EINTR을 처리하며 최대 len 바이트를 읽는 내부 함수
+ */
+static ssize_t read_some(int fd, char *buf, size_t len) {
+    ssize_t n;
+    do {
+        n = read(fd, buf, len);
+    } while (n < 0 && errno == EINTR);
+    return n;
+}
+
+bool content_match_at(const find_content_t *content, int dirfd, const char *name, const struct stat *st) {
+    if (!S_ISREG(st->st_mode)) {
+        return false;
+    }
+    if (!content->is_regex && content->len == 0) {
+        return true;  // 빈 문자열은 모든 파일에 들어 있음
+    }
+
+    int fd = openat(dirfd, name, O_RDONLY | O_NOFOLLOW | O_NOCTTY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    // 작은 파일은 파일 크기만큼만 할당 (색인의 크기는 오래됐을 수 있으므로 EOF까지 읽음)
+    size_t cap = FIND_CONTENT_BUF_SIZE;
+    if (st->st_size >= 0 && (unsigned long long)st->st_size + 1 < cap) {
+        cap = (size_t)st->st_size + 1;
+    }
+    if (cap < content->len + 4096) {
+        cap = content->len + 4096;
+    }
+    char *buf = malloc(cap + 1);  // 정규식 검사용 끝 표시 1바이트
+    if (!buf) {
+        fprintf(stderr, "find: 메모리 할당 실패\n");
+        exit(1);
+    }
+
+    bool found = false;
+    size_t have = 0;  // 앞 조각에서 넘어온 바이트 수
+
+    for (;;) {
+        if (have == cap) {
+            // 한 줄이 버퍼보다 긴 경우 (정규식): 버퍼를 늘림
+            char *grown = realloc(buf, cap * 2 + 1);
+            if (!grown) {
+                fprintf(stderr, "find: 메모리 할당 실패\n");
+                exit(1);
+            }
+            buf = grown;
+            cap *= 2;
+        }
+
+        ssize_t n = read_some(fd, buf + have, cap - have);
+        if (n < 0) {
+            break;  // 읽기 오류: 일치하지 않은 것으로 봄
+        }
+        // 일반 파일에서 요청보다 적게 읽혔다면 파일 끝 (EOF 확인용 read를 한 번 줄임)
+        int eof = (size_t)n < cap - have;
+        size_t total = have + (size_t)n;
+
+        if (!content->is_regex) {
+            // 문자열: 조각 경계에 걸친 일치를 위해 마지막 len-1 바이트를 다음 조각으로 넘김
+            if (find_literal(content, buf, total)) {
+                found = true;
+                break;
+            }
+            if (eof) {
+                break;
+            }
+            size_t keep = content->len - 1;
+            if (keep > total) {
+                keep = total;
+            }
+            memmove(buf, buf + total - keep, keep);
+            have = keep;
+        } else {
+            // 정규식: 마지막 개행까지만 검사하고 끝나지 않은 줄은 다음 조각으로 넘김
+            if (eof) {
+                found = total > 0 && find_regex(content, buf, total);
+                break;
+            }
+            const char *nl = memrchr(buf, '\n', total);
+            if (!nl) {
+                have = total;  // 아직 줄이 끝나지 않음: 더 읽음
+                continue;
+            }
+            if (find_regex(content, buf, (size_t)(nl - buf))) {
+                found = true;
+                break;
+            }
+            have = total - (size_t)(nl - buf) - 1;
+            memmove(buf, nl + 1, have);
+        }
+    }
+
+    free(buf);
+    close(fd);
+    return found;
+}
+
+void content_free(find_content_t *content) {
+    if (content->is_regex) {
+        regfree(&content->regex);
+    }
+    content->is_regex = false;
+}
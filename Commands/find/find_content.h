@@ -0,0 +1,77 @@
+/*
+ * find_content.h - find 파일 내용 검색 조건 선언
+ *
+ * 파일 내용에 문자열(-g) 또는 정규식(-G)이 들어 있는 일반 파일을 찾습니다.
+ * ("find ... | xargs grep -l"을 프로세스 없이 처리)
+ *
+ * - 파일은 큰 버퍼 단위로 read()하며, 첫 일치를 찾으면 바로 읽기를 멈춥니다.
+ * - 문자열 검색은 문자열에서 드물게 나오는 바이트 두 개를 골라, SSE2로
+ *   16바이트씩 두 바이트가 모두 맞는 위치만 후보로 찾은 뒤 memcmp로 확인합니다.
+ * - 정규식은 POSIX 확장 정규식(regcomp)이며 grep처럼 줄 단위로 검사합니다.
+ *
+ * 실행 계획에서 이 조건은 항상 마지막에 검사하므로, 다른 모든 조건을
+ * 통과한 파일만 엽니다.
+ */
+
+#ifndef FIND_CONTENT_H
+#define FIND_CONTENT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <regex.h>
+#include <sys/stat.h>
+
+/** 파일을 읽는 버퍼의 최대 크기 */
+#define FIND_CONTENT_BUF_SIZE (1024 * 1024)
+
+/**
+ * 컴파일된 내용 검색 조건
+ */
+typedef struct {
+    bool is_regex;          /**< true면 정규식, false면 문자열 */
+    char *needle;           /**< 찾을 문자열 (옵션 구조체의 문자열을 가리킴) */
+    size_t len;             /**< 문자열 길이 */
+    size_t rare1;           /**< 후보를 거를 첫 번째 바이트의 위치 (문자열 안) */
+    size_t rare2;           /**< 후보를 거를 두 번째 바이트의 위치 (rare1 < rare2) */
+    regex_t regex;          /**< 컴파일된 정규식 (is_regex) */
+} find_content_t;
+
+/**
+ * 정규식이 올바른지 검사 (옵션 파싱 단계에서 사용)
+ *
+ * @param pattern 정규식
+ * @return 올바르면 0, 아니면 -1 (오류 메시지 출력)
+ */
+int content_check_regex(const char *pattern);
+
+/**
+ * 내용 검색 조건 컴파일
+ *
+ * @param content 결과를 저장할 구조체
+ * @param literal 찾을 문자열 (-g, 없으면 NULL)
+ * @param regex 찾을 정규식 (-G, literal이 NULL일 때 사용)
+ */
+void content_compile(find_content_t *content, char *literal, const char *regex);
+
+/**
+ * 파일 내용이 조건에 맞는지 검사
+ *
+ * 일반 파일이 아니면 열지 않고 false를 반환합니다.
+ * 여러 스레드에서 동시에 호출해도 안전합니다.
+ *
+ * @param content 컴파일된 조건
+ * @param dirfd 기준 디렉토리 fd (AT_FDCWD면 현재 디렉토리)
+ * @param name dirfd 기준 경로
+ * @param st 파일 상태 정보
+ * @return 내용에 일치하는 부분이 있으면 true
+ */
+bool content_match_at(const find_content_t *content, int dirfd, const char *name, const struct stat *st);
+
+/**
+ * 내용 검색 조건의 메모리 해제
+ *
+ * @param content 해제할 조건
+ */
+void content_free(find_content_t *content);
+
+#endif /* FIND_CONTENT_H */
@@ -0,0 +1,718 @@
+/*
+ * find_dup.c - find 중복 파일 찾기 모듈
+ *
+ * 후보 목록을 (크기) → (크기, 앞부분 해시) → (크기, 전체 해시) 순으로 정렬하여
+ * 같은 값끼리 묶고, 묶음에 두 개 이상 남은 파일만 다음 단계로 넘깁니다.
+ * 마지막으로 해시가 같은 묶음의 내용을 직접 비교하므로 해시 충돌이 결과에 섞이지 않습니다.
+ *
+ * XXH64: 입력을 32바이트씩 네 개의 독립된 64비트 누산기로 나누어 처리하므로
+ * CPU가 네 곱셈을 동시에 실행할 수 있어 바이트 단위 해시보다 훨씬 빠릅니다.
+ */
+
+#include "find_dup.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdatomic.h>
+
+// === XXH64 ===
+
+#define XXH_P1 11400714785074694791ULL
+#define XXH_P2 14029467366897019727ULL
+#define XXH_P3 1609587929392839161ULL
+#define XXH_P4 9650029242287828579ULL
+#define XXH_P5 2870177450012600261ULL
+
+/**
+ * XXH64 스트리밍 상태
+ */
+typedef struct {
+    uint64_t v[4];              /**< 네 개의 누산기 */
+    uint64_t total;             /**< 지금까지 입력된 바이트 수 */
+    unsigned char mem[32];      /**< 32바이트가 안 되어 남겨 둔 입력 */
+    size_t mem_len;             /**< mem에 든 바이트 수 */
+} xxh64_state_t;
+
+static inline uint64_t rotl64(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t read64(const unsigned char *p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint32_t read32(const unsigned char *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint64_t xxh_round(uint64_t acc, uint64_t input) {
+    acc += input * XXH_P2;
+    acc = rotl64(acc, 31);
+    return acc * XXH_P1;
+}
+
+static inline uint64_t xxh_merge(uint64_t acc, uint64_t val) {
+    acc ^= xxh_round(0, val);
+    return acc * XXH_P1 + XXH_P4;
+}
+
+static void xxh64_init(xxh64_state_t *s) {
+    memset(s, 0, sizeof(*s));
+    s->v[0] = XXH_P1 + XXH_P2;
+    s->v[1] = XXH_P2;
+    s->v[2] = 0;
+    s->v[3] = -XXH_P1;
+}
+
+static void xxh64_update(xxh64_state_t *s, const void *data, size_t len) {
+    const unsigned char *p = data;
+    const unsigned char *end = p + len;
+    s->total += len;
+
+    // 앞에서 남은 입력을 먼저 32바이트로 채움
+    if (s->mem_len + len < 32) {
+        memcpy(s->mem + s->mem_len, p, len);
+        s->mem_len += len;
+        return;
+    }
+    if (s->mem_len > 0) {
+        size_t fill = 32 - s->mem_len;
+        memcpy(s->mem + s->mem_len, p, fill);
+        for (int i = 0; i < 4; i++) {
+            s->v[i] = xxh_round(s->v[i], read64(s->mem + i * 8));
+        }
+        p += fill;
+        s->mem_len = 0;
+    }
+
+    // 32바이트씩: 네 누산기는 서로 의존하지 않으므로 동시에 계산됨
+    uint64_t v0 = s->v[0], v1 = s->v[1], v2 = s->v[2], v3 = s->v[3];
+    while (p + 32 <= end) {
+        v0 = xxh_round(v0, read64(p));
+        v1 = xxh_round(v1, read64(p + 8));
+        v2 = xxh_round(v2, read64(p + 16));
+        v3 = xxh_round(v3, read64(p + 24));
+        p += 32;
+    }
+    s->v[0] = v0;
+    s->v[1] = v1;
+    s->v[2] = v2;
+    s->v[3] = v3;
+
+    memcpy(s->mem, p, (size_t)(end - p));
+    s->mem_len = (size_t)(end - p);
+}
+
+static uint64_t xxh64_digest(const xxh64_state_t *s) {
+    uint64_t h;
+    if (s->total >= 32) {
+        h = rotl64(s->v[0], 1) + rotl64(s->v[1], 7) + rotl64(s->v[2], 12) + rotl64(s->v[3], 18);
+        for (int i = 0; i < 4; i++) {
+            h = xxh_merge(h, s->v[i]);
+        }
+    } else {
+        h = s->v[2] + XXH_P5;  // 시드(0) + P5
+    }
+    h += s->total;
+
+    const unsigned char *p = s->mem;
+    const unsigned char *end = p + s->mem_len;
+    while (p + 8 <= end) {
+        h ^= xxh_round(0, read64(p));
+        h = rotl64(h, 27) * XXH_P1 + XXH_P4;
+        p += 8;
+    }
+    if (p + 4 <= end) {
+        h ^= (uint64_t)read32(p) * XXH_P1;
+        h = rotl64(h, 23) * XXH_P2 + XXH_P3;
+        p += 4;
+    }
+    while (p < end) {
+        h ^= (*p) * XXH_P5;
+        h = rotl64(h, 11) * XXH_P1;
+        p++;
+    }
+
+    h ^= h >> 33;
+    h *= XXH_P2;
+    h ^= h >> 29;
+    h *= XXH_P3;
+    h ^= h >> 32;
+    return h;
+}
+
+// === 후보 수집 ===
+
+void dup_init(find_dup_t *dup, const find_options_t *opts) {
+    memset(dup, 0, sizeof(*dup));
+    pthread_mutex_init(&dup->lock, NULL);
+    dup->threads = opts->jobs;
+    if (dup->threads < 1) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        dup->threads = cpus > 0 ? (int)cpus : 1;
+    }
+}
+
+void dup_collect(void *ctx, find_out_t *out, const char *path, size_t len, const struct stat *st) {
+    find_dup_t *dup = ctx;
+    (void)out;
+
+    // 내용이 있는 일반 파일만 대상
+    if (!S_ISREG(st->st_mode) || st->st_size == 0) {
+        return;
+    }
+
+    char *copy = malloc(len + 1);
+    if (!copy) {
+        fprintf(stderr, "find: 메모리 할당 실패\n");
+        exit(1);
+    }
+    memcpy(copy, path, len + 1);
+
+    pthread_mutex_lock(&dup->lock);
+    if (dup->count == dup->cap) {
+        dup->cap = dup->cap ? dup->cap * 2 : 1024;
+        dup_file_t *grown = realloc(dup->files, dup->cap * sizeof(dup_file_t));
+        if (!grown) {
+            fprintf(stderr, "find: 메모리 할당 실패\n");
+            exit(1);
+        }
+        dup->files = grown;
+    }
+    dup_file_t *file = &dup->files[dup->count++];
+    memset(file, 0, sizeof(*file));
+    file->path = copy;
+    file->size = st->st_size;
+    file->dev = st->st_dev;
+    file->ino = st->st_ino;
+    pthread_mutex_unlock(&dup->lock);
+}
+
+// === 해시 계산과 내용 비교 (여러 스레드) ===
+
+/**
+ * 여러 스레드로 나누어 하는 단계
+ */
+typedef enum {
+    PASS_HEAD,                  /**< 앞 4KB 해시 */
+    PASS_FULL,                  /**< 전체 해시 */
+    PASS_VERIFY                 /**< 묶음의 첫 대표 파일과 내용 비교 */
+} pass_kind_t;
+
+/**
+ * 한 단계의 작업
+ */
+typedef struct {
+    dup_file_t *files;          /**< 전체 후보 배열 (leader 번호로 찾음) */
+    dup_file_t **jobs;          /**< 처리할 파일들 (하드 링크 대표만) */
+    size_t job_count;           /**< 파일 수 */
+    atomic_size_t next;         /**< 다음에 가져갈 작업 번호 */
+    pass_kind_t kind;           /**< 단계 종류 */
+    atomic_int errors;          /**< 읽지 못한 파일 수 */
+} hash_pass_t;
+
+/**
+ * 파일을 limit 바이트까지 (full이면 끝까지) 읽어 해시 계산
+ *
+ * @return 성공시 0, 실패시 -1 (errno 설정)
+ */
+static int hash_file(const char *path, int full, char *buf, size_t buf_size, uint64_t *hash) {
+    int fd = open(path, O_RDONLY | O_NOCTTY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+    if (full) {
+        posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    }
+
+    xxh64_state_t state;
+    xxh64_init(&state);
+    size_t limit = full ? (size_t)-1 : FIND_DUP_HEAD_SIZE;
+    size_t done = 0;
+
+    while (done < limit) {
+        size_t want = buf_size < limit - done ? buf_size : limit - done;
+        ssize_t n = read(fd, buf, want);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            int err = errno;
+            close(fd);
+            errno = err;
+            return -1;
+        }
+        if (n == 0) {
+            break;
+        }
+        xxh64_update(&state, buf, (size_t)n);
+        done += (size_t)n;
+    }
+
+    close(fd);
+    *hash = xxh64_digest(&state);
+    return 0;
+}
+
+/**
+ * len 바이트를 채울 때까지 읽음 (EINTR 처리)
+ *
+ * @return 읽은 바이트 수 (파일 끝이면 len보다 작음), 실패시 -1
+ */
+static ssize_t read_fully(int fd, char *buf, size_t len) {
+    size_t done = 0;
+    while (done < len) {
+        ssize_t n = read(fd, buf + done, len - done);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        if (n == 0) {
+            break;
+        }
+        done += (size_t)n;
+    }
+    return (ssize_t)done;
+}
+
+/**
+ * 두 파일의 내용을 끝까지 비교 (buf를 반씩 나누어 사용)
+ *
+ * @param bad 실패했을 때 읽지 못한 파일의 경로를 받을 곳
+ * @return 같으면 1, 다르면 0, 실패시 -1 (errno 설정)
+ */
+static int compare_files(const char *a, const char *b, char *buf, size_t buf_size, const char **bad) {
+    int fd_a = open(a, O_RDONLY | O_NOCTTY | O_CLOEXEC);
+    if (fd_a < 0) {
+        *bad = a;
+        return -1;
+    }
+    int fd_b = open(b, O_RDONLY | O_NOCTTY | O_CLOEXEC);
+    if (fd_b < 0) {
+        int err = errno;
+        close(fd_a);
+        errno = err;
+        *bad = b;
+        return -1;
+    }
+    posix_fadvise(fd_a, 0, 0, POSIX_FADV_SEQUENTIAL);
+    posix_fadvise(fd_b, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    size_t half = buf_size / 2;
+    int result;
+    for (;;) {
+        ssize_t n_a = read_fully(fd_a, buf, half);
+        if (n_a < 0) {
+            *bad = a;
+            result = -1;
+            break;
+        }
+        ssize_t n_b = read_fully(fd_b, buf + half, half);
+        if (n_b < 0) {
+            *bad = b;
+            result = -1;
+            break;
+        }
+        if (n_a != n_b || memcmp(buf, buf + half, (size_t)n_a) != 0) {
+            result = 0;
+            break;
+        }
+        if ((size_t)n_a < half) {
+            result = 1;  // 둘 다 같은 위치에서 끝남
+            break;
+        }
+    }
+
+    int err = errno;
+    close(fd_a);
+    close(fd_b);
+    errno = err;
+    return result;
+}
+
+/**
+ * 작업 목록에서 파일을 하나씩 가져와 해시를 계산하거나 내용을 비교하는 스레드 함수
+ */
+static void *hash_worker(void *arg) {
+    hash_pass_t *pass = arg;
+    char head_buf[FIND_DUP_HEAD_SIZE];
+    char *buf = head_buf;
+    size_t buf_size = sizeof(head_buf);
+
+    if (pass->kind != PASS_HEAD) {
+        buf = malloc(FIND_DUP_BUF_SIZE);
+        if (!buf) {
+            fprintf(stderr, "find: 메모리 할당 실패\n");
+            exit(1);
+        }
+        buf_size = FIND_DUP_BUF_SIZE;
+    }
+
+    size_t i;
+    while ((i = atomic_fetch_add(&pass->next, 1)) < pass->job_count) {
+        dup_file_t *file = pass->jobs[i];
+        if (pass->kind == PASS_VERIFY) {
+            const char *bad = file->path;
+            int same = compare_files(pass->files[file->leader].path, file->path, buf, buf_size, &bad);
+            if (same < 0) {
+                fprintf(stderr, "find: %s: %s\n", bad, strerror(errno));
+                file->failed = 1;
+                atomic_fetch_add(&pass->errors, 1);
+            } else {
+                file->cls = same ? 0 : 1;
+            }
+            continue;
+        }
+
+        uint64_t hash;
+        if (hash_file(file->path, pass->kind == PASS_FULL, buf, buf_size, &hash) != 0) {
+            fprintf(stderr, "find: %s: %s\n", file->path, strerror(errno));
+            file->failed = 1;
+            atomic_fetch_add(&pass->errors, 1);
+            continue;
+        }
+        if (pass->kind == PASS_FULL) {
+            file->full_hash = hash;
+        } else {
+            file->head_hash = hash;
+        }
+    }
+
+    if (pass->kind != PASS_HEAD) {
+        free(buf);
+    }
+    return NULL;
+}
+
+/**
+ * 한 단계를 여러 스레드로 실행 (메인 스레드도 참여)
+ *
+ * @return 읽지 못한 파일 수
+ */
+static int run_pass(find_dup_t *dup, dup_file_t **jobs, size_t job_count, pass_kind_t kind) {
+    hash_pass_t pass;
+    pass.files = dup->files;
+    pass.jobs = jobs;
+    pass.job_count = job_count;
+    pass.kind = kind;
+    atomic_init(&pass.next, 0);
+    atomic_init(&pass.errors, 0);
+
+    int extra = dup->threads - 1;
+    if ((size_t)extra > job_count) {
+        extra = (int)job_count;  // 작업보다 많은 스레드는 만들지 않음
+    }
+    pthread_t *threads = malloc((extra > 0 ? extra : 1) * sizeof(pthread_t));
+    if (!threads) {
+        fprintf(stderr, "find: 메모리 할당 실패\n");
+        exit(1);
+    }
+    int started = 0;
+    for (int i = 0; i < extra; i++) {
+        if (pthread_create(&threads[i], NULL, hash_worker, &pass) != 0) {
+            break;  // 생성에 실패하면 있는 스레드만으로 진행
+        }
+        started++;
+    }
+    hash_worker(&pass);
+    for (int i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    free(threads);
+    return atomic_load(&pass.errors);
+}
+
+// === 묶기 ===
+
+/** 크기 내림차순, 같은 크기에서는 장치/inode 순 (하드 링크가 이웃하도록) */
+static int cmp_size_inode(const void *a, const void *b) {
+    const dup_file_t *x = a, *y = b;
+    if (x->size != y->size) return x->size > y->size ? -1 : 1;
+    if (x->dev != y->dev) return x->dev < y->dev ? -1 : 1;
+    if (x->ino != y->ino) return x->ino < y->ino ? -1 : 1;
+    return strcmp(x->path, y->path);
+}
+
+/** 크기 내림차순, 앞부분 해시, 대표 파일 순 */
+static int cmp_head(const void *a, const void *b) {
+    const dup_file_t *x = *(dup_file_t *const *)a, *y = *(dup_file_t *const *)b;
+    if (x->size != y->size) return x->size > y->size ? -1 : 1;
+    if (x->head_hash != y->head_hash) return x->head_hash < y->head_hash ? -1 : 1;
+    if (x->rep != y->rep) return x->rep < y->rep ? -1 : 1;
+    return 0;
+}
+
+/** 크기 내림차순, 전체 해시, 경로 순 (출력 순서) */
+static int cmp_full(const void *a, const void *b) {
+    const dup_file_t *x = *(dup_file_t *const *)a, *y = *(dup_file_t *const *)b;
+    if (x->size != y->size) return x->size > y->size ? -1 : 1;
+    if (x->full_hash != y->full_hash) return x->full_hash < y->full_hash ? -1 : 1;
+    return strcmp(x->path, y->path);
+}
+
+/**
+ * 하드 링크의 해시와 실패 여부를 대표 파일에서 복사
+ */
+static void copy_from_reps(find_dup_t *dup, dup_file_t **list, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        const dup_file_t *rep = &dup->files[list[i]->rep];
+        list[i]->head_hash = rep->head_hash;
+        list[i]->full_hash = rep->full_hash;
+        list[i]->failed = rep->failed;
+    }
+}
+
+/**
+ * 묶음 [start, end) 안의 서로 다른 inode 수가 2 이상인지 확인
+ */
+static int has_distinct_files(dup_file_t **list, size_t start, size_t end) {
+    for (size_t i = start + 1; i < end; i++) {
+        if (list[i]->rep != list[start]->rep) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * 하드 링크의 내용 묶음 번호와 실패 여부를 대표 파일에서 복사
+ */
+static void copy_cls_from_reps(find_dup_t *dup, dup_file_t **list, size_t start, size_t end) {
+    for (size_t i = start; i < end; i++) {
+        const dup_file_t *rep = &dup->files[list[i]->rep];
+        list[i]->cls = rep->cls;
+        list[i]->failed = rep->failed;
+    }
+}
+
+/**
+ * 첫 파일과 내용이 달랐던 파일들(cls 1)을 서로 비교하여 내용이 같은 것끼리 새 번호를 붙임
+ * (해시 충돌일 때만 일어나므로 한 스레드로 처리)
+ *
+ * @return 다음에 쓸 묶음 번호
+ */
+static int split_mismatches(find_dup_t *dup, dup_file_t **list, size_t start, size_t end, int *errors) {
+    int next_cls = 2;
+    char *buf = NULL;
+
+    for (size_t i = start; i < end; i++) {
+        dup_file_t *leader = list[i];
+        if (leader->failed || leader->cls != 1 || leader->rep != (size_t)(leader - dup->files)) {
+            continue;
+        }
+        if (!buf) {
+            buf = malloc(FIND_DUP_BUF_SIZE);
+            if (!buf) {
+                fprintf(stderr, "find: 메모리 할당 실패\n");
+                exit(1);
+            }
+        }
+        leader->cls = next_cls;
+        for (size_t j = i + 1; j < end; j++) {
+            dup_file_t *file = list[j];
+            if (file->failed || file->cls != 1 || file->rep != (size_t)(file - dup->files)) {
+                continue;
+            }
+            const char *bad = file->path;
+            int same = compare_files(leader->path, file->path, buf, FIND_DUP_BUF_SIZE, &bad);
+            if (same < 0) {
+                fprintf(stderr, "find: %s: %s\n", bad, strerror(errno));
+                file->failed = 1;
+                (*errors)++;
+            } else if (same) {
+                file->cls = next_cls;
+            }
+        }
+        next_cls++;
+    }
+
+    free(buf);
+    copy_cls_from_reps(dup, list, start, end);
+    return next_cls;
+}
+
+/**
+ * 묶음 [start, end) 중 내용 묶음 번호가 cls인 파일들을 출력
+ * (서로 다른 inode가 둘 이상일 때만)
+ */
+static void print_class(find_out_t *out, dup_file_t **list, size_t start, size_t end, int cls,
+                        int *first_group) {
+    size_t live = 0, rep = 0;
+    int distinct = 0;
+    for (size_t i = start; i < end; i++) {
+        if (list[i]->failed || list[i]->cls != cls) {
+            continue;
+        }
+        if (live++ == 0) {
+            rep = list[i]->rep;
+        } else if (list[i]->rep != rep) {
+            distinct = 1;
+        }
+    }
+    if (!distinct) {
+        return;  // 남은 파일이 하나의 inode뿐이면 중복이 아님
+    }
+
+    if (!*first_group) {
+        fout_write(out, "\n", 1);  // 묶음 사이 빈 줄
+    }
+    *first_group = 0;
+    for (size_t i = start; i < end; i++) {
+        if (!list[i]->failed && list[i]->cls == cls) {
+            fout_line(out, list[i]->path, strlen(list[i]->path));
+        }
+    }
+}
+
+int dup_report(find_dup_t *dup) {
+    int errors = 0;
+    size_t count = dup->count;
+    dup_file_t **list = malloc((count ? count : 1) * sizeof(dup_file_t *));
+    dup_file_t **jobs = malloc((count ? count : 1) * sizeof(dup_file_t *));
+    if (!list || !jobs) {
+        fprintf(stderr, "find: 메모리 할당 실패\n");
+        exit(1);
+    }
+
+    // === 1단계: 크기로 묶기 (파일을 읽지 않음) ===
+    qsort(dup->files, count, sizeof(dup_file_t), cmp_size_inode);
+    for (size_t i = 0; i < count; i++) {
+        dup_file_t *file = &dup->files[i];
+        int same_inode = i > 0 && file->size == file[-1].size &&
+                         file->dev == file[-1].dev && file->ino == file[-1].ino;
+        file->rep = same_inode ? file[-1].rep : i;
+    }
+
+    size_t n = 0, job_count = 0;
+    for (size_t start = 0, end; start < count; start = end) {
+        for (end = start + 1; end < count && dup->files[end].size == dup->files[start].size; end++) {
+        }
+        if (end - start < 2) {
+            continue;  // 같은 크기가 없으면 중복일 수 없음
+        }
+        size_t first = n;
+        for (size_t i = start; i < end; i++) {
+            list[n++] = &dup->files[i];
+        }
+        // 모두 같은 inode의 하드 링크라면 중복이 아님 (읽지 않음)
+        if (!has_distinct_files(list, first, n)) {
+            n = first;
+            continue;
+        }
+        for (size_t i = first; i < n; i++) {
+            if (list[i]->rep == (size_t)(list[i] - dup->files)) {
+                jobs[job_count++] = list[i];
+            }
+        }
+    }
+
+    // === 2단계: 앞 4KB 해시로 묶기 ===
+    errors += run_pass(dup, jobs, job_count, PASS_HEAD);
+    copy_from_reps(dup, list, n);
+    qsort(list, n, sizeof(dup_file_t *), cmp_head);
+
+    size_t m = 0;
+    job_count = 0;
+    for (size_t start = 0, end; start < n; start = end) {
+        for (end = start + 1; end < n && list[end]->size == list[start]->size &&
+             list[end]->head_hash == list[start]->head_hash; end++) {
+        }
+        // 실패한 파일은 제외하고 남은 묶음만 다음 단계로
+        size_t first = m;
+        for (size_t i = start; i < end; i++) {
+            if (!list[i]->failed) {
+                list[m++] = list[i];
+            }
+        }
+        if (m - first < 2 || !has_distinct_files(list, first, m)) {
+            m = first;
+            continue;
+        }
+        if (list[first]->size <= FIND_DUP_HEAD_SIZE) {
+            // 앞부분이 곧 전체: 더 읽을 필요 없음
+            for (size_t i = first; i < m; i++) {
+                list[i]->full_hash = list[i]->head_hash;
+            }
+            continue;
+        }
+        for (size_t i = first; i < m; i++) {
+            if (list[i]->rep == (size_t)(list[i] - dup->files)) {
+                jobs[job_count++] = list[i];
+            }
+        }
+    }
+
+    // === 3단계: 남은 후보만 전체 해시 ===
+    errors += run_pass(dup, jobs, job_count, PASS_FULL);
+    for (size_t i = 0; i < m; i++) {
+        const dup_file_t *rep = &dup->files[list[i]->rep];
+        if (rep != list[i]) {
+            list[i]->full_hash = rep->full_hash;
+            list[i]->failed = rep->failed;
+        }
+    }
+    qsort(list, m, sizeof(dup_file_t *), cmp_full);
+
+    // === 4단계: 크기와 전체 해시가 같은 묶음을 첫 대표 파일과 내용 비교 ===
+    job_count = 0;
+    for (size_t start = 0, end; start < m; start = end) {
+        size_t leader = (size_t)-1;
+        for (end = start; end < m && list[end]->size == list[start]->size &&
+             list[end]->full_hash == list[start]->full_hash; end++) {
+            dup_file_t *file = list[end];
+            file->cls = 0;
+            if (file->failed || file->rep != (size_t)(file - dup->files)) {
+                continue;
+            }
+            if (leader == (size_t)-1) {
+                leader = file->rep;
+            } else {
+                file->leader = leader;
+                jobs[job_count++] = file;
+            }
+        }
+    }
+    errors += run_pass(dup, jobs, job_count, PASS_VERIFY);
+
+    // === 출력: 내용까지 같은 묶음 ===
+    find_out_t out;
+    fout_init(&out, STDOUT_FILENO);
+    int first_group = 1;
+    for (size_t start = 0, end; start < m; start = end) {
+        for (end = start + 1; end < m && list[end]->size == list[start]->size &&
+             list[end]->full_hash == list[start]->full_hash; end++) {
+        }
+        copy_cls_from_reps(dup, list, start, end);
+        int classes = 1;
+        for (size_t i = start; i < end; i++) {
+            if (!list[i]->failed && list[i]->cls == 1) {
+                classes = split_mismatches(dup, list, start, end, &errors);  // 해시 충돌
+                break;
+            }
+        }
+        for (int cls = 0; cls < classes; cls++) {
+            if (cls != 1) {
+                print_class(&out, list, start, end, cls, &first_group);
+            }
+        }
+    }
+    fout_free(&out);
+
+    for (size_t i = 0; i < count; i++) {
+        free(dup->files[i].path);
+    }
+    free(dup->files);
+    free(list);
+    free(jobs);
+    pthread_mutex_destroy(&dup->lock);
+    return errors > 0 ? 1 : 0;
+}
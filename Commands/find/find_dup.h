@@ -0,0 +1,94 @@
+/*
+ * find_dup.h - find 중복 파일 찾기(-D) 선언
+ *
+ * 검색 조건에 맞는 일반 파일 중 내용이 같은 파일들을 묶어서 출력합니다.
+ * 파일을 최대한 적게 읽도록 단계별로 후보를 줄입니다:
+ * 1. 크기: 크기가 같은 파일이 없으면 중복일 수 없음 (읽지 않음)
+ * 2. 앞부분 해시: 앞 4KB만 읽어 해시가 같은 파일끼리만 남김
+ * 3. 전체 해시: 남은 후보만 끝까지 읽어 해시 비교
+ * 4. 내용 비교: 해시가 같은 묶음은 첫 파일과 바이트 단위로 비교하여,
+ *    해시 충돌로 섞인 파일은 내용이 같은 것끼리 따로 묶음
+ * 해시 계산과 비교는 여러 스레드가 나누어 하며, 해시는 XXH64 알고리즘을 사용합니다.
+ *
+ * 하드 링크(같은 장치, 같은 inode)는 한 번만 읽고 같은 파일로 취급합니다.
+ * 서로 다른 inode가 둘 이상 있는 묶음만 출력하며 (그 안의 하드 링크는 모두 출력),
+ * 빈 파일은 대상에서 제외합니다.
+ *
+ * 출력: 중복 묶음마다 경로를 한 줄씩 (묶음 안은 경로순), 묶음 사이는 빈 줄.
+ *       묶음은 파일 크기가 큰 것부터 출력합니다.
+ */
+
+#ifndef FIND_DUP_H
+#define FIND_DUP_H
+
+#include "find_options.h"
+#include "find_output.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+/** 2단계에서 읽는 앞부분 크기 */
+#define FIND_DUP_HEAD_SIZE 4096
+
+/** 3단계에서 파일을 읽는 버퍼 크기 */
+#define FIND_DUP_BUF_SIZE (1024 * 1024)
+
+/**
+ * 후보 파일 하나
+ */
+typedef struct {
+    char *path;             /**< 경로 (힙 할당) */
+    off_t size;             /**< 파일 크기 */
+    dev_t dev;              /**< 장치 번호 (하드 링크 판별) */
+    ino_t ino;              /**< inode 번호 (하드 링크 판별) */
+    size_t rep;             /**< 대표 파일 번호 (하드 링크면 같은 inode의 첫 파일, 아니면 자기 자신) */
+    uint64_t head_hash;     /**< 앞 4KB의 해시 */
+    uint64_t full_hash;     /**< 전체 내용의 해시 */
+    size_t leader;          /**< 4단계에서 내용을 비교할 묶음의 첫 대표 파일 번호 */
+    int cls;                /**< 내용 묶음 번호 (0: 첫 파일과 같음, 1: 다름, 2 이상: 다시 나눈 묶음) */
+    int failed;             /**< 읽기 실패로 제외되었으면 1 */
+} dup_file_t;
+
+/**
+ * 중복 찾기 상태
+ */
+typedef struct {
+    pthread_mutex_t lock;   /**< 병렬 탐색 중 files 보호 */
+    dup_file_t *files;      /**< 수집된 파일들 */
+    size_t count;           /**< 파일 수 */
+    size_t cap;             /**< 배열 용량 */
+    int threads;            /**< 해시 계산 스레드 수 */
+} find_dup_t;
+
+/**
+ * 중복 찾기 상태 초기화
+ *
+ * @param dup 초기화할 상태
+ * @param opts 검색 옵션 (jobs: 해시 계산 스레드 수, 없으면 CPU 수)
+ */
+void dup_init(find_dup_t *dup, const find_options_t *opts);
+
+/**
+ * 검색 결과 하나를 후보로 수집 (출력 형식 함수로 사용, 아무것도 출력하지 않음)
+ *
+ * find_out_format_t 형식이므로 fout_set_format()에 그대로 넘길 수 있습니다.
+ * st가 필요하므로 실행 계획이 항상 stat하도록 해야 합니다.
+ *
+ * @param ctx 중복 찾기 상태 (find_dup_t *)
+ * @param out 출력 버퍼 (사용하지 않음)
+ * @param path 경로
+ * @param len 경로 길이
+ * @param st 파일 정보
+ */
+void dup_collect(void *ctx, find_out_t *out, const char *path, size_t len, const struct stat *st);
+
+/**
+ * 수집된 후보에서 중복 묶음을 찾아 표준 출력에 출력하고 자원 해제
+ *
+ * @param dup 중복 찾기 상태
+ * @return 성공시 0, 읽지 못한 파일이 있으면 1
+ */
+int dup_report(find_dup_t *dup);
+
+#endif /* FIND_DUP_H */
@@ -0,0 +1,319 @@
+/*
+ * find_exec.c - find 명령 실행(-exec) 모듈
+ *
+ * 출력 버퍼에서 넘어온 경로로 명령의 인자 목록을 만들어 posix_spawnp()로 실행하고,
+ * 동시에 실행 중인 명령 수를 -P 이하로 유지하면서 종료 코드를 모읍니다.
+ */
+
+#include "find_exec.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <spawn.h>
+#include <signal.h>
+#include <sys/wait.h>
+
+extern char **environ;
+
+/**
+ * 한 번에 넘길 수 있는 인자 총 크기 계산 (ARG_MAX - 환경 변수 - 여유분)
+ */
+static size_t compute_arg_limit(void) {
+    long arg_max = sysconf(_SC_ARG_MAX);
+    if (arg_max <= 0) {
+        arg_max = 128 * 1024;  // 알 수 없으면 리눅스 예전 기본값 사용
+    }
+
+    size_t env_size = 0;
+    for (char **env = environ; *env; env++) {
+        env_size += strlen(*env) + 1 + sizeof(char *);
+    }
+
+    size_t limit = (size_t)arg_max;
+    if (limit < env_size + FIND_EXEC_ARG_HEADROOM * 2) {
+        return FIND_EXEC_ARG_HEADROOM;  // 환경이 너무 크면 최소한만 사용
+    }
+    return limit - env_size - FIND_EXEC_ARG_HEADROOM;
+}
+
+/**
+ * 자식 하나가 끝날 때까지 기다림 (EINTR이면 다시 시도)
+ *
+ * @return 끝난 자식의 pid, 기다릴 자식이 없으면 -1
+ */
+static pid_t wait_child(int *status) {
+    pid_t pid;
+    do {
+        pid = waitpid(-1, status, 0);
+    } while (pid < 0 && errno == EINTR);
+    return pid;
+}
+
+/**
+ * 끝난 명령의 종료 코드를 기록 (lock을 잡은 상태에서 호출)
+ */
+static void record_exit(find_exec_t *exec, pid_t pid, int status) {
+    if (pid < 0) {
+        exec->running = 0;  // 더 기다릴 자식이 없음
+        return;
+    }
+    exec->running--;
+
+    if (WIFSIGNALED(status)) {
+        // 출력 파이프가 닫혀서(| head 등) 끝난 경우는 알리지 않음
+        if (WTERMSIG(status) != SIGPIPE) {
+            fprintf(stderr, "find: %s: 시그널 %d로 종료됨\n", exec->argv[0], WTERMSIG(status));
+        }
+        exec->failed++;
+    } else if (WIFEXITED(status) && WEXITSTATUS(status) != 0) {
+        exec->failed++;
+    }
+}
+
+/**
+ * 회수 스레드: 실행 중인 명령이 있으면 lock을 놓은 채 waitpid()로 기다렸다가
+ * 종료 코드를 기록하고 자리를 기다리는 스레드를 깨움
+ */
+static void *reaper_main(void *arg) {
+    find_exec_t *exec = arg;
+
+    pthread_mutex_lock(&exec->lock);
+    for (;;) {
+        while (exec->running == 0 && !exec->done) {
+            pthread_cond_wait(&exec->spawned, &exec->lock);
+        }
+        if (exec->running == 0) {
+            break;  // exec_finish() 이후 모든 명령이 끝남
+        }
+        pthread_mutex_unlock(&exec->lock);
+
+        int status;
+        pid_t pid = wait_child(&status);
+
+        pthread_mutex_lock(&exec->lock);
+        record_exit(exec, pid, status);
+        pthread_cond_broadcast(&exec->reaped);
+    }
+    pthread_mutex_unlock(&exec->lock);
+    return NULL;
+}
+
+void exec_init(find_exec_t *exec, const find_options_t *opts) {
+    memset(exec, 0, sizeof(*exec));
+    exec->argv = opts->exec_argv;
+    exec->argc = opts->exec_argc;
+    exec->batch = opts->exec_batch;
+    exec->max_procs = opts->max_procs > 0 ? opts->max_procs : 1;
+    exec->arg_limit = compute_arg_limit();
+    pthread_mutex_init(&exec->lock, NULL);
+    pthread_cond_init(&exec->spawned, NULL);
+    pthread_cond_init(&exec->reaped, NULL);
+
+    // '+' 형태의 마지막 {}는 경로들로 바뀌므로 템플릿에서 제외
+    if (exec->batch) {
+        exec->argc--;
+    }
+    for (int i = 0; i < exec->argc; i++) {
+        exec->base_size += strlen(exec->argv[i]) + 1 + sizeof(char *);
+    }
+
+    // 회수 스레드 시작 (만들 수 없으면 자리가 필요할 때 직접 기다림)
+    exec->reaper_started = pthread_create(&exec->reaper, NULL, reaper_main, exec) == 0;
+}
+
+/**
+ * 회수 스레드를 만들 수 없을 때 직접 하나를 기다림 (lock을 잡은 상태에서 호출)
+ */
+static void reap_one(find_exec_t *exec) {
+    int status;
+    pid_t pid = wait_child(&status);
+    record_exit(exec, pid, status);
+}
+
+/**
+ * 명령 하나 실행 (lock을 잡은 상태에서 호출)
+ * 실행 중인 명령이 max_procs개면 회수 스레드가 자리를 낼 때까지 기다림
+ * (기다리는 동안 lock을 놓으므로 다른 탐색 스레드는 계속 경로를 넘길 수 있음)
+ */
+static void spawn(find_exec_t *exec, char **argv) {
+    while (exec->running >= exec->max_procs) {
+        if (exec->reaper_started) {
+            pthread_cond_wait(&exec->reaped, &exec->lock);
+        } else {
+            reap_one(exec);
+        }
+    }
+
+    pid_t pid;
+    int err = posix_spawnp(&pid, argv[0], NULL, NULL, argv, environ);
+    if (err != 0) {
+        fprintf(stderr, "find: %s: %s\n", argv[0], strerror(err));
+        exec->failed++;
+        return;
+    }
+    exec->running++;
+    pthread_cond_signal(&exec->spawned);
+}
+
+/**
+ * 모아 둔 경로들을 인자로 붙여 명령 실행 ('+' 형태, lock을 잡은 상태에서 호출)
+ * spawn()이 자리를 기다리며 lock을 놓는 동안 다른 스레드가 새 묶음을 쌓을 수 있도록
+ * 모아 둔 버퍼는 떼어 내서 사용
+ */
+static void run_batch(find_exec_t *exec) {
+    if (exec->path_count == 0) {
+        return;
+    }
+
+    char *paths = exec->paths;
+    size_t paths_len = exec->paths_len;
+    size_t path_count = exec->path_count;
+    exec->paths = NULL;
+    exec->paths_len = exec->paths_cap = 0;
+    exec->path_count = 0;
+
+    char **argv = malloc((exec->argc + path_count + 1) * sizeof(char *));
+    if (!argv) {
+        fprintf(stderr, "find: 메모리 할당 실패\n");
+        exit(1);
+    }
+    int n = 0;
+    for (int i = 0; i < exec->argc; i++) {
+        argv[n++] = exec->argv[i];
+    }
+    for (size_t pos = 0; pos < paths_len; pos += strlen(paths + pos) + 1) {
+        argv[n++] = paths + pos;
+    }
+    argv[n] = NULL;
+
+    spawn(exec, argv);  // posix_spawnp는 인자를 복사하므로 바로 해제해도 됨
+    free(argv);
+    free(paths);
+}
+
+/**
+ * 경로 하나를 묶음에 추가 ('+' 형태), 크기 제한을 넘으면 먼저 실행
+ */
+static void add_to_batch(find_exec_t *exec, const char *path, size_t len) {
+    size_t cost = len + 1 + sizeof(char *);
+    if (exec->path_count > 0 &&
+        exec->base_size + (exec->paths_len + exec->path_count * sizeof(char *)) + cost > exec->arg_limit) {
+        run_batch(exec);
+    }
+
+    if (exec->paths_len + len + 1 > exec->paths_cap) {
+        size_t new_cap = exec->paths_cap ? exec->paths_cap * 2 : 64 * 1024;
+        while (exec->paths_len + len + 1 > new_cap) {
+            new_cap *= 2;
+        }
+        char *grown = realloc(exec->paths, new_cap);
+        if (!grown) {
+            fprintf(stderr, "find: 메모리 할당 실패\n");
+            exit(1);
+        }
+        exec->paths = grown;
+        exec->paths_cap = new_cap;
+    }
+    memcpy(exec->paths + exec->paths_len, path, len);
+    exec->paths[exec->paths_len + len] = '\0';
+    exec->paths_len += len + 1;
+    exec->path_count++;
+}
+
+/**
+ * 경로 하나로 명령 실행 (';' 형태): 모든 인자의 "{}"를 경로로 바꿈
+ * 인자 목록은 lock 없이 만들고 실행할 때만 lock을 잡음
+ */
+static void run_single(find_exec_t *exec, const char *path, size_t len) {
+    // 치환 후 크기 계산
+    size_t total = 0;
+    for (int i = 0; i < exec->argc; i++) {
+        size_t count = 0;
+        for (const char *p = exec->argv[i]; (p = strstr(p, "{}")) != NULL; p += 2) {
+            count++;
+        }
+        total += strlen(exec->argv[i]) + count * len + 1;
+    }
+
+    char **argv = malloc((exec->argc + 1) * sizeof(char *));
+    char *strings = malloc(total);
+    if (!argv || !strings) {
+        fprintf(stderr, "find: 메모리 할당 실패\n");
+        exit(1);
+    }
+
+    char *dst = strings;
+    for (int i = 0; i < exec->argc; i++) {
+        argv[i] = dst;
+        const char *src = exec->argv[i];
+        const char *mark;
+        while ((mark = strstr(src, "{}")) != NULL) {
+            memcpy(dst, src, mark - src);
+            dst += mark - src;
+            memcpy(dst, path, len);
+            dst += len;
+            src = mark + 2;
+        }
+        size_t rest = strlen(src) + 1;
+        memcpy(dst, src, rest);
+        dst += rest;
+    }
+    argv[exec->argc] = NULL;
+
+    pthread_mutex_lock(&exec->lock);
+    spawn(exec, argv);
+    pthread_mutex_unlock(&exec->lock);
+    free(strings);
+    free(argv);
+}
+
+void exec_feed(void *ctx, const char *data, size_t len) {
+    find_exec_t *exec = ctx;
+
+    if (!data) {
+        pthread_mutex_lock(&exec->lock);
+        run_batch(exec);  // 감시 모드: 이벤트 묶음마다 바로 실행
+        pthread_mutex_unlock(&exec->lock);
+        return;
+    }
+
+    const char *end = data + len;
+    while (data < end) {
+        const char *term = memchr(data, '\0', end - data);
+        size_t path_len = term ? (size_t)(term - data) : (size_t)(end - data);
+        if (exec->batch) {
+            pthread_mutex_lock(&exec->lock);
+            add_to_batch(exec, data, path_len);
+            pthread_mutex_unlock(&exec->lock);
+        } else {
+            run_single(exec, data, path_len);
+        }
+        data += path_len + 1;
+    }
+}
+
+int exec_finish(find_exec_t *exec) {
+    pthread_mutex_lock(&exec->lock);
+    run_batch(exec);
+    exec->done = 1;
+    pthread_cond_signal(&exec->spawned);
+    if (exec->reaper_started) {
+        // 회수 스레드는 남은 명령이 모두 끝나면 종료함
+        pthread_mutex_unlock(&exec->lock);
+        pthread_join(exec->reaper, NULL);
+        pthread_mutex_lock(&exec->lock);
+    }
+    while (exec->running > 0) {
+        reap_one(exec);
+    }
+    int failed = exec->failed;
+    pthread_mutex_unlock(&exec->lock);
+
+    free(exec->paths);
+    pthread_cond_destroy(&exec->spawned);
+    pthread_cond_destroy(&exec->reaped);
+    pthread_mutex_destroy(&exec->lock);
+    return failed ? 1 : 0;
+}
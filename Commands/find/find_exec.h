@@ -0,0 +1,82 @@
+/*
+ * find_exec.h - find 명령 실행(-exec) 모듈 선언
+ *
+ * 검색 결과를 출력하는 대신 명령을 실행합니다.
+ * - "-exec cmd {} ;" : 결과마다 명령 하나 실행 ({}는 경로로 바뀜)
+ * - "-exec cmd {} +" : 여러 결과를 인자 목록으로 묶어 실행 (xargs처럼 동작)
+ *   한 번에 넘기는 인자의 총 크기는 ARG_MAX에서 환경 변수 크기를 뺀 값 이하로 맞춥니다.
+ *
+ * 결과는 출력 버퍼의 sink로 받으므로 (구분자 '\0') 개행이 들어간 이름도 안전하고,
+ * 병렬 탐색, 색인 검색, 감시 모드에서도 그대로 동작합니다.
+ *
+ * 명령은 posix_spawnp()로 실행하며(glibc에서는 vfork와 같은 방식이라 메모리 복사가 없음),
+ * 동시에 실행되는 명령은 -P로 지정한 개수를 넘지 않습니다.
+ * 끝난 명령은 별도의 회수 스레드가 잠금 밖에서 waitpid()로 기다리므로,
+ * 탐색 스레드는 자리가 날 때까지만 기다리고 자식 종료를 직접 기다리지 않습니다.
+ */
+
+#ifndef FIND_EXEC_H
+#define FIND_EXEC_H
+
+#include "find_options.h"
+#include <pthread.h>
+#include <stddef.h>
+
+/** ARG_MAX에서 추가로 남겨 둘 여유 바이트 */
+#define FIND_EXEC_ARG_HEADROOM 2048
+
+/**
+ * 명령 실행 상태
+ */
+typedef struct {
+    char **argv;            /**< 명령 템플릿 (옵션 구조체의 exec_argv) */
+    int argc;               /**< 템플릿 인자 수 ('+' 형태면 마지막 {} 제외) */
+    int batch;              /**< '+' 형태면 1 */
+    int max_procs;          /**< 동시에 실행할 최대 명령 수 */
+    size_t arg_limit;       /**< 한 번에 넘길 수 있는 인자 총 바이트 수 */
+    size_t base_size;       /**< 템플릿 인자가 차지하는 바이트 수 */
+
+    pthread_mutex_t lock;   /**< 여러 탐색 스레드의 호출을 직렬화 */
+    pthread_cond_t spawned; /**< 명령을 실행했거나 끝낼 때 회수 스레드를 깨움 */
+    pthread_cond_t reaped;  /**< 명령 하나가 끝나 자리가 났을 때 알림 */
+    pthread_t reaper;       /**< 끝난 명령을 회수하는 스레드 */
+    int reaper_started;     /**< 회수 스레드가 실행 중이면 1 (생성 실패시 직접 회수) */
+    int done;               /**< exec_finish()가 호출되면 1 */
+    char *paths;            /**< 모아 둔 경로들 ('\0'으로 구분) */
+    size_t paths_len;       /**< paths에 쌓인 바이트 수 */
+    size_t paths_cap;       /**< paths 용량 */
+    size_t path_count;      /**< 모아 둔 경로 수 */
+
+    int running;            /**< 실행 중인 명령 수 */
+    int failed;             /**< 실패한(0이 아닌 종료 코드, 시그널, 실행 실패) 명령 수 */
+} find_exec_t;
+
+/**
+ * 실행 상태 초기화
+ *
+ * @param exec 초기화할 실행 상태
+ * @param opts 검색 옵션 (exec_argv, exec_argc, exec_batch, max_procs 사용)
+ */
+void exec_init(find_exec_t *exec, const find_options_t *opts);
+
+/**
+ * 출력 버퍼 sink: '\0'으로 구분된 경로들을 받아 명령을 실행
+ *
+ * find_out_sink_t 형식이므로 fout_set_sink()에 그대로 넘길 수 있습니다.
+ * data가 NULL이면 모아 둔 묶음을 바로 실행합니다.
+ *
+ * @param ctx 실행 상태 (find_exec_t *)
+ * @param data 경로 레코드들
+ * @param len 데이터 길이
+ */
+void exec_feed(void *ctx, const char *data, size_t len);
+
+/**
+ * 남은 묶음을 실행하고 모든 명령이 끝날 때까지 기다린 뒤 자원 해제
+ *
+ * @param exec 실행 상태
+ * @return 모든 명령이 성공했으면 0, 하나라도 실패했으면 1
+ */
+int exec_finish(find_exec_t *exec);
+
+#endif /* FIND_EXEC_H */
@@ -0,0 +1,240 @@
+/*
+ * find_format.c - find 출력 형식(-printf) 모듈
+ *
+ * 숫자는 직접 10진/8진 문자열로 바꾸고, 소유자 이름과 시각 문자열은
+ * 스레드마다 마지막 값을 기억해 두어 같은 값이 이어질 때 다시 계산하지 않습니다.
+ */
+
+#include "find_format.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pwd.h>
+
+/**
+ * 항목 배열에 항목 하나 추가하는 내부 함수
+ */
+static void add_item(find_format_t *fmt, format_kind_t kind, size_t offset, size_t len) {
+    format_item_t *grown = realloc(fmt->items, (fmt->count + 1) * sizeof(format_item_t));
+    if (!grown) {
+        fprintf(stderr, "find: 메모리 할당 실패\n");
+        exit(1);
+    }
+    fmt->items = grown;
+    fmt->items[fmt->count].kind = kind;
+    fmt->items[fmt->count].offset = offset;
+    fmt->items[fmt->count].len = len;
+    fmt->count++;
+}
+
+int format_compile(find_format_t *fmt, const char *spec) {
+    memset(fmt, 0, sizeof(*fmt));
+
+    // 이스케이프를 해석한 고정 문자열은 원래 형식보다 길어지지 않음
+    fmt->text = malloc(strlen(spec) + 1);
+    if (!fmt->text) {
+        fprintf(stderr, "find: 메모리 할당 실패\n");
+        exit(1);
+    }
+
+    size_t text_len = 0;      // text에 쌓인 길이
+    size_t run_start = 0;     // 아직 항목으로 만들지 않은 고정 문자열의 시작
+
+    for (const char *p = spec; *p; p++) {
+        if (*p == '\\' && p[1]) {
+            // 이스케이프 문자
+            char c;
+            switch (p[1]) {
+                case 'n':  c = '\n'; break;
+                case 't':  c = '\t'; break;
+                case '0':  c = '\0'; break;
+                case '\\': c = '\\'; break;
+                default:
+                    fmt->text[text_len++] = '\\';  // 알 수 없는 이스케이프는 그대로 출력
+                    continue;
+            }
+            fmt->text[text_len++] = c;
+            p++;
+            continue;
+        }
+        if (*p != '%') {
+            fmt->text[text_len++] = *p;
+            continue;
+        }
+
+        // 지시자
+        format_kind_t kind;
+        switch (p[1]) {
+            case '%':
+                fmt->text[text_len++] = '%';
+                p++;
+                continue;
+            case 'p': kind = FMT_PATH;  break;
+            case 'f': kind = FMT_NAME;  break;
+            case 's': kind = FMT_SIZE;  break;
+            case 'm': kind = FMT_MODE;  break;
+            case 'u': kind = FMT_USER;  break;
+            case 'T': kind = FMT_MTIME; break;
+            case 'y': kind = FMT_TYPE;  break;
+            case '\0':
+                fprintf(stderr, "오류: -printf 형식이 '%%'로 끝났습니다.\n");
+                format_free(fmt);
+                return -1;
+            default:
+                fprintf(stderr, "오류: -printf 형식에 알 수 없는 지시자 %%%c가 있습니다.\n", p[1]);
+                format_free(fmt);
+                return -1;
+        }
+
+        if (text_len > run_start) {
+            add_item(fmt, FMT_TEXT, run_start, text_len - run_start);
+        }
+        add_item(fmt, kind, 0, 0);
+        run_start = text_len;
+        if (kind != FMT_PATH && kind != FMT_NAME) {
+            fmt->needs_stat = true;
+        }
+        p++;
+    }
+    if (text_len > run_start) {
+        add_item(fmt, FMT_TEXT, run_start, text_len - run_start);
+    }
+    return 0;
+}
+
+/**
+ * 부호 없는 정수를 base진수 문자열로 바꿔 버퍼에 쓰는 내부 함수
+ */
+static void write_number(find_out_t *out, unsigned long long value, unsigned base) {
+    char digits[24];
+    size_t pos = sizeof(digits);
+    do {
+        digits[--pos] = (char)('0' + value % base);
+        value /= base;
+    } while (value > 0);
+    fout_append(out, digits + pos, sizeof(digits) - pos);
+}
+
+/**
+ * 소유자 이름 출력 (이름이 없으면 UID)
+ * 스레드마다 마지막으로 찾은 UID를 기억하므로 같은 소유자가 이어지면 다시 찾지 않음
+ */
+static void write_user(find_out_t *out, uid_t uid) {
+    static __thread uid_t cached_uid;
+    static __thread char cached_name[64];
+    static __thread int cached_valid = 0;   // 0: 없음, 1: 이름, 2: 이름 없음(UID 출력)
+
+    if (!cached_valid || cached_uid != uid) {
+        struct passwd pwd, *result = NULL;
+        char buf[1024];
+        cached_uid = uid;
+        cached_valid = 2;
+        if (getpwuid_r(uid, &pwd, buf, sizeof(buf), &result) == 0 && result &&
+            strlen(result->pw_name) < sizeof(cached_name)) {
+            strcpy(cached_name, result->pw_name);
+            cached_valid = 1;
+        }
+    }
+
+    if (cached_valid == 1) {
+        fout_append(out, cached_name, strlen(cached_name));
+    } else {
+        write_number(out, uid, 10);
+    }
+}
+
+/**
+ * 수정 시각 출력 (YYYY-MM-DD HH:MM:SS)
+ * 스레드마다 마지막 시각의 문자열을 기억하여 localtime_r 호출을 줄임
+ */
+static void write_mtime(find_out_t *out, time_t mtime) {
+    static __thread time_t cached_time;
+    static __thread char cached_text[32];
+    static __thread size_t cached_len = 0;
+
+    if (cached_len == 0 || cached_time != mtime) {
+        struct tm tm;
+        cached_time = mtime;
+        cached_len = 0;
+        if (localtime_r(&mtime, &tm)) {
+            cached_len = strftime(cached_text, sizeof(cached_text), "%Y-%m-%d %H:%M:%S", &tm);
+        }
+        if (cached_len == 0) {
+            fout_append(out, "?", 1);
+            return;
+        }
+    }
+    fout_append(out, cached_text, cached_len);
+}
+
+/**
+ * 파일 타입 문자 (find -printf %y와 같은 문자)
+ */
+static char type_char(mode_t mode) {
+    if (S_ISREG(mode))  return 'f';
+    if (S_ISDIR(mode))  return 'd';
+    if (S_ISLNK(mode))  return 'l';
+    if (S_ISFIFO(mode)) return 'p';
+    if (S_ISSOCK(mode)) return 's';
+    if (S_ISCHR(mode))  return 'c';
+    if (S_ISBLK(mode))  return 'b';
+    return 'U';
+}
+
+void format_entry(void *ctx, find_out_t *out, const char *path, size_t len, const struct stat *st) {
+    const find_format_t *fmt = ctx;
+
+    for (size_t i = 0; i < fmt->count; i++) {
+        const format_item_t *item = &fmt->items[i];
+        switch (item->kind) {
+            case FMT_TEXT:
+                fout_append(out, fmt->text + item->offset, item->len);
+                break;
+            case FMT_PATH:
+                fout_append(out, path, len);
+                break;
+            case FMT_NAME: {
+                // 끝의 '/'를 뺀 마지막 이름 ("/"는 그대로)
+                size_t end = len;
+                while (end > 1 && path[end - 1] == '/') {
+                    end--;
+                }
+                size_t start = end;
+                while (start > 0 && path[start - 1] != '/') {
+                    start--;
+                }
+                if (start == end) {
+                    start = 0;  // 경로 전체가 '/'
+                }
+                fout_append(out, path + start, end - start);
+                break;
+            }
+            case FMT_SIZE:
+                write_number(out, (unsigned long long)st->st_size, 10);
+                break;
+            case FMT_MODE:
+                write_number(out, st->st_mode & 07777, 8);
+                break;
+            case FMT_USER:
+                write_user(out, st->st_uid);
+                break;
+            case FMT_MTIME:
+                write_mtime(out, st->st_mtime);
+                break;
+            case FMT_TYPE: {
+                char c = type_char(st->st_mode);
+                fout_append(out, &c, 1);
+                break;
+            }
+        }
+    }
+}
+
+void format_free(find_format_t *fmt) {
+    free(fmt->items);
+    free(fmt->text);
+    fmt->items = NULL;
+    fmt->text = NULL;
+    fmt->count = 0;
+}
@@ -0,0 +1,89 @@
+/*
+ * find_format.h - find 출력 형식(-printf) 선언
+ *
+ * 형식 문자열을 검색 시작 전에 한 번 해석해 항목 배열로 만들어 두고,
+ * 결과마다 printf 계열 함수 없이 출력 버퍼에 직접 씁니다.
+ *
+ * 지시자:
+ * - %p: 경로          - %f: 경로의 마지막 이름
+ * - %s: 크기(바이트)  - %m: 권한 (8진수, 예: 644)
+ * - %u: 소유자 이름 (없으면 UID)
+ * - %T: 수정 시각 (YYYY-MM-DD HH:MM:SS, 지역 시간)
+ * - %y: 타입 (f d l p s c b)
+ * - %%: '%' 문자
+ * 이스케이프: \n \t \0 \\
+ * GNU find와 같이 개행은 자동으로 붙지 않으므로 형식에 \n을 넣어야 합니다.
+ */
+
+#ifndef FIND_FORMAT_H
+#define FIND_FORMAT_H
+
+#include "find_output.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <sys/stat.h>
+
+/**
+ * 형식 항목 종류
+ */
+typedef enum {
+    FMT_TEXT,       /**< 고정 문자열 */
+    FMT_PATH,       /**< %p */
+    FMT_NAME,       /**< %f */
+    FMT_SIZE,       /**< %s */
+    FMT_MODE,       /**< %m */
+    FMT_USER,       /**< %u */
+    FMT_MTIME,      /**< %T */
+    FMT_TYPE        /**< %y */
+} format_kind_t;
+
+/**
+ * 형식 항목 하나
+ */
+typedef struct {
+    format_kind_t kind;     /**< 항목 종류 */
+    size_t offset;          /**< FMT_TEXT: text 안의 시작 위치 */
+    size_t len;             /**< FMT_TEXT: 길이 ('\0'이 포함될 수 있음) */
+} format_item_t;
+
+/**
+ * 해석된 출력 형식
+ */
+typedef struct {
+    format_item_t *items;   /**< 항목 배열 */
+    size_t count;           /**< 항목 수 */
+    char *text;             /**< 고정 문자열들 (이스케이프 해석 후) */
+    bool needs_stat;        /**< 파일 정보가 필요한 지시자가 있는지 */
+} find_format_t;
+
+/**
+ * 형식 문자열 해석
+ *
+ * @param fmt 결과를 저장할 구조체
+ * @param spec -printf 형식 문자열
+ * @return 성공시 0, 알 수 없는 지시자가 있으면 -1 (오류 메시지 출력)
+ */
+int format_compile(find_format_t *fmt, const char *spec);
+
+/**
+ * 항목 하나를 형식에 맞춰 버퍼에 씀
+ *
+ * find_out_format_t 형식이므로 fout_set_format()에 그대로 넘길 수 있습니다.
+ * 여러 스레드에서 동시에 호출해도 안전합니다.
+ *
+ * @param ctx 해석된 형식 (find_format_t *)
+ * @param out 출력 버퍼
+ * @param path 경로
+ * @param len 경로 길이
+ * @param st 파일 정보 (needs_stat이 false면 NULL 가능)
+ */
+void format_entry(void *ctx, find_out_t *out, const char *path, size_t len, const struct stat *st);
+
+/**
+ * 해석된 형식의 메모리 해제
+ *
+ * @param fmt 해제할 형식
+ */
+void format_free(find_format_t *fmt);
+
+#endif /* FIND_FORMAT_H */
@@ -0,0 +1,368 @@
+/*
+ * find_glob.c - find 이름 패턴(glob) 컴파일러
+ *
+ * 패턴을 한 번 해석해 전용 비교 방식이나 토큰 배열로 바꾸고,
+ * 파일마다 그 결과로 이름을 검사합니다.
+ */
+
+#include "find_glob.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fnmatch.h>
+
+/**
+ * 토큰 종류
+ */
+enum {
+    TOK_LITERAL,    /* 문자 하나와 일치 */
+    TOK_ONE,        /* ? : 아무 문자 하나 */
+    TOK_STAR,       /* * : 아무 문자열 (빈 문자열 포함) */
+    TOK_SET         /* [...] : 집합에 속한 문자 하나 */
+};
+
+/** 대소문자 구분용 변환표 (항등) */
+static unsigned char identity_table[256];
+/** 대소문자 무시용 변환표 (ASCII 대문자 → 소문자) */
+static unsigned char fold_table[256];
+/** 변환표 초기화 여부 */
+static bool tables_ready = false;
+
+/**
+ * 변환표 초기화 (glob_compile에서 스레드 시작 전에 호출됨)
+ */
+static void init_tables(void) {
+    if (tables_ready) {
+        return;
+    }
+    for (int c = 0; c < 256; c++) {
+        identity_table[c] = (unsigned char)c;
+        fold_table[c] = (c >= 'A' && c <= 'Z') ? (unsigned char)(c - 'A' + 'a') : (unsigned char)c;
+    }
+    tables_ready = true;
+}
+
+/**
+ * 메모리 할당 실패 시 종료하는 realloc 래퍼
+ */
+static void *glob_realloc(void *ptr, size_t size) {
+    void *result = realloc(ptr, size);
+    if (!result) {
+        fprintf(stderr, "find: 메모리 할당 실패\n");
+        exit(1);
+    }
+    return result;
+}
+
+/**
+ * 비트맵 집합에 문자 하나 추가
+ */
+static void set_add(unsigned char *set, unsigned char c) {
+    set[c >> 3] |= (unsigned char)(1u << (c & 7));
+}
+
+/**
+ * 비트맵 집합에 문자가 있는지 확인
+ */
+static bool set_has(const unsigned char *set, unsigned char c) {
+    return (set[c >> 3] >> (c & 7)) & 1;
+}
+
+/**
+ * [...] 표현 하나를 해석하는 내부 함수
+ *
+ * @param p '['를 가리키는 포인터
+ * @param fold 문자 변환표
+ * @param tok 결과를 저장할 토큰
+ * @return 해석한 길이, 닫는 ']'가 없거나 문자 클래스([:alpha:] 등)처럼
+ *         지원하지 않는 문법이면 -1
+ */
+static int parse_bracket(const char *p, const unsigned char *fold, glob_token_t *tok) {
+    int j = 1;
+    bool negate = false;
+    bool first = true;
+
+    memset(tok, 0, sizeof(glob_token_t));
+    tok->kind = TOK_SET;
+
+    if (p[j] == '!' || p[j] == '^') {
+        negate = true;
+        j++;
+    }
+
+    for (;;) {
+        if (p[j] == '\0') {
+            return -1;  // 닫히지 않은 [의 처리는 fnmatch 구현마다 달라 fnmatch에 맡김
+        }
+        if (p[j] == ']' && !first) {
+            j++;
+            break;
+        }
+        if (p[j] == '[' && (p[j + 1] == ':' || p[j + 1] == '=' || p[j + 1] == '.')) {
+            return -1;  // 문자 클래스/동치 클래스/대조 기호는 fnmatch에 맡김
+        }
+        first = false;
+
+        // 범위의 시작 문자 (역슬래시는 다음 문자를 그대로 사용)
+        unsigned char lo = (unsigned char)p[j];
+        if (lo == '\\' && p[j + 1] != '\0') {
+            lo = (unsigned char)p[++j];
+        }
+        j++;
+
+        // a-z 형태의 범위 ('-'가 마지막이면 일반 문자)
+        if (p[j] == '-' && p[j + 1] != ']' && p[j + 1] != '\0') {
+            j++;
+            unsigned char hi = (unsigned char)p[j];
+            if (hi == '\\' && p[j + 1] != '\0') {
+                hi = (unsigned char)p[++j];
+            }
+            j++;
+            // 끝점을 접은 뒤의 범위를 넣음 (이름도 접어서 찾음)
+            // glibc의 FNM_CASEFOLD와 같은 방식이라 [A-z]는 a-z, [Z-a]는 빈 범위가 되며,
+            // fnmatch()로 검사하는 패턴과 결과가 같음
+            for (int c = fold[lo]; c <= fold[hi]; c++) {
+                set_add(tok->set, (unsigned char)c);
+            }
+        } else {
+            set_add(tok->set, fold[lo]);
+        }
+    }
+
+    if (negate) {
+        for (int i = 0; i < 32; i++) {
+            tok->set[i] = (unsigned char)~tok->set[i];
+        }
+    }
+    return j;
+}
+
+/**
+ * 일반 패턴을 토큰 배열로 바꾸는 내부 함수
+ *
+ * @return 성공시 true, 지원하지 않는 문법이면 false
+ */
+static bool compile_tokens(find_glob_t *glob, const char *pattern, const unsigned char *fold) {
+    size_t cap = strlen(pattern) + 1;
+    glob->tokens = glob_realloc(NULL, cap * sizeof(glob_token_t));
+    glob->token_count = 0;
+
+    for (size_t i = 0; pattern[i] != '\0'; ) {
+        glob_token_t *tok = &glob->tokens[glob->token_count];
+        unsigned char c = (unsigned char)pattern[i];
+        memset(tok, 0, sizeof(glob_token_t));
+
+        if (c == '*') {
+            // 연속된 *는 하나로 합침
+            while (pattern[i] == '*') {
+                i++;
+            }
+            tok->kind = TOK_STAR;
+        } else if (c == '?') {
+            tok->kind = TOK_ONE;
+            i++;
+        } else if (c == '[') {
+            int used = parse_bracket(pattern + i, fold, tok);
+            if (used < 0) {
+                return false;
+            }
+            i += (size_t)used;
+        } else if (c == '\\') {
+            if (pattern[i + 1] == '\0') {
+                return false;  // 끝의 역슬래시는 fnmatch에 맡김
+            }
+            tok->kind = TOK_LITERAL;
+            tok->ch = fold[(unsigned char)pattern[i + 1]];
+            i += 2;
+        } else {
+            tok->kind = TOK_LITERAL;
+            tok->ch = fold[c];
+            i++;
+        }
+        glob->token_count++;
+    }
+    return true;
+}
+
+/**
+ * 특수 문자(*, ?, [, \)가 없는 구간인지 확인하는 내부 함수
+ */
+static bool is_plain(const char *s, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        if (s[i] == '*' || s[i] == '?' || s[i] == '[' || s[i] == '\\') {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * 고정 부분을 (대소문자 무시면 소문자로) 복사해 두는 내부 함수
+ */
+static void set_literal(find_glob_t *glob, const char *s, size_t len, const unsigned char *fold) {
+    glob->literal = glob_realloc(NULL, len + 1);
+    for (size_t i = 0; i < len; i++) {
+        glob->literal[i] = (char)fold[(unsigned char)s[i]];
+    }
+    glob->literal[len] = '\0';
+    glob->literal_len = len;
+}
+
+void glob_compile(find_glob_t *glob, const char *pattern, bool casefold) {
+    init_tables();
+    const unsigned char *fold = casefold ? fold_table : identity_table;
+    size_t len = strlen(pattern);
+
+    memset(glob, 0, sizeof(find_glob_t));
+    glob->casefold = casefold;
+    glob->pattern = pattern;
+
+    // === 1단계: 자주 쓰이는 모양 인식 ===
+    size_t lead = 0, trail = 0;
+    while (lead < len && pattern[lead] == '*') {
+        lead++;
+    }
+    while (trail < len - lead && pattern[len - 1 - trail] == '*') {
+        trail++;
+    }
+    const char *core = pattern + lead;
+    size_t core_len = len - lead - trail;
+
+    if (is_plain(core, core_len)) {
+        if (core_len == 0) {
+            glob->kind = lead > 0 ? GLOB_ANY : GLOB_LITERAL;  // "*" 또는 빈 패턴
+        } else if (lead == 0 && trail == 0) {
+            glob->kind = GLOB_LITERAL;
+        } else if (lead > 0 && trail == 0) {
+            glob->kind = GLOB_SUFFIX;
+        } else if (lead == 0) {
+            glob->kind = GLOB_PREFIX;
+        } else {
+            glob->kind = GLOB_CONTAINS;
+        }
+        set_literal(glob, core, core_len, fold);
+        return;
+    }
+
+    // === 2단계: 일반 패턴은 토큰 배열로 ===
+    if (compile_tokens(glob, pattern, fold)) {
+        glob->kind = GLOB_TOKENS;
+        return;
+    }
+
+    // === 3단계: 지원하지 않는 문법은 fnmatch 사용 ===
+    free(glob->tokens);
+    glob->tokens = NULL;
+    glob->token_count = 0;
+    glob->kind = GLOB_FNMATCH;
+}
+
+/**
+ * 길이 len인 두 구간이 같은지 비교하는 내부 함수 (lit은 이미 변환된 상태)
+ */
+static bool equal_folded(const char *name, const char *lit, size_t len, bool casefold) {
+    if (!casefold) {
+        return memcmp(name, lit, len) == 0;
+    }
+    for (size_t i = 0; i < len; i++) {
+        if (fold_table[(unsigned char)name[i]] != (unsigned char)lit[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * 대소문자를 무시하고 부분 문자열을 찾는 내부 함수
+ */
+static bool contains_folded(const char *name, size_t name_len, const char *lit, size_t lit_len) {
+    unsigned char first = (unsigned char)lit[0];
+    for (size_t i = 0; i + lit_len <= name_len; i++) {
+        if (fold_table[(unsigned char)name[i]] == first &&
+            equal_folded(name + i + 1, lit + 1, lit_len - 1, true)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * 토큰 배열로 이름을 검사하는 내부 함수
+ * 마지막 *의 위치만 기억하는 백트래킹이므로 최악에도 O(패턴 길이 × 이름 길이)
+ */
+static bool match_tokens(const find_glob_t *glob, const char *name, size_t name_len) {
+    const unsigned char *fold = glob->casefold ? fold_table : identity_table;
+    const glob_token_t *tokens = glob->tokens;
+    size_t count = glob->token_count;
+    size_t ti = 0, si = 0;
+    size_t star_ti = (size_t)-1, star_si = 0;
+
+    while (si < name_len) {
+        if (ti < count) {
+            const glob_token_t *tok = &tokens[ti];
+            unsigned char c = fold[(unsigned char)name[si]];
+
+            if (tok->kind == TOK_STAR) {
+                star_ti = ti++;  // *가 빈 문자열과 일치한다고 보고 진행
+                star_si = si;
+                continue;
+            }
+            if ((tok->kind == TOK_LITERAL && tok->ch == c) ||
+                tok->kind == TOK_ONE ||
+                (tok->kind == TOK_SET && set_has(tok->set, c))) {
+                ti++;
+                si++;
+                continue;
+            }
+        }
+        if (star_ti == (size_t)-1) {
+            return false;
+        }
+        // 마지막 *가 한 글자 더 삼키도록 하고 다시 시도
+        ti = star_ti + 1;
+        si = ++star_si;
+    }
+
+    while (ti < count && tokens[ti].kind == TOK_STAR) {
+        ti++;
+    }
+    return ti == count;
+}
+
+bool glob_match(const find_glob_t *glob, const char *name, size_t name_len) {
+    size_t lit_len = glob->literal_len;
+
+    switch (glob->kind) {
+        case GLOB_LITERAL:
+            return name_len == lit_len && equal_folded(name, glob->literal, lit_len, glob->casefold);
+
+        case GLOB_ANY:
+            return true;
+
+        case GLOB_SUFFIX:
+            return name_len >= lit_len &&
+                   equal_folded(name + name_len - lit_len, glob->literal, lit_len, glob->casefold);
+
+        case GLOB_PREFIX:
+            return name_len >= lit_len && equal_folded(name, glob->literal, lit_len, glob->casefold);
+
+        case GLOB_CONTAINS:
+            if (glob->casefold) {
+                return contains_folded(name, name_len, glob->literal, lit_len);
+            }
+            return memmem(name, name_len, glob->literal, lit_len) != NULL;
+
+        case GLOB_TOKENS:
+            return match_tokens(glob, name, name_len);
+
+        case GLOB_FNMATCH:
+        default:
+            return fnmatch(glob->pattern, name, glob->casefold ? FNM_CASEFOLD : 0) == 0;
+    }
+}
+
+void glob_free(find_glob_t *glob) {
+    free(glob->literal);
+    free(glob->tokens);
+    memset(glob, 0, sizeof(find_glob_t));
+}
@@ -0,0 +1,85 @@
+/*
+ * find_glob.h - find 이름 패턴(glob) 컴파일러 선언
+ *
+ * -n, -i 패턴을 검색 시작 전에 한 번만 해석하여, 파일마다 fnmatch()가
+ * 패턴 문자열을 다시 해석하지 않도록 합니다.
+ *
+ * 자주 쓰이는 모양은 전용 비교로 처리합니다:
+ * - "main.c"  : 길이 비교 + memcmp
+ * - "*.c"     : 끝부분 비교
+ * - "test*"   : 앞부분 비교
+ * - "*cache*" : 부분 문자열 검색 (memmem)
+ * 그 외의 패턴(*, ?, [...] 조합)은 토큰 배열로 바꾸어 백트래킹 매처로 검사합니다.
+ *
+ * 대소문자 무시(-i)는 ASCII 변환표로 처리하므로 매번 로케일 함수를 부르지 않습니다.
+ * (find는 setlocale을 호출하지 않으므로 fnmatch의 FNM_CASEFOLD도 ASCII만 변환함)
+ */
+
+#ifndef FIND_GLOB_H
+#define FIND_GLOB_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * 컴파일된 패턴의 종류
+ */
+typedef enum {
+    GLOB_LITERAL,   /**< 특수 문자가 없는 패턴: 정확히 일치 */
+    GLOB_ANY,       /**< "*": 모든 이름 */
+    GLOB_SUFFIX,    /**< "*lit": 끝부분 일치 */
+    GLOB_PREFIX,    /**< "lit*": 앞부분 일치 */
+    GLOB_CONTAINS,  /**< "*lit*": 부분 문자열 포함 */
+    GLOB_TOKENS,    /**< 일반 패턴: 토큰 배열로 검사 */
+    GLOB_FNMATCH    /**< 지원하지 않는 문법([[:alpha:]] 등): fnmatch()로 검사 */
+} glob_kind_t;
+
+/**
+ * 일반 패턴의 토큰 하나
+ */
+typedef struct {
+    unsigned char kind;     /**< 토큰 종류 (find_glob.c의 TOK_*) */
+    unsigned char ch;       /**< 리터럴 문자 (대소문자 무시면 소문자로 저장) */
+    unsigned char set[32];  /**< [...] 문자 집합 비트맵 (256비트) */
+} glob_token_t;
+
+/**
+ * 컴파일된 패턴
+ */
+typedef struct {
+    glob_kind_t kind;       /**< 패턴 종류 */
+    bool casefold;          /**< 대소문자 무시 여부 */
+    char *literal;          /**< 고정 부분 (LITERAL/SUFFIX/PREFIX/CONTAINS, 대소문자 무시면 소문자) */
+    size_t literal_len;     /**< 고정 부분 길이 */
+    glob_token_t *tokens;   /**< 토큰 배열 (GLOB_TOKENS) */
+    size_t token_count;     /**< 토큰 수 */
+    const char *pattern;    /**< 원래 패턴 (GLOB_FNMATCH, 옵션 구조체의 문자열을 가리킴) */
+} find_glob_t;
+
+/**
+ * 패턴 컴파일
+ *
+ * @param glob 결과를 저장할 구조체
+ * @param pattern shell glob 패턴
+ * @param casefold true면 대소문자 무시
+ */
+void glob_compile(find_glob_t *glob, const char *pattern, bool casefold);
+
+/**
+ * 이름이 컴파일된 패턴과 일치하는지 검사 (fnmatch(pattern, name, flags) == 0과 동일)
+ *
+ * @param glob 컴파일된 패턴
+ * @param name 검사할 이름
+ * @param name_len 이름 길이
+ * @return 일치하면 true
+ */
+bool glob_match(const find_glob_t *glob, const char *name, size_t name_len);
+
+/**
+ * 컴파일된 패턴의 메모리 해제
+ *
+ * @param glob 해제할 패턴
+ */
+void glob_free(find_glob_t *glob);
+
+#endif /* FIND_GLOB_H */
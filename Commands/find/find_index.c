@@ -0,0 +1,791 @@
+/*
+ * find_index.c - find 색인(locate 방식 데이터베이스) 모듈
+ *
+ * 색인 생성/갱신(index_update)과 색인 검색(index_query)을 제공합니다.
+ * 파일 구조는 find_index.h를 참고하세요.
+ */
+
+#include "find_index.h"
+#include "find_output.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <limits.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#ifndef NAME_MAX
+#define NAME_MAX 255
+#endif
+
+/**
+ * mmap으로 연 색인 파일
+ */
+typedef struct {
+    const uint8_t *map;                 /**< 파일 전체 매핑 */
+    size_t size;                        /**< 파일 크기 */
+    const find_index_header_t *header;  /**< 헤더 */
+    const char *root;                   /**< 시작 경로 (널 종료되지 않음) */
+    const uint8_t *table;               /**< 블록 위치 표 (정렬되지 않았을 수 있어 memcpy로 읽음) */
+} index_map_t;
+
+/**
+ * 해석 중인 디렉토리 블록
+ */
+typedef struct {
+    const uint8_t *pos;     /**< 다음에 읽을 위치 */
+    const uint8_t *end;     /**< 파일 끝 */
+    uint8_t flags;          /**< 블록 플래그 */
+    int64_t mtime_sec;      /**< 디렉토리 mtime (초) */
+    long mtime_nsec;        /**< 디렉토리 mtime (나노초) */
+    const char *path;       /**< 디렉토리 경로 (널 종료되지 않음) */
+    size_t path_len;        /**< 경로 길이 */
+    uint64_t remaining;     /**< 아직 읽지 않은 항목 수 */
+    size_t name_len;        /**< 직전 항목 이름 길이 (front coding 기준) */
+    char name[NAME_MAX + 1];/**< 직전 항목 이름 */
+} index_block_t;
+
+/**
+ * 디렉토리 항목 하나 (생성/검색 공용)
+ */
+typedef struct {
+    char *name;             /**< 이름 (생성 시 힙 할당) */
+    size_t name_len;        /**< 이름 길이 */
+    mode_t mode;            /**< st_mode */
+    off_t size;             /**< st_size */
+    uid_t uid;              /**< st_uid */
+    int64_t mtime;          /**< st_mtime */
+    long mtime_nsec;        /**< st_mtim.tv_nsec (-newer, -after가 나노초까지 비교) */
+    int64_t child;          /**< 디렉토리면 하위 블록 번호 (생성 시에는 이전 색인의 블록 번호, 없으면 -1) */
+    struct timespec dir_mtim; /**< 디렉토리면 현재 mtime (하위 블록 비교용) */
+} index_entry_t;
+
+/**
+ * 생성할 디렉토리 블록 하나 (작업 스택 항목)
+ */
+typedef struct {
+    char *path;             /**< 디렉토리 경로 */
+    uint64_t block;         /**< 새 색인의 블록 번호 */
+    int64_t old_block;      /**< 이전 색인의 블록 번호 (없으면 -1) */
+    struct timespec mtim;   /**< 디렉토리의 현재 mtime */
+} index_work_t;
+
+/**
+ * 색인 생성 상태
+ */
+typedef struct {
+    FILE *fp;               /**< 임시 색인 파일 */
+    uint64_t offset;        /**< 다음 블록을 쓸 파일 내 위치 */
+    uint64_t *table;        /**< 블록 위치 표 */
+    uint64_t block_count;   /**< 번호가 할당된 블록 수 */
+    size_t table_cap;       /**< 표 용량 */
+    uint64_t entry_count;   /**< 저장한 항목 수 */
+    index_map_t *old;       /**< 이전 색인 (없으면 NULL) */
+    find_out_t buf;         /**< 블록 인코딩 버퍼 */
+    index_entry_t *entries; /**< 현재 디렉토리의 항목들 */
+    size_t entry_len;       /**< 항목 수 */
+    size_t entry_cap;       /**< 항목 배열 용량 */
+    index_work_t *stack;    /**< 작업 스택 */
+    size_t depth;           /**< 작업 스택 깊이 */
+    size_t stack_cap;       /**< 작업 스택 용량 */
+    int had_error;          /**< 열지 못한 디렉토리가 있었으면 1 */
+} index_builder_t;
+
+/**
+ * 메모리 할당 실패 시 종료하는 realloc 래퍼
+ */
+static void *index_realloc(void *ptr, size_t size) {
+    void *result = realloc(ptr, size);
+    if (!result) {
+        fprintf(stderr, "find: 메모리 할당 실패\n");
+        exit(1);
+    }
+    return result;
+}
+
+// === 가변 길이 정수 (varint) ===
+
+/**
+ * 부호 없는 정수를 7비트씩 나누어 버퍼에 추가
+ */
+static void put_uvarint(find_out_t *buf, uint64_t value) {
+    uint8_t bytes[10];
+    size_t len = 0;
+    while (value >= 0x80) {
+        bytes[len++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    bytes[len++] = (uint8_t)value;
+    fout_write(buf, (const char *)bytes, len);
+}
+
+/**
+ * 부호 있는 정수를 zigzag 변환 후 추가 (작은 음수도 짧게 저장됨)
+ */
+static void put_varint(find_out_t *buf, int64_t value) {
+    put_uvarint(buf, ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+}
+
+/**
+ * 부호 없는 가변 길이 정수 읽기
+ *
+ * @return 성공시 1, 파일 끝을 넘거나 형식이 잘못되었으면 0
+ */
+static int get_uvarint(const uint8_t **pos, const uint8_t *end, uint64_t *value) {
+    uint64_t result = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (*pos >= end) {
+            return 0;
+        }
+        uint8_t byte = *(*pos)++;
+        result |= (uint64_t)(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            *value = result;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * zigzag 변환된 부호 있는 정수 읽기
+ */
+static int get_varint(const uint8_t **pos, const uint8_t *end, int64_t *value) {
+    uint64_t raw;
+    if (!get_uvarint(pos, end, &raw)) {
+        return 0;
+    }
+    *value = (int64_t)(raw >> 1) ^ -(int64_t)(raw & 1);
+    return 1;
+}
+
+// === 색인 읽기 ===
+
+/**
+ * 색인 파일을 mmap으로 열고 헤더를 검증
+ *
+ * @return 성공시 0, 실패시 -1 (errno 설정, 형식 오류는 EINVAL)
+ */
+static int index_open(const char *path, index_map_t *index) {
+    struct stat st;
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(find_index_header_t)) {
+        close(fd);
+        errno = EINVAL;
+        return -1;
+    }
+
+    void *map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // 매핑은 fd를 닫아도 유지됨
+    if (map == MAP_FAILED) {
+        return -1;
+    }
+
+    index->map = map;
+    index->size = (size_t)st.st_size;
+    index->header = map;
+    index->root = (const char *)index->map + sizeof(find_index_header_t);
+
+    // 헤더의 위치 정보가 파일 크기 안에 있는지 확인
+    const find_index_header_t *h = index->header;
+    if (memcmp(h->magic, FIND_INDEX_MAGIC, sizeof(h->magic)) != 0 ||
+        sizeof(find_index_header_t) + h->root_len > index->size ||
+        h->table_offset > index->size ||
+        h->block_count > (index->size - h->table_offset) / sizeof(uint64_t)) {
+        munmap(map, index->size);
+        errno = EINVAL;
+        return -1;
+    }
+    index->table = index->map + h->table_offset;
+    return 0;
+}
+
+/**
+ * mmap 해제
+ */
+static void index_close(index_map_t *index) {
+    munmap((void *)index->map, index->size);
+}
+
+/**
+ * 블록 번호에 해당하는 디렉토리 블록의 머리 부분을 해석
+ *
+ * @return 성공시 1, 형식 오류면 0
+ */
+static int block_open(const index_map_t *index, uint64_t number, index_block_t *block) {
+    uint64_t offset, value;
+    const uint8_t *end = index->map + index->size;
+
+    if (number >= index->header->block_count) {
+        return 0;
+    }
+    memcpy(&offset, index->table + number * sizeof(uint64_t), sizeof(offset));
+    if (offset >= index->size) {
+        return 0;
+    }
+
+    block->pos = index->map + offset;
+    block->end = end;
+    block->flags = *block->pos++;
+    if (!get_varint(&block->pos, end, &block->mtime_sec) ||
+        !get_uvarint(&block->pos, end, &value)) {
+        return 0;
+    }
+    block->mtime_nsec = (long)value;
+    if (!get_uvarint(&block->pos, end, &value) || value > (uint64_t)(end - block->pos)) {
+        return 0;
+    }
+    block->path = (const char *)block->pos;
+    block->path_len = (size_t)value;
+    block->pos += value;
+    if (!get_uvarint(&block->pos, end, &block->remaining)) {
+        return 0;
+    }
+    block->name_len = 0;
+    return 1;
+}
+
+/**
+ * 블록의 다음 항목을 해석 (이름은 block->name에 복원됨)
+ *
+ * @return 항목을 읽었으면 1, 남은 항목이 없거나 형식 오류면 0
+ */
+static int block_next(index_block_t *block, index_entry_t *entry) {
+    uint64_t shared, suffix, mode, size, uid, mtime_nsec, child;
+    int64_t mtime;
+
+    if (block->remaining == 0) {
+        return 0;
+    }
+    if (!get_uvarint(&block->pos, block->end, &shared) ||
+        !get_uvarint(&block->pos, block->end, &suffix) ||
+        shared > block->name_len || shared + suffix > NAME_MAX ||
+        suffix > (uint64_t)(block->end - block->pos)) {
+        return 0;
+    }
+    memcpy(block->name + shared, block->pos, suffix);
+    block->pos += suffix;
+    block->name_len = (size_t)(shared + suffix);
+    block->name[block->name_len] = '\0';
+
+    if (!get_uvarint(&block->pos, block->end, &mode) ||
+        !get_uvarint(&block->pos, block->end, &size) ||
+        !get_uvarint(&block->pos, block->end, &uid) ||
+        !get_varint(&block->pos, block->end, &mtime) ||
+        !get_uvarint(&block->pos, block->end, &mtime_nsec) || mtime_nsec >= 1000000000) {
+        return 0;
+    }
+    child = (uint64_t)-1;
+    if (S_ISDIR((mode_t)mode) && !get_uvarint(&block->pos, block->end, &child)) {
+        return 0;
+    }
+
+    entry->name = block->name;
+    entry->name_len = block->name_len;
+    entry->mode = (mode_t)mode;
+    entry->size = (off_t)size;
+    entry->uid = (uid_t)uid;
+    entry->mtime = mtime;
+    entry->mtime_nsec = (long)mtime_nsec;
+    entry->child = (int64_t)child;
+    block->remaining--;
+    return 1;
+}
+
+// === 색인 생성 ===
+
+/**
+ * 현재 디렉토리 항목 배열에 빈 항목 하나를 추가
+ */
+static index_entry_t *add_entry(index_builder_t *b) {
+    if (b->entry_len == b->entry_cap) {
+        b->entry_cap = b->entry_cap ? b->entry_cap * 2 : 64;
+        b->entries = index_realloc(b->entries, b->entry_cap * sizeof(index_entry_t));
+    }
+    index_entry_t *entry = &b->entries[b->entry_len++];
+    memset(entry, 0, sizeof(index_entry_t));
+    entry->child = -1;
+    return entry;
+}
+
+/**
+ * stat 정보로 항목의 속성을 채움
+ */
+static void fill_entry(index_entry_t *entry, const struct stat *st) {
+    entry->mode = st->st_mode;
+    entry->size = st->st_size;
+    entry->uid = st->st_uid;
+    entry->mtime = (int64_t)st->st_mtime;
+    entry->mtime_nsec = st->st_mtim.tv_nsec;
+    entry->dir_mtim = st->st_mtim;
+}
+
+/**
+ * 이름순 정렬 비교 함수
+ */
+static int compare_entries(const void *a, const void *b) {
+    return strcmp(((const index_entry_t *)a)->name, ((const index_entry_t *)b)->name);
+}
+
+/**
+ * 작업 스택에 디렉토리 추가
+ */
+static void push_work(index_builder_t *b, char *path, uint64_t block, int64_t old_block, struct timespec mtim) {
+    if (b->depth == b->stack_cap) {
+        b->stack_cap = b->stack_cap ? b->stack_cap * 2 : 64;
+        b->stack = index_realloc(b->stack, b->stack_cap * sizeof(index_work_t));
+    }
+    b->stack[b->depth++] = (index_work_t){path, block, old_block, mtim};
+}
+
+/**
+ * 새 블록 번호 할당 (위치는 블록을 쓸 때 채움)
+ */
+static uint64_t alloc_block(index_builder_t *b) {
+    if (b->block_count == b->table_cap) {
+        b->table_cap = b->table_cap ? b->table_cap * 2 : 1024;
+        b->table = index_realloc(b->table, b->table_cap * sizeof(uint64_t));
+    }
+    return b->block_count++;
+}
+
+/**
+ * 디렉토리 경로 + '/' + 이름을 새로 할당해 만듦
+ */
+static char *join_path(const char *dir, size_t dir_len, const char *name, size_t name_len) {
+    char *path = index_realloc(NULL, dir_len + name_len + 2);
+    memcpy(path, dir, dir_len);
+    path[dir_len] = '/';
+    memcpy(path + dir_len + 1, name, name_len + 1);
+    return path;
+}
+
+/**
+ * 디렉토리를 다시 읽어 항목을 수집하는 내부 함수
+ *
+ * @return 성공시 0, 디렉토리를 열 수 없으면 -1
+ */
+static int collect_fresh(index_builder_t *b, const char *path) {
+    int fd = open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    DIR *dir = fd >= 0 ? fdopendir(fd) : NULL;
+    if (!dir) {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        if (fd >= 0) {
+            close(fd);
+        }
+        b->had_error = 1;
+        return -1;
+    }
+
+    struct dirent *d;
+    struct stat st;
+    while ((d = readdir(dir)) != NULL) {
+        if (strcmp(d->d_name, ".") == 0 || strcmp(d->d_name, "..") == 0) {
+            continue;
+        }
+        if (fstatat(fd, d->d_name, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+            continue;
+        }
+        index_entry_t *entry = add_entry(b);
+        entry->name_len = strlen(d->d_name);
+        entry->name = index_realloc(NULL, entry->name_len + 1);
+        memcpy(entry->name, d->d_name, entry->name_len + 1);
+        fill_entry(entry, &st);
+    }
+    closedir(dir);
+
+    if (b->entry_len > 1) {
+        qsort(b->entries, b->entry_len, sizeof(index_entry_t), compare_entries);
+    }
+    return 0;
+}
+
+/**
+ * 디렉토리 블록 하나를 만들어 파일에 씀
+ * 이전 색인의 같은 디렉토리와 mtime이 같으면 디렉토리를 열지 않고 항목을 재사용함
+ */
+static void build_block(index_builder_t *b, index_work_t *work) {
+    index_block_t old_block;
+    index_entry_t old_entry;
+    int have_old = b->old && work->old_block >= 0 &&
+                   block_open(b->old, (uint64_t)work->old_block, &old_block);
+    size_t path_len = strlen(work->path);
+    uint8_t flags = 0;
+
+    b->entry_len = 0;
+
+    if (have_old && old_block.flags == 0 &&
+        old_block.mtime_sec == (int64_t)work->mtim.tv_sec && old_block.mtime_nsec == work->mtim.tv_nsec) {
+        // === 변경 없음: 이전 항목 목록을 그대로 사용 (이미 이름순) ===
+        while (block_next(&old_block, &old_entry)) {
+            index_entry_t *entry = add_entry(b);
+            *entry = old_entry;
+            entry->name = index_realloc(NULL, old_entry.name_len + 1);
+            memcpy(entry->name, old_entry.name, old_entry.name_len + 1);
+
+            // 하위 디렉토리는 자신의 변경 여부를 확인해야 하므로 현재 정보를 다시 읽음
+            if (S_ISDIR(entry->mode)) {
+                struct stat st;
+                char *child_path = join_path(work->path, path_len, entry->name, entry->name_len);
+                int ok = lstat(child_path, &st) == 0 && S_ISDIR(st.st_mode);
+                free(child_path);
+                if (!ok) {
+                    free(entry->name);
+                    b->entry_len--;
+                    continue;
+                }
+                fill_entry(entry, &st);
+            }
+        }
+    } else {
+        // === 변경됨 (또는 처음): 디렉토리를 다시 읽음 ===
+        if (collect_fresh(b, work->path) != 0) {
+            flags = FIND_INDEX_UNREADABLE;
+        }
+
+        // 이전 색인에 있던 하위 디렉토리는 이전 블록 번호를 이어받아 변경 여부를 비교
+        while (have_old && block_next(&old_block, &old_entry)) {
+            if (!S_ISDIR(old_entry.mode)) {
+                continue;
+            }
+            index_entry_t key = {.name = old_entry.name};
+            index_entry_t *found = bsearch(&key, b->entries, b->entry_len, sizeof(index_entry_t), compare_entries);
+            if (found && S_ISDIR(found->mode)) {
+                found->child = old_entry.child;
+            }
+        }
+    }
+
+    // === 블록 인코딩 ===
+    find_out_t *buf = &b->buf;
+    buf->len = 0;
+    fout_write(buf, (const char *)&flags, 1);
+    put_varint(buf, (int64_t)work->mtim.tv_sec);
+    put_uvarint(buf, (uint64_t)work->mtim.tv_nsec);
+    put_uvarint(buf, path_len);
+    fout_write(buf, work->path, path_len);
+    put_uvarint(buf, b->entry_len);
+
+    const char *prev = "";
+    size_t prev_len = 0;
+    for (size_t i = 0; i < b->entry_len; i++) {
+        index_entry_t *entry = &b->entries[i];
+        size_t shared = 0;
+        while (shared < prev_len && shared < entry->name_len && prev[shared] == entry->name[shared]) {
+            shared++;
+        }
+        put_uvarint(buf, shared);
+        put_uvarint(buf, entry->name_len - shared);
+        fout_write(buf, entry->name + shared, entry->name_len - shared);
+        put_uvarint(buf, entry->mode);
+        put_uvarint(buf, (uint64_t)entry->size);
+        put_uvarint(buf, entry->uid);
+        put_varint(buf, entry->mtime);
+        put_uvarint(buf, (uint64_t)entry->mtime_nsec);
+
+        // 하위 디렉토리에 새 블록 번호를 주고 작업으로 등록
+        if (S_ISDIR(entry->mode)) {
+            uint64_t child_block = alloc_block(b);
+            put_uvarint(buf, child_block);
+            push_work(b, join_path(work->path, path_len, entry->name, entry->name_len),
+                      child_block, entry->child, entry->dir_mtim);
+        }
+        prev = entry->name;
+        prev_len = entry->name_len;
+    }
+    b->entry_count += b->entry_len;
+
+    b->table[work->block] = b->offset;
+    if (fwrite(buf->data, 1, buf->len, b->fp) != buf->len) {
+        b->had_error = 1;
+    }
+    b->offset += buf->len;
+
+    for (size_t i = 0; i < b->entry_len; i++) {
+        free(b->entries[i].name);
+    }
+}
+
+int index_update(const find_options_t *opts) {
+    const char *db_path = opts->index_build;
+    const char *root = opts->search_path;
+    size_t root_len = strlen(root);
+    index_builder_t b;
+    index_map_t old;
+    find_index_header_t header;
+    struct stat st;
+
+    if (stat(root, &st) != 0) {
+        perror(root);
+        return 1;
+    }
+
+    memset(&b, 0, sizeof(b));
+
+    // 같은 시작 경로로 만든 이전 색인이 있으면 갱신에 사용
+    if (index_open(db_path, &old) == 0) {
+        if (old.header->root_len == root_len && memcmp(old.root, root, root_len) == 0) {
+            b.old = &old;
+        } else {
+            index_close(&old);
+        }
+    }
+
+    // 새 색인은 임시 파일에 쓰고 마지막에 rename으로 교체
+    size_t temp_size = strlen(db_path) + 32;
+    char *temp_path = index_realloc(NULL, temp_size);
+    snprintf(temp_path, temp_size, "%s.%ld.tmp", db_path, (long)getpid());
+    b.fp = fopen(temp_path, "wb");
+    if (!b.fp) {
+        perror(temp_path);
+        free(temp_path);
+        if (b.old) {
+            index_close(b.old);
+        }
+        return 1;
+    }
+
+    memset(&header, 0, sizeof(header));
+    fwrite(&header, sizeof(header), 1, b.fp);  // 자리만 잡아 두고 마지막에 다시 씀
+    fwrite(root, 1, root_len, b.fp);
+    b.offset = sizeof(header) + root_len;
+    fout_init(&b.buf, -1);
+
+    // 시작 경로가 디렉토리면 블록 0부터 깊이 우선으로 생성
+    if (S_ISDIR(st.st_mode)) {
+        uint64_t root_block = alloc_block(&b);
+        int64_t old_root = b.old && b.old->header->block_count > 0 ? 0 : -1;
+        push_work(&b, strdup(root), root_block, old_root, st.st_mtim);
+        while (b.depth > 0) {
+            index_work_t work = b.stack[--b.depth];
+            build_block(&b, &work);
+            free(work.path);
+        }
+    }
+
+    // 블록 위치 표와 헤더 기록
+    memcpy(header.magic, FIND_INDEX_MAGIC, sizeof(header.magic));
+    header.block_count = b.block_count;
+    header.table_offset = b.offset;
+    header.entry_count = b.entry_count;
+    header.root_len = (uint32_t)root_len;
+    header.root_mode = st.st_mode;
+    header.root_size = (uint64_t)st.st_size;
+    header.root_uid = st.st_uid;
+    header.root_mtime = (int64_t)st.st_mtime;
+    header.root_mtime_nsec = (uint32_t)st.st_mtim.tv_nsec;
+
+    int ok = fwrite(b.table, sizeof(uint64_t), b.block_count, b.fp) == b.block_count &&
+             fseek(b.fp, 0, SEEK_SET) == 0 &&
+             fwrite(&header, sizeof(header), 1, b.fp) == 1 &&
+             fflush(b.fp) == 0 && fsync(fileno(b.fp)) == 0;
+    if (fclose(b.fp) != 0) {
+        ok = 0;
+    }
+    if (b.old) {
+        index_close(b.old);
+    }
+
+    if (!ok || rename(temp_path, db_path) != 0) {
+        fprintf(stderr, "find: %s: 색인을 저장할 수 없습니다: %s\n", db_path, strerror(errno));
+        unlink(temp_path);
+        b.had_error = 1;
+    }
+
+    free(temp_path);
+    free(b.buf.data);
+    free(b.entries);
+    free(b.stack);
+    free(b.table);
+    return b.had_error ? 1 : 0;
+}
+
+// === 색인 검색 ===
+
+/**
+ * 하위 블록이 빈 디렉토리인지 확인하는 내부 함수
+ */
+static bool block_is_empty(const index_map_t *index, int64_t number) {
+    index_block_t block;
+    return number >= 0 && block_open(index, (uint64_t)number, &block) &&
+           block.flags == 0 && block.remaining == 0;
+}
+
+/**
+ * 색인 항목의 정보를 stat 구조체로 옮기는 내부 함수 (저장된 필드만 채움)
+ */
+static void entry_stat(const index_entry_t *entry, struct stat *st) {
+    memset(st, 0, sizeof(*st));
+    st->st_mode = entry->mode;
+    st->st_size = entry->size;
+    st->st_uid = entry->uid;
+    st->st_mtim.tv_sec = (time_t)entry->mtime;
+    st->st_mtim.tv_nsec = entry->mtime_nsec;
+}
+
+/**
+ * 색인 항목 하나가 조건에 맞는지 확인하는 내부 함수
+ * -e는 파일시스템 대신 색인 정보(크기, 하위 블록의 항목 수)로 판단함
+ */
+static bool entry_matches(const find_plan_t *plan, bool want_empty, const index_map_t *index,
+                          const index_entry_t *entry, const struct stat *st) {
+    if (plan->never || !plan_match_name_type(plan, entry->name, entry->name_len, entry->mode & S_IFMT)) {
+        return false;
+    }
+    if (plan->needs_stat && !plan_match_stat(plan, AT_FDCWD, entry->name, st)) {
+        return false;
+    }
+    if (want_empty) {
+        if (S_ISREG(entry->mode)) {
+            return entry->size == 0;
+        }
+        return S_ISDIR(entry->mode) && block_is_empty(index, entry->child);
+    }
+    return true;
+}
+
+int index_query(const find_options_t *opts, const find_plan_t *plan) {
+    index_map_t index;
+    find_out_t out;
+    find_plan_t query_plan = *plan;  // -e만 뺀 얕은 복사본 (패턴은 원본과 공유)
+    bool want_empty = false;
+    bool want_content = false;
+    int corrupt = 0;
+
+    if (index_open(opts->index_query, &index) != 0) {
+        fprintf(stderr, "find: %s: 색인을 열 수 없습니다: %s\n", opts->index_query, strerror(errno));
+        return 1;
+    }
+
+    // -e는 파일시스템을 보지 않고 색인으로 판단하기 위해 계획에서 분리
+    // -g, -G는 파일을 읽어야 하므로 나머지 조건을 통과한 뒤 전체 경로로 검사
+    query_plan.pred_count = 0;
+    for (int i = 0; i < plan->pred_count; i++) {
+        if (plan->preds[i] == PRED_EMPTY) {
+            want_empty = true;
+        } else if (plan->preds[i] == PRED_CONTENT) {
+            want_content = true;
+        } else {
+            query_plan.preds[query_plan.pred_count++] = plan->preds[i];
+        }
+    }
+    query_plan.needs_stat = query_plan.stat_from < query_plan.pred_count;
+
+    fout_init(&out, STDOUT_FILENO);
+
+    // 시작 경로 자체
+    const find_index_header_t *h = index.header;
+    const char *root = index.root;
+    size_t root_len = h->root_len;
+    const char *base = root;
+    for (size_t i = 0; i < root_len; i++) {
+        if (root[i] == '/') {
+            base = root + i + 1;  // '/' 이후 부분, 없으면 전체
+        }
+    }
+    char root_name[NAME_MAX + 1];
+    size_t base_len = root_len - (size_t)(base - root);
+    if (base_len > NAME_MAX) {
+        base_len = NAME_MAX;
+    }
+    memcpy(root_name, base, base_len);
+    root_name[base_len] = '\0';
+
+    index_entry_t root_entry = {
+        .name = root_name, .name_len = base_len, .mode = h->root_mode, .size = (off_t)h->root_size,
+        .uid = h->root_uid, .mtime = h->root_mtime, .mtime_nsec = (long)h->root_mtime_nsec, .child = h->block_count > 0 ? 0 : -1
+    };
+    struct stat st;
+    entry_stat(&root_entry, &st);
+    if (opts->mindepth == 0 && entry_matches(&query_plan, want_empty, &index, &root_entry, &st)) {
+        // 색인 안의 시작 경로는 '\0'으로 끝나지 않으므로 복사해서 열기
+        char *root_path = want_content ? strndup(root, root_len) : NULL;
+        if (!want_content || (root_path && content_match_at(&plan->content, AT_FDCWD, root_path, &st))) {
+            fout_entry(&out, root, root_len, &st);
+        }
+        free(root_path);
+    }
+
+    // 블록 0부터 깊이 우선으로 출력 (명시적 스택)
+    index_block_t *stack = NULL;
+    size_t depth = 0, cap = 0;
+    char *path = NULL;
+    size_t path_cap = 0;
+
+    // 스택 깊이 = 지금 읽는 블록 항목들의 깊이 (-maxdepth 0이면 시작 경로만)
+    if (h->block_count > 0 && opts->maxdepth != 0) {
+        stack = index_realloc(NULL, (cap = 64) * sizeof(index_block_t));
+        if (block_open(&index, 0, &stack[0])) {
+            depth = 1;
+        } else {
+            corrupt = 1;
+        }
+    }
+
+    while (depth > 0) {
+        index_block_t *block = &stack[depth - 1];
+        index_entry_t entry;
+
+        if (!block_next(block, &entry)) {
+            if (block->remaining != 0) {
+                corrupt = 1;
+            }
+            depth--;
+            continue;
+        }
+
+        // -prune 패턴에 맞는 디렉토리는 출력하지도 내려가지도 않음
+        if (S_ISDIR(entry.mode) && plan->prune_count > 0 && plan_prunes(plan, entry.name, entry.name_len)) {
+            continue;
+        }
+
+        entry_stat(&entry, &st);
+        if ((int)depth >= opts->mindepth && entry_matches(&query_plan, want_empty, &index, &entry, &st)) {
+            size_t need = block->path_len + entry.name_len + 2;
+            if (need > path_cap) {
+                path_cap = need * 2;
+                path = index_realloc(path, path_cap);
+            }
+            memcpy(path, block->path, block->path_len);
+            path[block->path_len] = '/';
+            memcpy(path + block->path_len + 1, entry.name, entry.name_len);
+            path[need - 1] = '\0';
+            if (!want_content || content_match_at(&plan->content, AT_FDCWD, path, &st)) {
+                fout_entry(&out, path, need - 1, &st);
+            }
+        }
+
+        if (S_ISDIR(entry.mode) && (opts->maxdepth < 0 || (int)depth < opts->maxdepth)) {
+            if (depth >= h->block_count) {
+                corrupt = 1;  // 블록이 순환하는 손상된 색인
+                break;
+            }
+            if (depth == cap) {
+                stack = index_realloc(stack, (cap *= 2) * sizeof(index_block_t));
+            }
+            if (entry.child < 0 || !block_open(&index, (uint64_t)entry.child, &stack[depth])) {
+                corrupt = 1;
+                continue;
+            }
+            depth++;
+        }
+    }
+
+    fout_free(&out);
+    free(stack);
+    free(path);
+    index_close(&index);
+
+    if (corrupt) {
+        fprintf(stderr, "find: %s: 색인 파일이 손상되었습니다\n", opts->index_query);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,75 @@
+/*
+ * find_index.h - find 색인(locate 방식 데이터베이스) 선언
+ *
+ * 검색 경로 아래의 모든 항목을 (경로, 타입, 크기, 소유자, 권한, 수정 시각)으로
+ * 파일에 저장해 두고, 같은 검색 옵션으로 파일시스템 대신 색인을 검색합니다.
+ *
+ * 파일 구조 (모든 정수는 이 시스템의 바이트 순서):
+ * - 헤더 (find_index_header_t) + 시작 경로 문자열
+ * - 디렉토리 블록들: 디렉토리 하나의 항목들을 이름순으로 저장
+ *     플래그(1바이트), 디렉토리 mtime(초, 나노초), 디렉토리 경로, 항목 수,
+ *     항목마다: 앞 항목과 공유하는 이름 앞부분 길이 + 나머지 이름 (front coding),
+ *               타입, 권한, 크기, UID, 수정 시각(초, 나노초), (디렉토리면) 하위 블록 번호
+ *   숫자는 가변 길이(varint)로 저장하여 크기를 줄입니다.
+ * - 블록 번호 → 파일 내 위치 표 (uint64_t 배열)
+ *
+ * 검색은 mmap으로 연 색인을 순서대로 해석하므로 파일 전체를 읽어 들이지 않습니다.
+ *
+ * 갱신(-U를 다시 실행)할 때는 mtime이 바뀐 디렉토리만 다시 읽고, 나머지
+ * 디렉토리의 항목 목록은 이전 색인에서 그대로 가져옵니다. 따라서 이름 변화
+ * (생성/삭제/이름 변경)는 반영되지만, 디렉토리 mtime이 바뀌지 않는 파일 내용
+ * 변경(크기, 수정 시각)은 그 디렉토리가 바뀔 때까지 이전 값으로 남습니다.
+ */
+
+#ifndef FIND_INDEX_H
+#define FIND_INDEX_H
+
+#include "find_options.h"
+#include "find_plan.h"
+#include <stdint.h>
+
+/** 색인 파일 식별자 */
+#define FIND_INDEX_MAGIC "FINDIDX2"
+
+/** 블록 플래그: 디렉토리를 열 수 없었음 */
+#define FIND_INDEX_UNREADABLE 0x01
+
+/**
+ * 색인 파일 헤더
+ */
+typedef struct {
+    char magic[8];          /**< FIND_INDEX_MAGIC */
+    uint64_t block_count;   /**< 디렉토리 블록 수 (시작 경로가 디렉토리가 아니면 0) */
+    uint64_t table_offset;  /**< 블록 위치 표의 파일 내 위치 */
+    uint64_t entry_count;   /**< 저장된 항목 수 (시작 경로 제외) */
+    uint32_t root_len;      /**< 헤더 뒤에 오는 시작 경로 길이 */
+    uint32_t root_mode;     /**< 시작 경로의 st_mode */
+    uint64_t root_size;     /**< 시작 경로의 st_size */
+    uint32_t root_uid;      /**< 시작 경로의 st_uid */
+    uint32_t root_mtime_nsec; /**< 시작 경로의 st_mtim.tv_nsec */
+    int64_t root_mtime;     /**< 시작 경로의 st_mtime */
+} find_index_header_t;
+
+/**
+ * 검색 경로의 색인을 만들거나 갱신 (-U 옵션)
+ *
+ * 같은 시작 경로로 만든 색인이 이미 있으면 mtime이 바뀐 디렉토리만 다시 읽습니다.
+ * 새 색인은 임시 파일에 쓴 뒤 rename()으로 교체하므로 검색 중에 갱신해도 안전합니다.
+ *
+ * @param opts 검색 옵션 (search_path, index_build 사용)
+ * @return 성공시 0, 실패시 1
+ */
+int index_update(const find_options_t *opts);
+
+/**
+ * 색인에서 조건에 맞는 경로를 찾아 표준 출력에 출력 (-I 옵션)
+ *
+ * 색인을 만들 때의 시작 경로 아래를 검색하며, 각 디렉토리의 항목은 이름순으로 출력됩니다.
+ *
+ * @param opts 검색 옵션 (index_query 사용)
+ * @param plan 검색 조건 실행 계획
+ * @return 성공시 0, 색인을 읽을 수 없으면 1
+ */
+int index_query(const find_options_t *opts, const find_plan_t *plan);
+
+#endif /* FIND_INDEX_H */
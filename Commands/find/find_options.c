@@ -14,12 +14,33 @@
  * -u [사용자]: 소유자 조건
  * -p [권한]: 권한 조건
  * -t [일수]: 수정 시간 조건 (+n: n일 이전, -n: n일 이내, n: 정확히 n일 전)
+ * -newer [파일]: 기준 파일보다 나중에 수정된 항목 (나노초 단위 비교)
+ * -mmin/-amin/-cmin [분]: 수정/접근/상태 변경 시간 조건 (+n: n분 초과, -n: n분 미만, n: n분 전)
+ * -after [시각], -before [시각]: 수정 시각이 절대 시각 이후(포함)/이전(제외)
+ * -g [문자열]: 파일 내용에 문자열이 들어 있는 파일
+ * -G [정규식]: 파일 내용이 정규식에 일치하는 파일
+ * -j [개수]: 병렬 탐색 스레드 수
+ * -O: 병렬 탐색에서도 출력 순서 유지
+ * -U [파일]: 색인 생성/갱신
+ * -I [파일]: 색인 검색
+ * -W: 감시 모드 (새로 생기거나 바뀐 경로를 계속 출력)
+ * -D: 중복 파일 찾기 (내용이 같은 파일들을 묶어서 출력)
+ * -exec 명령 ... ; / -exec 명령 ... {} +: 결과마다 / 묶어서 명령 실행
+ * -P [개수]: 동시에 실행할 최대 명령 수
+ * -maxdepth [깊이], -mindepth [깊이]: 탐색/출력 깊이 제한
+ * -prune [패턴]: 이름이 패턴에 맞는 디렉토리는 열지 않음 (여러 번 지정 가능)
+ * -xdev: 다른 파일시스템으로 내려가지 않음
+ * -print0: 경로를 '\0'으로 구분하여 출력
+ * -printf [형식]: 경로 대신 형식에 맞춰 출력
  */
 
 #include "find_options.h"
+#include "find_content.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+#include <sys/stat.h>
 
 /**
  * 옵션 구조체를 기본값으로 초기화
@@ -37,6 +58,9 @@ void init_options(find_options_t *opts) {
     opts->mtime_days = -1;      // 초기값은 -1 (설정되지 않음을 의미)
     opts->mtime_prefix = 0;     // 접두어 없음
     opts->mtime_set = false;    // mtime 조건이 설정되지 않음
+    
+    // 깊이 제한 없음
+    opts->maxdepth = -1;
 }
 
 /**
@@ -51,6 +75,24 @@ void free_options(find_options_t *opts) {
     if (opts->size_spec) free(opts->size_spec);
     if (opts->user_name) free(opts->user_name);
     if (opts->perm_spec) free(opts->perm_spec);
+    if (opts->index_build) free(opts->index_build);
+    if (opts->index_query) free(opts->index_query);
+    if (opts->print_format) free(opts->print_format);
+    if (opts->content_literal) free(opts->content_literal);
+    if (opts->content_regex) free(opts->content_regex);
+    if (opts->time_conds) free(opts->time_conds);
+    if (opts->prune_patterns) {
+        for (int i = 0; i < opts->prune_count; i++) {
+            free(opts->prune_patterns[i]);
+        }
+        free(opts->prune_patterns);
+    }
+    if (opts->exec_argv) {
+        for (int i = 0; i < opts->exec_argc; i++) {
+            free(opts->exec_argv[i]);
+        }
+        free(opts->exec_argv);
+    }
     if (opts->search_path) free(opts->search_path);
 }
 
@@ -72,6 +114,31 @@ void print_usage(const char *prog_name) {
     printf("  -p [권한]    권한으로 검색 (-perm)\n");
     printf("  -t [일수]    수정 시간으로 검색 (-mtime)\n");
     printf("               +n: n일 이전, -n: n일 이내, n: 정확히 n일 전\n");
+    printf("  -newer [파일] 기준 파일보다 나중에 수정된 항목 (나노초 단위 비교)\n");
+    printf("  -mmin [분]   수정 시간을 분 단위로 검색 (+n: n분 초과, -n: n분 미만, n: n-1분 초과 n분 이하)\n");
+    printf("  -amin [분]   접근 시간을 분 단위로 검색\n");
+    printf("  -cmin [분]   상태 변경 시간을 분 단위로 검색\n");
+    printf("  -after [시각]  수정 시각이 이 시각 이후인 항목 (시각 포함)\n");
+    printf("  -before [시각] 수정 시각이 이 시각 이전인 항목 (시각 제외)\n");
+    printf("               시각: YYYY-MM-DD[ HH:MM[:SS[.나노초]]] (지역 시간) 또는 @초[.나노초]\n");
+    printf("  -g [문자열]  내용에 문자열이 들어 있는 파일 (다른 조건을 통과한 파일만 읽음)\n");
+    printf("  -G [정규식]  내용이 정규식(POSIX 확장, 줄 단위)에 일치하는 파일\n");
+    printf("  -maxdepth [깊이] 시작 경로로부터 깊이까지만 탐색 (0이면 시작 경로만)\n");
+    printf("  -mindepth [깊이] 깊이보다 얕은 항목은 출력하지 않음 (1이면 시작 경로 제외)\n");
+    printf("  -prune [패턴] 이름이 패턴에 맞는 디렉토리는 열지도 출력하지도 않음 (여러 번 지정 가능)\n");
+    printf("  -xdev        시작 경로와 다른 파일시스템의 디렉토리로 내려가지 않음\n");
+    printf("  -j [개수]    개수만큼의 스레드로 병렬 탐색 (출력 순서는 정해지지 않음)\n");
+    printf("  -O           병렬 탐색에서도 단일 스레드와 같은 순서로 출력\n");
+    printf("  -U [파일]    검색 경로의 색인을 파일에 만들거나 갱신 (바뀐 디렉토리만 다시 읽음)\n");
+    printf("  -I [파일]    파일시스템 대신 색인에서 검색 (색인을 만든 경로 기준)\n");
+    printf("  -D           내용이 같은 파일들을 묶어서 출력 (크기 → 앞 4KB → 전체 순으로 비교)\n");
+    printf("  -W           처음 탐색 후 새로 생기거나 바뀐 경로를 계속 출력 (Ctrl+C로 종료)\n");
+    printf("  -exec 명령 ... ;     결과마다 명령 실행, 인자의 {}는 경로로 바뀜 (출력 대신 실행)\n");
+    printf("  -exec 명령 ... {} +  여러 결과를 인자로 묶어 실행 (ARG_MAX 이내로 나눔)\n");
+    printf("  -P [개수]    동시에 실행할 최대 명령 수 (기본값 1)\n");
+    printf("  -print0      경로 뒤에 개행 대신 NUL 문자 출력 (xargs -0 용)\n");
+    printf("  -printf [형식] 형식에 맞춰 출력: %%p 경로, %%f 이름, %%s 크기, %%m 권한,\n");
+    printf("               %%u 소유자, %%T 수정 시각, %%y 타입, %%%% '%%', \\n 개행, \\0 NUL\n");
     printf("\n");
     printf("예시:\n");
     printf("  %s -f -n \"*.c\" -e     # 빈 .c 파일 검색\n", prog_name);
@@ -79,6 +146,236 @@ void print_usage(const char *prog_name) {
     printf("  %s -t +7              # 7일 이전에 수정된 파일\n", prog_name);
     printf("  %s -t -3              # 3일 이내에 수정된 파일\n", prog_name);
     printf("  %s -t 5               # 정확히 5일 전에 수정된 파일\n", prog_name);
+    printf("  %s / -j 8 -n \"*.log\" # 8개 스레드로 .log 파일 검색\n", prog_name);
+    printf("  %s /data -U data.idx  # /data의 색인 생성/갱신\n", prog_name);
+    printf("  %s -I data.idx -n \"*.log\" # 색인에서 .log 파일 검색\n", prog_name);
+    printf("  %s /var/log -W -n \"*.log\" # 새로 쓰인 .log 파일을 계속 출력\n", prog_name);
+    printf("  %s -n \"*.o\" -exec rm {} \\;  # .o 파일마다 rm 실행\n", prog_name);
+    printf("  %s -f -exec gzip {} + -P 4  # 4개씩 동시에 묶어서 gzip 실행\n", prog_name);
+    printf("  %s -f -printf '%%s\\t%%p\\n'  # 크기와 경로 출력\n", prog_name);
+    printf("  %s . -prune node_modules -prune .git -n \"*.js\" # 두 디렉토리를 건너뜀\n", prog_name);
+    printf("  %s src -n \"*.c\" -g malloc  # malloc을 쓰는 .c 파일\n", prog_name);
+    printf("  %s /data -f -newer last.stamp  # 지난 백업 이후 바뀐 파일\n", prog_name);
+    printf("  %s -after 2024-01-01 -before 2024-02-01  # 1월에 수정된 항목\n", prog_name);
+    printf("  %s ~/Photos -D -s +100k  # 100KB 넘는 중복 파일 묶음\n", prog_name);
+}
+
+/**
+ * -exec 뒤의 명령 인자들을 파싱 (';' 또는 "{} +"까지)
+ *
+ * @param argc 명령행 인자 개수
+ * @param argv 명령행 인자 배열
+ * @param i -exec의 위치 (파싱 후 마지막으로 사용한 인자 위치로 바뀜)
+ * @param opts 파싱 결과를 저장할 옵션 구조체
+ * @return 성공시 0, 오류시 -1
+ */
+static int parse_exec(int argc, char *argv[], int *i, find_options_t *opts) {
+    int start = *i + 1;
+    int end = start;
+
+    // ';'가 나오거나, "{}" 바로 뒤에 '+'가 나오면 명령 끝
+    while (end < argc) {
+        if (strcmp(argv[end], ";") == 0) {
+            break;
+        }
+        if (strcmp(argv[end], "+") == 0 && end > start && strcmp(argv[end - 1], "{}") == 0) {
+            opts->exec_batch = true;
+            break;
+        }
+        end++;
+    }
+    if (end >= argc) {
+        fprintf(stderr, "오류: -exec 명령은 ';' 또는 '{} +'로 끝나야 합니다.\n");
+        return -1;
+    }
+    if (end == start) {
+        fprintf(stderr, "오류: -exec 옵션에는 실행할 명령이 필요합니다.\n");
+        return -1;
+    }
+    if (opts->exec_argv) {
+        fprintf(stderr, "오류: -exec 옵션은 한 번만 사용할 수 있습니다.\n");
+        return -1;
+    }
+
+    opts->exec_argc = end - start;
+    opts->exec_argv = calloc(opts->exec_argc + 1, sizeof(char *));
+    if (!opts->exec_argv) {
+        fprintf(stderr, "find: 메모리 할당 실패\n");
+        exit(1);
+    }
+    for (int k = 0; k < opts->exec_argc; k++) {
+        opts->exec_argv[k] = strdup(argv[start + k]);
+    }
+    *i = end;
+    return 0;
+}
+
+/**
+ * 단어 옵션의 깊이 인자 파싱 (-maxdepth, -mindepth)
+ *
+ * @param argc 명령행 인자 개수
+ * @param argv 명령행 인자 배열
+ * @param i 옵션의 위치 (파싱 후 인자 위치로 바뀜)
+ * @param depth 결과를 저장할 곳
+ * @return 성공시 0, 오류시 -1
+ */
+static int parse_depth(int argc, char *argv[], int *i, int *depth) {
+    char *end;
+    if (*i + 1 >= argc) {
+        fprintf(stderr, "오류: %s 옵션에는 깊이가 필요합니다.\n", argv[*i]);
+        return -1;
+    }
+    long value = strtol(argv[*i + 1], &end, 10);
+    if (*end != '\0' || end == argv[*i + 1] || value < 0 || value > 1000000) {
+        fprintf(stderr, "오류: %s 옵션에는 0 이상의 숫자가 필요합니다.\n", argv[*i]);
+        return -1;
+    }
+    *depth = (int)value;
+    (*i)++;
+    return 0;
+}
+
+/**
+ * 시각 조건을 옵션 구조체에 추가하는 내부 함수
+ */
+static void add_time_cond(find_options_t *opts, find_time_kind_t kind, char field, char prefix, long long value) {
+    find_time_cond_t *grown = realloc(opts->time_conds, (opts->time_count + 1) * sizeof(find_time_cond_t));
+    if (!grown) {
+        fprintf(stderr, "find: 메모리 할당 실패\n");
+        exit(1);
+    }
+    opts->time_conds = grown;
+    opts->time_conds[opts->time_count].kind = kind;
+    opts->time_conds[opts->time_count].field = field;
+    opts->time_conds[opts->time_count].prefix = prefix;
+    opts->time_conds[opts->time_count].value = value;
+    opts->time_count++;
+}
+
+/**
+ * 단어 옵션의 분 인자 파싱 (-mmin, -amin, -cmin)
+ *
+ * @param argc 명령행 인자 개수
+ * @param argv 명령행 인자 배열
+ * @param i 옵션의 위치 (파싱 후 인자 위치로 바뀜)
+ * @param opts 파싱 결과를 저장할 옵션 구조체
+ * @return 성공시 0, 오류시 -1
+ */
+static int parse_minutes(int argc, char *argv[], int *i, find_options_t *opts) {
+    if (*i + 1 >= argc) {
+        fprintf(stderr, "오류: %s 옵션에는 분 수가 필요합니다.\n", argv[*i]);
+        return -1;
+    }
+    const char *text = argv[*i + 1];
+    char prefix = (text[0] == '+' || text[0] == '-') ? text[0] : 0;
+    const char *digits = text + (prefix ? 1 : 0);
+    char *end;
+    long long minutes = strtoll(digits, &end, 10);
+    if (*end != '\0' || end == digits || digits[0] == '-' || digits[0] == '+' || minutes < 0) {
+        fprintf(stderr, "오류: %s 옵션에는 +n, -n, n 형태의 분 수가 필요합니다.\n", argv[*i]);
+        return -1;
+    }
+    add_time_cond(opts, TIME_AGE, argv[*i][1], prefix, minutes);  // "-mmin"의 'm'
+    (*i)++;
+    return 0;
+}
+
+/**
+ * 소수점 이하 숫자(최대 9자리)를 나노초로 바꾸는 내부 함수
+ *
+ * @return 읽은 문자 수, 숫자가 없거나 10자리 이상이면 -1
+ */
+static int parse_fraction(const char *text, long long *nsec) {
+    int digits = 0;
+    long long value = 0;
+    while (text[digits] >= '0' && text[digits] <= '9') {
+        if (digits == 9) {
+            return -1;
+        }
+        value = value * 10 + (text[digits] - '0');
+        digits++;
+    }
+    if (digits == 0) {
+        return -1;
+    }
+    for (int k = digits; k < 9; k++) {
+        value *= 10;
+    }
+    *nsec = value;
+    return digits;
+}
+
+/**
+ * 절대 시각 문자열을 1970년부터의 나노초로 변환 (-after, -before)
+ *
+ * 형식: "YYYY-MM-DD", "YYYY-MM-DD HH:MM", "YYYY-MM-DD HH:MM:SS[.나노초]"
+ *       (날짜와 시각 사이는 공백 또는 'T', 지역 시간), "@초[.나노초]"
+ *
+ * @param text 시각 문자열
+ * @param ns 결과를 저장할 곳
+ * @return 성공시 0, 형식이 잘못되었으면 -1
+ */
+static int parse_date(const char *text, long long *ns) {
+    long long sec, nsec = 0;
+    bool negative = false;  // "@-1.5"처럼 1970년 이전이면 소수 부분도 빼야 함
+    const char *p = text;
+
+    if (*p == '@') {
+        char *end;
+        p++;
+        if (!((*p >= '0' && *p <= '9') || *p == '-')) {
+            return -1;
+        }
+        negative = *p == '-';
+        sec = strtoll(p, &end, 10);
+        p = end;
+    } else {
+        struct tm tm;
+        int used = 0;
+        memset(&tm, 0, sizeof(tm));
+        if (sscanf(p, "%4d-%2d-%2d%n", &tm.tm_year, &tm.tm_mon, &tm.tm_mday, &used) != 3 || used != 10) {
+            return -1;
+        }
+        p += used;
+        if ((*p == ' ' || *p == 'T') && p[1] != '\0') {
+            used = 0;
+            if (sscanf(p + 1, "%2d:%2d%n", &tm.tm_hour, &tm.tm_min, &used) != 2 || used != 5) {
+                return -1;
+            }
+            p += 1 + used;
+            if (*p == ':') {
+                used = 0;
+                if (sscanf(p + 1, "%2d%n", &tm.tm_sec, &used) != 1 || used != 2) {
+                    return -1;
+                }
+                p += 1 + used;
+            }
+        }
+        int year = tm.tm_year, mon = tm.tm_mon, mday = tm.tm_mday;
+        tm.tm_year -= 1900;
+        tm.tm_mon -= 1;
+        tm.tm_isdst = -1;  // 서머타임 여부는 mktime이 판단
+        time_t t = mktime(&tm);
+        // 2월 30일처럼 정규화되어 날짜가 바뀌었으면 잘못된 날짜
+        if (t == (time_t)-1 || tm.tm_year != year - 1900 || tm.tm_mon != mon - 1 || tm.tm_mday != mday ||
+            tm.tm_hour > 23 || tm.tm_min > 59 || tm.tm_sec > 59) {
+            return -1;
+        }
+        sec = (long long)t;
+    }
+
+    if (*p == '.') {
+        int used = parse_fraction(p + 1, &nsec);
+        if (used < 0) {
+            return -1;
+        }
+        p += 1 + used;
+    }
+    if (*p != '\0' || sec > 9000000000LL || sec < -9000000000LL) {
+        return -1;  // 남은 문자가 있거나 나노초로 나타낼 수 없는 범위
+    }
+    *ns = sec * 1000000000LL + (negative ? -nsec : nsec);
+    return 0;
 }
 
 /**
@@ -114,6 +411,90 @@ int parse_options(int argc, char *argv[], find_options_t *opts) {
             continue;
         }
         
+        // 단어 옵션은 묶음 옵션으로 해석하지 않음
+        if (strcmp(argv[i], "-exec") == 0) {
+            if (parse_exec(argc, argv, &i, opts) != 0) {
+                return -1;
+            }
+            continue;
+        }
+        if (strcmp(argv[i], "-maxdepth") == 0) {
+            if (parse_depth(argc, argv, &i, &opts->maxdepth) != 0) {
+                return -1;
+            }
+            continue;
+        }
+        if (strcmp(argv[i], "-mindepth") == 0) {
+            if (parse_depth(argc, argv, &i, &opts->mindepth) != 0) {
+                return -1;
+            }
+            continue;
+        }
+        if (strcmp(argv[i], "-prune") == 0) {
+            if (i + 1 >= argc) {
+                fprintf(stderr, "오류: -prune 옵션에는 패턴이 필요합니다.\n");
+                return -1;
+            }
+            char **grown = realloc(opts->prune_patterns, (opts->prune_count + 1) * sizeof(char *));
+            if (!grown) {
+                fprintf(stderr, "find: 메모리 할당 실패\n");
+                exit(1);
+            }
+            opts->prune_patterns = grown;
+            opts->prune_patterns[opts->prune_count++] = strdup(argv[++i]);
+            continue;
+        }
+        if (strcmp(argv[i], "-mmin") == 0 || strcmp(argv[i], "-amin") == 0 || strcmp(argv[i], "-cmin") == 0) {
+            if (parse_minutes(argc, argv, &i, opts) != 0) {
+                return -1;
+            }
+            continue;
+        }
+        if (strcmp(argv[i], "-after") == 0 || strcmp(argv[i], "-before") == 0) {
+            long long ns;
+            if (i + 1 >= argc || parse_date(argv[i + 1], &ns) != 0) {
+                fprintf(stderr, "오류: %s 옵션에는 YYYY-MM-DD[ HH:MM[:SS[.나노초]]] 또는 @초 형태의 시각이 필요합니다.\n",
+                        argv[i]);
+                return -1;
+            }
+            add_time_cond(opts, argv[i][1] == 'a' ? TIME_AFTER : TIME_BEFORE, 'm', 0, ns);
+            i++;
+            continue;
+        }
+        if (strcmp(argv[i], "-newer") == 0) {
+            struct stat ref;
+            if (i + 1 >= argc) {
+                fprintf(stderr, "오류: -newer 옵션에는 기준 파일이 필요합니다.\n");
+                return -1;
+            }
+            // 기준 시각은 지금 한 번만 읽음 (기준 파일 자신보다 나중이어야 하므로 +1ns)
+            if (stat(argv[i + 1], &ref) != 0) {
+                perror(argv[i + 1]);
+                return -1;
+            }
+            add_time_cond(opts, TIME_AFTER, 'm', 0,
+                          (long long)ref.st_mtim.tv_sec * 1000000000LL + ref.st_mtim.tv_nsec + 1);
+            i++;
+            continue;
+        }
+        if (strcmp(argv[i], "-xdev") == 0) {
+            opts->xdev = true;
+            continue;
+        }
+        if (strcmp(argv[i], "-print0") == 0) {
+            opts->print0 = true;
+            continue;
+        }
+        if (strcmp(argv[i], "-printf") == 0) {
+            if (i + 1 >= argc) {
+                fprintf(stderr, "오류: -printf 옵션에는 형식이 필요합니다.\n");
+                return -1;
+            }
+            free(opts->print_format);
+            opts->print_format = strdup(argv[++i]);
+            continue;
+        }
+        
         char *arg = argv[i] + 1;  // '-' 문자 제거하고 옵션 문자들만
         
         // 옵션 문자열의 각 문자를 순회하며 처리
@@ -206,6 +587,91 @@ int parse_options(int argc, char *argv[], find_options_t *opts) {
                     }
                     break;
                     
+                case 'j':
+                    if (j == strlen(arg) - 1 && i + 1 < argc) {
+                        opts->jobs = atoi(argv[++i]);  // 작업 스레드 수
+                        if (opts->jobs < 1) {
+                            fprintf(stderr, "오류: -j 옵션에는 1 이상의 숫자가 필요합니다.\n");
+                            return -1;
+                        }
+                        goto next_arg;
+                    } else {
+                        fprintf(stderr, "오류: -j 옵션은 분리해서 사용해야 합니다.\n");
+                        return -1;
+                    }
+                    break;
+                    
+                case 'g':
+                    if (j == strlen(arg) - 1 && i + 1 < argc) {
+                        free(opts->content_literal);
+                        opts->content_literal = strdup(argv[++i]);  // 찾을 문자열
+                        goto next_arg;
+                    } else {
+                        fprintf(stderr, "오류: -g 옵션은 분리해서 사용해야 합니다.\n");
+                        return -1;
+                    }
+                    break;
+                    
+                case 'G':
+                    if (j == strlen(arg) - 1 && i + 1 < argc) {
+                        if (content_check_regex(argv[i + 1]) != 0) {
+                            return -1;  // 잘못된 정규식
+                        }
+                        free(opts->content_regex);
+                        opts->content_regex = strdup(argv[++i]);  // 찾을 정규식
+                        goto next_arg;
+                    } else {
+                        fprintf(stderr, "오류: -G 옵션은 분리해서 사용해야 합니다.\n");
+                        return -1;
+                    }
+                    break;
+                    
+                case 'P':
+                    if (j == strlen(arg) - 1 && i + 1 < argc) {
+                        opts->max_procs = atoi(argv[++i]);  // 동시에 실행할 명령 수
+                        if (opts->max_procs < 1) {
+                            fprintf(stderr, "오류: -P 옵션에는 1 이상의 숫자가 필요합니다.\n");
+                            return -1;
+                        }
+                        goto next_arg;
+                    } else {
+                        fprintf(stderr, "오류: -P 옵션은 분리해서 사용해야 합니다.\n");
+                        return -1;
+                    }
+                    break;
+                    
+                case 'U':
+                    if (j == strlen(arg) - 1 && i + 1 < argc) {
+                        opts->index_build = strdup(argv[++i]);  // 만들거나 갱신할 색인 파일
+                        goto next_arg;
+                    } else {
+                        fprintf(stderr, "오류: -U 옵션은 분리해서 사용해야 합니다.\n");
+                        return -1;
+                    }
+                    break;
+                    
+                case 'I':
+                    if (j == strlen(arg) - 1 && i + 1 < argc) {
+                        opts->index_query = strdup(argv[++i]);  // 검색할 색인 파일
+                        goto next_arg;
+                    } else {
+                        fprintf(stderr, "오류: -I 옵션은 분리해서 사용해야 합니다.\n");
+                        return -1;
+                    }
+                    break;
+                    
+                case 'O':
+                    opts->ordered = true;  // 출력 순서 유지
+                    break;
+                    
+                case 'W':
+                    opts->watch = true;    // 감시 모드
+                    break;
+                    
+                case 'D':
+                    opts->dup_mode = true; // 중복 파일 찾기
+                    break;
+                    
                 case 'h':
                     print_usage(argv[0]);  // 도움말 출력
                     return 1;              // 도움말 출력 후 정상 종료를 의미
@@ -220,5 +686,38 @@ int parse_options(int argc, char *argv[], find_options_t *opts) {
         next_arg:;
     }
     
+    if (opts->content_literal && opts->content_regex) {
+        fprintf(stderr, "오류: -g와 -G 옵션은 함께 사용할 수 없습니다.\n");
+        return -1;
+    }
+    
+    // 출력 방식은 하나만 선택 가능
+    if ((opts->print0 ? 1 : 0) + (opts->print_format ? 1 : 0) + (opts->exec_argv ? 1 : 0) > 1) {
+        fprintf(stderr, "오류: -print0, -printf, -exec 옵션은 함께 사용할 수 없습니다.\n");
+        return -1;
+    }
+    
+    // 색인에는 수정 시각만 저장되므로 접근/상태 변경 시각 조건은 쓸 수 없음
+    if (opts->index_query) {
+        for (int i = 0; i < opts->time_count; i++) {
+            if (opts->time_conds[i].field != 'm') {
+                fprintf(stderr, "오류: -amin, -cmin 옵션은 색인 검색(-I)과 함께 사용할 수 없습니다.\n");
+                return -1;
+            }
+        }
+    }
+    
+    // 색인은 장치 번호를 저장하지 않고 만들 때도 파일시스템 경계를 넘으므로 -xdev를 지킬 수 없음
+    if (opts->xdev && (opts->index_query || opts->index_build)) {
+        fprintf(stderr, "오류: -xdev 옵션은 색인 생성(-U), 색인 검색(-I)과 함께 사용할 수 없습니다.\n");
+        return -1;
+    }
+    
+    // 중복 찾기는 탐색이 끝난 뒤 묶음을 출력하므로 다른 출력 방식, 감시와 함께 쓸 수 없음
+    if (opts->dup_mode && (opts->print0 || opts->print_format || opts->exec_argv || opts->watch)) {
+        fprintf(stderr, "오류: -D 옵션은 -print0, -printf, -exec, -W 옵션과 함께 사용할 수 없습니다.\n");
+        return -1;
+    }
+    
     return 0;  // 파싱 성공
 }
\ No newline at end of file
@@ -15,6 +15,27 @@
 #include <stdbool.h>
 #include <sys/types.h>
 
+/**
+ * 시각 조건 종류
+ */
+typedef enum {
+    TIME_AGE,       /**< 경과 시간 (-mmin, -amin, -cmin): +n분 초과 / -n분 미만 / n-1분 초과 n분 이하 */
+    TIME_AFTER,     /**< 기준 시각 이후, 기준 포함 (-after, -newer는 기준 + 1ns) */
+    TIME_BEFORE     /**< 기준 시각 이전, 기준 제외 (-before) */
+} find_time_kind_t;
+
+/**
+ * 시각 조건 하나 (-newer, -mmin, -amin, -cmin, -after, -before)
+ *
+ * 상대 시간(TIME_AGE)의 기준이 되는 현재 시각은 실행 계획을 만들 때 한 번만 구합니다.
+ */
+typedef struct {
+    find_time_kind_t kind;  /**< 조건 종류 */
+    char field;             /**< 비교할 시각: 'm' (수정), 'a' (접근), 'c' (상태 변경) */
+    char prefix;            /**< TIME_AGE의 접두어: '+' (초과), '-' (미만), 0 (정확히) */
+    long long value;        /**< TIME_AGE면 분 수, 아니면 기준 시각 (1970년부터 나노초) */
+} find_time_cond_t;
+
 /**
  * find 명령어의 모든 검색 옵션을 담는 구조체
  * 
@@ -41,6 +62,43 @@ typedef struct {
     int mtime_days;         /**< -t 옵션: 수정 시간 (현재로부터 n일) */
     char mtime_prefix;      /**< mtime 접두어: '+' (이전), '-' (이내), 0 (정확히) */
     bool mtime_set;         /**< mtime 조건이 설정되었는지 여부 플래그 */
+    find_time_cond_t *time_conds; /**< -newer, -mmin, -amin, -cmin, -after, -before 조건들 (모두 만족해야 함) */
+    int time_count;         /**< time_conds 개수 */
+    
+    // === 파일 내용 조건 ===
+    char *content_literal;  /**< -g 옵션: 파일 내용에 들어 있어야 할 문자열 */
+    char *content_regex;    /**< -G 옵션: 파일 내용에 일치해야 할 정규식 (POSIX 확장, 줄 단위) */
+    
+    // === 탐색 범위 ===
+    int maxdepth;           /**< -maxdepth 옵션: 시작 경로로부터 최대 깊이 (-1이면 제한 없음) */
+    int mindepth;           /**< -mindepth 옵션: 이 깊이보다 얕은 항목은 출력하지 않음 */
+    char **prune_patterns;  /**< -prune 옵션: 들어가지 않을 디렉토리 이름 패턴들 (여러 번 지정 가능) */
+    int prune_count;        /**< prune_patterns 개수 */
+    bool xdev;              /**< -xdev 옵션: 시작 경로와 다른 파일시스템으로 내려가지 않음 */
+    
+    // === 탐색 방식 ===
+    int jobs;               /**< -j 옵션: 탐색 작업 스레드 수 (0이면 단일 스레드) */
+    bool ordered;           /**< -O 옵션: 병렬 탐색에서도 단일 스레드와 같은 순서로 출력 */
+    
+    // === 색인 ===
+    char *index_build;      /**< -U 옵션: 검색 경로의 색인을 만들거나 갱신할 파일 */
+    char *index_query;      /**< -I 옵션: 파일시스템 대신 검색할 색인 파일 */
+    
+    // === 출력 형식 ===
+    bool print0;            /**< -print0 옵션: 경로 뒤에 개행 대신 '\0' 출력 */
+    char *print_format;     /**< -printf 옵션: 경로 대신 출력할 형식 (%p %f %s %m %u %T %y) */
+    
+    // === 명령 실행 ===
+    char **exec_argv;       /**< -exec 옵션: 실행할 명령과 인자 ({}는 경로로 바뀜, NULL로 끝남) */
+    int exec_argc;          /**< exec_argv의 인자 수 */
+    bool exec_batch;        /**< -exec ... {} + 형태: 여러 경로를 묶어서 한 번에 실행 */
+    int max_procs;          /**< -P 옵션: 동시에 실행할 최대 명령 수 (0이면 1개) */
+    
+    // === 중복 찾기 ===
+    bool dup_mode;          /**< -D 옵션: 내용이 같은 파일들을 묶어서 출력 */
+    
+    // === 감시 ===
+    bool watch;             /**< -W 옵션: 처음 탐색 후 새로 생기거나 바뀐 경로를 계속 출력 */
     
     // === 검색 경로 ===
     char *search_path;      /**< 검색을 시작할 기본 경로 (기본값: 현재 디렉토리 ".") */
@@ -59,6 +117,16 @@ typedef struct {
  * - 묶음 옵션: -fde (여러 플래그를 한번에)
  * - 인자가 있는 옵션: -n pattern, -s +100k
  * - 시간 조건: -t +7 (7일 이전), -t -3 (3일 이내), -t 5 (정확히 5일 전)
+ * - 병렬 탐색: -j 4 (4개 스레드), -j 4 -O (출력 순서 유지)
+ * - 색인: -U db (색인 생성/갱신), -I db (색인 검색)
+ * - 감시: -W (변경 사항을 계속 출력)
+ * - 명령 실행: -exec rm {} \; (경로마다), -exec ls -l {} + (묶어서), -P 4 (동시 실행 수)
+ * - 출력 형식: -print0 (NUL 구분), -printf '%s %p\n'
+ * - 내용 검색: -g "main(" (문자열), -G 'err(or)?' (정규식)
+ * - 정밀 시간 조건: -newer stamp, -mmin -30, -amin +60, -cmin 5,
+ *   -after 2024-01-01, -before "2024-02-01 12:00:00.5", -after @1700000000
+ * - 탐색 범위: -maxdepth 2, -mindepth 1, -prune node_modules -prune .git, -xdev
+ * - 중복 찾기: -D (내용이 같은 파일 묶음 출력)
  * - 경로 지정: find /path/to/search -f
  * 
  * @param argc 명령행 인자 개수
@@ -89,6 +157,10 @@ void init_options(find_options_t *opts);
  * 해제되는 필드들:
  * - name_pattern, iname_pattern
  * - size_spec, user_name, perm_spec
+ * - index_build, index_query, print_format
+ * - content_literal, content_regex
+ * - prune_patterns (배열과 각 패턴)
+ * - exec_argv (배열과 각 인자)
  * - search_path
  * 
  * @param opts 메모리를 해제할 옵션 구조체 포인터
@@ -0,0 +1,282 @@
+/*
+ * find_output.c - find 출력 버퍼 모듈
+ *
+ * 검색 결과를 버퍼에 모아 write()로 내보내는 기능을 제공합니다.
+ * 버퍼는 스레드마다 따로 두므로 잠금이 필요 없습니다.
+ */
+
+#include "find_output.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <limits.h>
+
+// PIPE_BUF가 정의되지 않은 시스템을 위한 대체값 (POSIX 최소값)
+#ifndef PIPE_BUF
+#define PIPE_BUF 512
+#endif
+
+// 모든 버퍼가 공유하는 설정 (탐색 시작 전에 정해지고 이후에는 읽기만 함)
+static char out_term = '\n';           // 경로 구분자
+static find_out_sink_t out_sink = NULL; // write() 대신 내용을 받을 함수
+static void *out_sink_ctx = NULL;       // out_sink에 전달할 값
+static find_out_format_t out_format = NULL; // 경로 대신 항목을 만들 형식 함수 (-printf)
+static void *out_format_ctx = NULL;     // out_format에 전달할 값
+static size_t out_flush_at = FIND_OUT_FLUSH_AT; // 이만큼 쌓이면 자동으로 내보냄
+
+void fout_set_terminator(char term) {
+    out_term = term;
+}
+
+void fout_set_sink(find_out_sink_t sink, void *ctx, int per_entry) {
+    out_sink = sink;
+    out_sink_ctx = ctx;
+    out_flush_at = per_entry ? 1 : FIND_OUT_FLUSH_AT;
+}
+
+void fout_set_format(find_out_format_t format, void *ctx) {
+    out_format = format;
+    out_format_ctx = ctx;
+}
+
+/**
+ * 출력 버퍼 초기화
+ *
+ * @param out 초기화할 버퍼
+ * @param fd 출력 대상 파일 디스크립터
+ */
+void fout_init(find_out_t *out, int fd) {
+    out->cap = fd >= 0 ? FIND_OUT_FLUSH_AT + PIPE_BUF : 4096;
+    out->data = malloc(out->cap);
+    out->len = 0;
+    out->fd = fd;
+    out->shared = 0;
+    out->ends = NULL;
+    out->end_count = out->end_cap = 0;
+    if (!out->data) {
+        fprintf(stderr, "find: 메모리 할당 실패\n");
+        exit(1);
+    }
+}
+
+/**
+ * 버퍼에 need 바이트의 여유 공간을 확보
+ *
+ * @param out 출력 버퍼
+ * @param need 필요한 바이트 수
+ */
+static void fout_reserve(find_out_t *out, size_t need) {
+    if (out->len + need <= out->cap) {
+        return;
+    }
+
+    size_t new_cap = out->cap * 2;
+    while (out->len + need > new_cap) {
+        new_cap *= 2;
+    }
+    char *new_data = realloc(out->data, new_cap);
+    if (!new_data) {
+        fprintf(stderr, "find: 메모리 할당 실패\n");
+        exit(1);
+    }
+    out->data = new_data;
+    out->cap = new_cap;
+}
+
+/**
+ * 지금까지 쌓인 내용의 끝을 항목 경계로 기록 (shared 버퍼만)
+ *
+ * @param out 출력 버퍼
+ */
+static void fout_mark_end(find_out_t *out) {
+    if (!out->shared) {
+        return;
+    }
+    if (out->end_count == out->end_cap) {
+        size_t new_cap = out->end_cap ? out->end_cap * 2 : 1024;
+        size_t *grown = realloc(out->ends, new_cap * sizeof(size_t));
+        if (!grown) {
+            fprintf(stderr, "find: 메모리 할당 실패\n");
+            exit(1);
+        }
+        out->ends = grown;
+        out->end_cap = new_cap;
+    }
+    out->ends[out->end_count++] = out->len;
+}
+
+/**
+ * 버퍼에 바이트열 추가
+ *
+ * @param out 출력 버퍼
+ * @param data 추가할 데이터
+ * @param len 데이터 길이
+ */
+void fout_write(find_out_t *out, const char *data, size_t len) {
+    fout_reserve(out, len);
+    memcpy(out->data + out->len, data, len);
+    out->len += len;
+
+    if (out->fd >= 0 && out->len >= out_flush_at) {
+        fout_flush(out);
+    }
+}
+
+/**
+ * 버퍼에 바이트열 추가 (자동으로 내보내지 않음)
+ *
+ * @param out 출력 버퍼
+ * @param data 추가할 데이터
+ * @param len 데이터 길이
+ */
+void fout_append(find_out_t *out, const char *data, size_t len) {
+    fout_reserve(out, len);
+    memcpy(out->data + out->len, data, len);
+    out->len += len;
+}
+
+/**
+ * 경로 한 줄 추가
+ *
+ * @param out 출력 버퍼
+ * @param path 출력할 경로
+ * @param len 경로 길이
+ */
+void fout_line(find_out_t *out, const char *path, size_t len) {
+    fout_reserve(out, len + 1);
+    memcpy(out->data + out->len, path, len);
+    out->data[out->len + len] = out_term;
+    out->len += len + 1;
+    fout_mark_end(out);
+
+    if (out->fd >= 0 && out->len >= out_flush_at) {
+        fout_flush(out);
+    }
+}
+
+/**
+ * 검색 결과 한 항목 추가
+ *
+ * @param out 출력 버퍼
+ * @param path 경로
+ * @param len 경로 길이
+ * @param st 파일 정보 (NULL 가능)
+ */
+void fout_entry(find_out_t *out, const char *path, size_t len, const struct stat *st) {
+    if (!out_format) {
+        fout_line(out, path, len);
+        return;
+    }
+
+    out_format(out_format_ctx, out, path, len, st);
+    fout_mark_end(out);
+    if (out->fd >= 0 && out->len >= out_flush_at) {
+        fout_flush(out);
+    }
+}
+
+/**
+ * 데이터를 끝까지 write()하는 내부 함수 (부분 쓰기와 EINTR 처리)
+ *
+ * @return 성공시 0, 실패시 -1
+ */
+static int write_all(int fd, const char *data, size_t len) {
+    while (len > 0) {
+        ssize_t n = write(fd, data, len);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        data += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+/**
+ * 쌓인 내용을 모두 write()로 내보냄
+ *
+ * @param out 출력 버퍼
+ * @return 성공시 0, 쓰기 실패시 -1
+ */
+int fout_flush(find_out_t *out) {
+    if (out->fd < 0 || out->len == 0) {
+        return 0;
+    }
+
+    size_t pos = 0;
+    size_t mark = 0;
+    int result = 0;
+
+    // -exec 등: 출력하지 않고 sink로 넘김
+    if (out_sink) {
+        out_sink(out_sink_ctx, out->data, out->len);
+        out->len = 0;
+        out->end_count = 0;
+        return 0;
+    }
+
+    // 혼자 쓰는 fd라면 write() 한 번으로 충분함
+    if (!out->shared) {
+        result = write_all(out->fd, out->data, out->len);
+        out->len = 0;
+        return result;
+    }
+
+    // 기록해 둔 항목 경계에서 PIPE_BUF 이하 단위로 잘라서 write()
+    // (PIPE_BUF 이하의 파이프 쓰기는 원자적이므로 다른 스레드 출력과 섞이지 않음)
+    while (pos < out->len && result == 0) {
+        size_t end = out->len;
+        if (end - pos > PIPE_BUF) {
+            // PIPE_BUF 안에서 마지막 항목 경계를 찾음
+            size_t best = pos;
+            while (mark < out->end_count && out->ends[mark] <= pos + PIPE_BUF) {
+                best = out->ends[mark++];
+            }
+            if (best > pos) {
+                end = best;
+            } else if (mark < out->end_count) {
+                end = out->ends[mark++];  // 한 항목이 PIPE_BUF보다 길면 그 항목 끝까지 한 번에 씀
+            }
+        }
+        result = write_all(out->fd, out->data + pos, end - pos);
+        pos = end;
+    }
+
+    out->len = 0;
+    out->end_count = 0;
+    return result;
+}
+
+/**
+ * 쌓인 내용을 내보내고 sink에 처리 시점을 알림 (data가 NULL인 호출)
+ *
+ * @param out 출력 버퍼
+ * @return 성공시 0, 쓰기 실패시 -1
+ */
+int fout_commit(find_out_t *out) {
+    int result = fout_flush(out);
+    if (out_sink) {
+        out_sink(out_sink_ctx, NULL, 0);
+    }
+    return result;
+}
+
+/**
+ * 남은 내용을 내보내고 버퍼 메모리 해제
+ *
+ * @param out 해제할 버퍼
+ */
+void fout_free(find_out_t *out) {
+    fout_flush(out);
+    free(out->data);
+    free(out->ends);
+    out->data = NULL;
+    out->ends = NULL;
+    out->len = out->cap = 0;
+    out->end_count = out->end_cap = 0;
+}
@@ -0,0 +1,165 @@
+/*
+ * find_output.h - find 출력 버퍼 구조체 및 함수 선언
+ *
+ * 검색 결과를 printf로 한 줄씩 출력하는 대신 큰 버퍼에 모아
+ * write() 시스템 콜로 한 번에 내보냅니다.
+ *
+ * 병렬 탐색에서는 작업 스레드마다 자신의 버퍼를 가지며,
+ * 잠금 없이 각자 write()로 내보냅니다. 한 번의 write()는 항목(레코드) 경계에서
+ * PIPE_BUF 이하로 잘라 보내므로 파이프로 출력해도 항목이 섞이지 않습니다.
+ * -printf 형식에 구분자가 여러 번 들어가거나 이름에 개행이 있어도 항목 단위로 나뉘도록
+ * 항목이 끝나는 위치를 따로 기록합니다.
+ *
+ * -exec처럼 결과를 출력하지 않고 다른 곳에서 처리해야 할 때는
+ * fout_set_sink()로 내보낼 곳을 바꾸면, 표준 출력으로 가던 버퍼의 내용이
+ * write() 대신 그 함수로 전달됩니다 (-exec ... ;처럼 결과마다 바로 처리해야 하면
+ * 항목 하나마다 전달). 경로 사이의 구분자는
+ * fout_set_terminator()로 바꿀 수 있습니다 (기본값 '\n').
+ * -printf처럼 경로 대신 정해진 형식으로 출력할 때는 fout_set_format()으로
+ * 형식 함수를 지정하면 fout_entry()가 그 함수로 한 항목을 만듭니다.
+ */
+
+#ifndef FIND_OUTPUT_H
+#define FIND_OUTPUT_H
+
+#include <stddef.h>
+#include <sys/stat.h>
+
+/** 버퍼에 이만큼 쌓이면 자동으로 내보냄 */
+#define FIND_OUT_FLUSH_AT (64 * 1024)
+
+/**
+ * 출력 버퍼 내용을 받는 함수 (경로 + 구분자가 반복되는 완전한 레코드들)
+ * data가 NULL이면 모아 둔 것을 지금 처리하라는 알림입니다 (fout_commit).
+ * 병렬 탐색에서는 여러 스레드가 동시에 호출할 수 있습니다.
+ */
+typedef void (*find_out_sink_t)(void *ctx, const char *data, size_t len);
+
+/**
+ * 출력 버퍼 구조체
+ */
+typedef struct {
+    char *data;         /**< 쌓인 출력 데이터 */
+    size_t len;         /**< 현재 쌓인 바이트 수 */
+    size_t cap;         /**< 버퍼 용량 */
+    int fd;             /**< 출력 대상 파일 디스크립터 (음수면 메모리에만 누적) */
+    int shared;         /**< 다른 스레드와 fd를 공유하면 1 (항목 경계 PIPE_BUF 단위로 write) */
+    size_t *ends;       /**< 항목이 끝나는 위치들 (shared일 때만 기록) */
+    size_t end_count;   /**< ends에 기록된 위치 수 */
+    size_t end_cap;     /**< ends 용량 */
+} find_out_t;
+
+/**
+ * 검색 결과 한 항목을 원하는 형식으로 버퍼에 쓰는 함수 (-printf)
+ * st는 형식에 파일 정보가 필요 없으면 NULL일 수 있습니다.
+ */
+typedef void (*find_out_format_t)(void *ctx, find_out_t *out, const char *path, size_t len,
+                                  const struct stat *st);
+
+/**
+ * 출력 버퍼 초기화
+ *
+ * @param out 초기화할 버퍼
+ * @param fd 출력 대상 (-1이면 자동으로 내보내지 않고 메모리에 계속 누적)
+ */
+void fout_init(find_out_t *out, int fd);
+
+/**
+ * 버퍼에 바이트열 추가
+ *
+ * fd가 지정된 버퍼는 FIND_OUT_FLUSH_AT을 넘으면 자동으로 내보냅니다.
+ *
+ * @param out 출력 버퍼
+ * @param data 추가할 데이터
+ * @param len 데이터 길이
+ */
+void fout_write(find_out_t *out, const char *data, size_t len);
+
+/**
+ * 버퍼에 바이트열 추가 (자동으로 내보내지 않음)
+ *
+ * 형식 함수가 한 항목을 여러 조각으로 쓸 때 사용하며, 항목이 끝난 뒤
+ * fout_entry()가 내보낼지 판단하므로 한 항목이 두 번의 write()로 나뉘지 않습니다.
+ *
+ * @param out 출력 버퍼
+ * @param data 추가할 데이터
+ * @param len 데이터 길이
+ */
+void fout_append(find_out_t *out, const char *data, size_t len);
+
+/**
+ * 경로 한 줄(경로 + 개행) 추가
+ *
+ * @param out 출력 버퍼
+ * @param path 출력할 경로
+ * @param len 경로 길이
+ */
+void fout_line(find_out_t *out, const char *path, size_t len);
+
+/**
+ * 검색 결과 한 항목 추가
+ *
+ * 형식 함수가 지정되어 있으면 그 함수로, 아니면 경로 + 구분자로 씁니다.
+ *
+ * @param out 출력 버퍼
+ * @param path 경로
+ * @param len 경로 길이
+ * @param st 파일 정보 (형식에 필요하지 않으면 NULL 가능)
+ */
+void fout_entry(find_out_t *out, const char *path, size_t len, const struct stat *st);
+
+/**
+ * 쌓인 내용을 모두 write()로 내보냄
+ *
+ * shared가 설정된 버퍼는 fout_line()/fout_entry()로 추가한 항목의 경계 기준
+ * PIPE_BUF 이하 단위로 나누어 쓰므로, 여러 스레드가 같은 fd에 동시에 내보내도
+ * 한 항목이 다른 스레드의 출력과 섞이지 않습니다. 그 외에는 write() 한 번으로
+ * 모두 내보냅니다.
+ *
+ * @param out 출력 버퍼
+ * @return 성공시 0, 쓰기 실패시 -1
+ */
+int fout_flush(find_out_t *out);
+
+/**
+ * 경로 사이의 구분자 설정 (탐색 시작 전에 한 번만 호출)
+ *
+ * @param term 각 경로 뒤에 붙일 문자
+ */
+void fout_set_terminator(char term);
+
+/**
+ * 검색 결과 항목을 만들 형식 함수 설정 (탐색 시작 전에 한 번만 호출)
+ *
+ * @param format 형식 함수
+ * @param ctx format에 전달할 값
+ */
+void fout_set_format(find_out_format_t format, void *ctx);
+
+/**
+ * 파일 디스크립터가 지정된 모든 버퍼의 내용을 write() 대신 sink로 보냄
+ * (탐색 시작 전에 한 번만 호출)
+ *
+ * @param sink 내용을 받을 함수
+ * @param ctx sink에 전달할 값
+ * @param per_entry 1이면 FIND_OUT_FLUSH_AT까지 모으지 않고 항목 하나마다 sink로 보냄
+ */
+void fout_set_sink(find_out_sink_t sink, void *ctx, int per_entry);
+
+/**
+ * 쌓인 내용을 내보내고, sink가 있으면 지금까지 받은 것을 처리하도록 알림
+ * (감시 모드처럼 끝나지 않는 검색에서 결과를 모아 두지 않게 함)
+ *
+ * @param out 출력 버퍼
+ * @return 성공시 0, 쓰기 실패시 -1
+ */
+int fout_commit(find_out_t *out);
+
+/**
+ * 남은 내용을 내보내고 버퍼 메모리 해제
+ *
+ * @param out 해제할 버퍼
+ */
+void fout_free(find_out_t *out);
+
+#endif /* FIND_OUTPUT_H */
@@ -0,0 +1,450 @@
+/*
+ * find_plan.c - find 검색 조건 실행 계획 모듈
+ *
+ * 옵션 문자열을 해석하는 함수들과, 이를 이용해 실행 계획을 만들고
+ * 파일마다 조건을 검사하는 기능을 제공합니다.
+ */
+
+#include "find_plan.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <pwd.h>
+#include <limits.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/** 하루의 나노초 수 */
+#define NS_PER_DAY (24LL * 60 * 60 * 1000000000)
+
+/** 1분의 나노초 수 */
+#define NS_PER_MINUTE (60LL * 1000000000)
+
+/**
+ * 크기 문자열을 바이트 단위로 파싱
+ *
+ * @param size_spec 크기 문자열 (예: "100", "+1k", "-5M")
+ *                  접두어: +는 보다 큰, -는 보다 작은
+ *                  접미어: k/K(킬로바이트), M(메가바이트), G(기가바이트)
+ * @return 파싱된 바이트 크기, 실패시 -1
+ */
+long parse_size_spec(const char *size_spec) {
+    if (!size_spec) return -1;
+
+    // +/- 접두어를 건너뛰고 숫자 부분 파싱
+    char *endptr;
+    long size = strtol(size_spec + (size_spec[0] == '+' || size_spec[0] == '-' ? 1 : 0), &endptr, 10);
+
+    // 단위 접미어 처리
+    if (*endptr == 'k' || *endptr == 'K') {
+        size *= 1024;  // 킬로바이트
+    } else if (*endptr == 'M') {
+        size *= 1024 * 1024;  // 메가바이트
+    } else if (*endptr == 'G') {
+        size *= 1024 * 1024 * 1024;  // 기가바이트
+    }
+
+    return size;
+}
+
+/**
+ * 권한 문자열을 8진수 모드로 변환
+ *
+ * @param perm_spec 8진수 권한 문자열 (예: "755", "644")
+ * @return 변환된 mode_t 값
+ */
+mode_t parse_perm_spec(const char *perm_spec) {
+    if (!perm_spec) return 0;
+
+    // 8진수 문자열을 mode_t로 변환
+    return (mode_t)strtol(perm_spec, NULL, 8);
+}
+
+/**
+ * 사용자 이름으로부터 UID 획득
+ *
+ * @param username 사용자 이름
+ * @return 해당하는 UID, 실패시 (uid_t)-1
+ */
+uid_t get_uid_by_name(const char *username) {
+    struct passwd pwd_buf;
+    struct passwd *pwd = NULL;
+    char buf[4096];
+    // 패스워드 데이터베이스에서 사용자 정보 검색
+    // (재진입 가능한 getpwnam_r 사용)
+    if (getpwnam_r(username, &pwd_buf, buf, sizeof(buf), &pwd) != 0) {
+        return (uid_t)-1;
+    }
+    return pwd ? pwd->pw_uid : (uid_t)-1;
+}
+
+/**
+ * 파일이나 디렉토리가 비어있는지 확인
+ *
+ * @param path 파일/디렉토리 경로
+ * @param st 파일 상태 정보 구조체
+ * @return 비어있으면 true, 아니면 false
+ */
+bool is_empty(const char *path, const struct stat *st) {
+    return is_empty_at(AT_FDCWD, path, st);
+}
+
+/**
+ * 디렉토리 fd 기준 상대 경로로 비어있는지 확인
+ *
+ * @param dirfd 기준 디렉토리 fd (AT_FDCWD면 현재 디렉토리)
+ * @param name dirfd 기준 경로
+ * @param st 파일 상태 정보 구조체
+ * @return 비어있으면 true, 아니면 false
+ */
+bool is_empty_at(int dirfd, const char *name, const struct stat *st) {
+    if (S_ISREG(st->st_mode)) {
+        // 일반 파일의 경우: 크기가 0이면 빈 파일
+        return st->st_size == 0;
+    } else if (S_ISDIR(st->st_mode)) {
+        // 디렉토리의 경우: 하위 항목이 없으면 빈 디렉토리
+        int fd = openat(dirfd, name, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd < 0) return false;
+        DIR *dir = fdopendir(fd);
+        if (!dir) {
+            close(fd);
+            return false;
+        }
+
+        struct dirent *entry;
+        int count = 0;
+
+        // 디렉토리 내용을 읽어서 실제 파일/디렉토리가 있는지 확인
+        while ((entry = readdir(dir)) != NULL) {
+            // "."과 ".." 제외하고 실제 항목이 있는지 확인
+            if (strcmp(entry->d_name, ".") != 0 && strcmp(entry->d_name, "..") != 0) {
+                count++;
+                break;  // 하나라도 있으면 빈 디렉토리가 아님
+            }
+        }
+        closedir(dir);
+        return count == 0;
+    }
+    return false;
+}
+
+/**
+ * 넘치면 최댓값/최솟값으로 고정하는 덧셈, 곱셈 (먼 과거/미래의 시각 계산용)
+ */
+static long long add_sat(long long a, long long b) {
+    long long r;
+    return __builtin_add_overflow(a, b, &r) ? (b > 0 ? LLONG_MAX : LLONG_MIN) : r;
+}
+
+static long long mul_sat(long long a, long long b) {
+    long long r;
+    return __builtin_mul_overflow(a, b, &r) ? ((a < 0) != (b < 0) ? LLONG_MIN : LLONG_MAX) : r;
+}
+
+/**
+ * 경과 단위 수(나노초 차이를 unit 단위로 버림 나눗셈한 값)가 n 이상이 되는
+ * 가장 작은 나노초 차이를 구하는 내부 함수
+ */
+static long long first_ns_of(long long n, long long unit) {
+    return n >= 1 ? mul_sat(n, unit) : add_sat(mul_sat(n - 1, unit), 1);
+}
+
+/**
+ * 경과 단위 수가 n 이하가 되는 가장 큰 나노초 차이를 구하는 내부 함수
+ */
+static long long last_ns_of(long long n, long long unit) {
+    return n >= 0 ? add_sat(mul_sat(n + 1, unit), -1) : mul_sat(n, unit);
+}
+
+/**
+ * 경과 시간 조건("현재 - 시각"을 unit 단위로 센 값)을 시각의 범위로 바꾸는 내부 함수
+ * (+n: n보다 큼, -n: n보다 작음, n: 정확히 n)
+ */
+static void age_to_range(long long now, char prefix, long long n, long long unit, find_time_range_t *range) {
+    range->min = LLONG_MIN;
+    range->max = LLONG_MAX;
+    if (prefix == '+') {
+        range->max = add_sat(now, -first_ns_of(n + 1, unit));
+    } else if (prefix == '-') {
+        range->min = add_sat(now, -last_ns_of(n - 1, unit));
+    } else {
+        range->min = add_sat(now, -last_ns_of(n, unit));
+        range->max = add_sat(now, -first_ns_of(n, unit));
+    }
+}
+
+/**
+ * 분 단위 경과 시간 조건을 시각의 범위로 바꾸는 내부 함수
+ * (GNU find의 -mmin과 같이 +n: n분 초과, -n: n분 미만, n: n-1분 초과 n분 이하)
+ */
+static void minutes_to_range(long long now, char prefix, long long n, find_time_range_t *range) {
+    long long age = mul_sat(n, NS_PER_MINUTE);
+    range->min = LLONG_MIN;
+    range->max = LLONG_MAX;
+    if (prefix == '+') {
+        range->max = add_sat(add_sat(now, -age), -1);
+    } else if (prefix == '-') {
+        range->min = add_sat(add_sat(now, -age), 1);
+    } else {
+        range->min = add_sat(now, -age);
+        range->max = add_sat(add_sat(now, -add_sat(age, -NS_PER_MINUTE)), -1);
+    }
+}
+
+/**
+ * 시각 종류의 허용 범위를 range와의 교집합으로 좁히는 내부 함수
+ */
+static void narrow_time(find_plan_t *plan, int field, const find_time_range_t *range) {
+    find_time_range_t *cur = &plan->times[field];
+    if (!(plan->time_mask & (1u << field))) {
+        *cur = *range;
+        plan->time_mask |= 1u << field;
+        return;
+    }
+    if (range->min > cur->min) cur->min = range->min;
+    if (range->max < cur->max) cur->max = range->max;
+}
+
+/**
+ * stat 정보의 시각을 1970년부터의 나노초로 바꾸는 내부 함수
+ */
+static inline long long timespec_ns(const struct timespec *ts) {
+    return (long long)ts->tv_sec * 1000000000LL + ts->tv_nsec;
+}
+
+/**
+ * 조건을 계획에 추가하는 내부 함수
+ */
+static void add_pred(find_plan_t *plan, find_pred_t pred) {
+    plan->preds[plan->pred_count++] = pred;
+}
+
+void compile_plan(const find_options_t *opts, find_plan_t *plan) {
+    memset(plan, 0, sizeof(find_plan_t));
+
+    // === 1단계: 타입 정보만 필요한 조건 ===
+    if (opts->type_file && opts->type_dir) {
+        plan->never = true;  // 파일이면서 디렉토리인 항목은 없음
+    } else if (opts->type_file || opts->type_dir) {
+        plan->type = opts->type_file ? S_IFREG : S_IFDIR;
+        add_pred(plan, PRED_TYPE);
+    }
+
+    // === 2단계: 이름만 필요한 조건 ===
+    if (opts->name_pattern) {
+        glob_compile(&plan->name_glob, opts->name_pattern, false);
+        add_pred(plan, PRED_NAME);
+    }
+    if (opts->iname_pattern) {
+        glob_compile(&plan->iname_glob, opts->iname_pattern, true);
+        add_pred(plan, PRED_INAME);
+    }
+
+    // === 3단계: stat 정보가 필요한 조건 (문자열 해석과 조회는 여기서 한 번만) ===
+    plan->stat_from = plan->pred_count;
+
+    if (opts->size_spec) {
+        long target_size = parse_size_spec(opts->size_spec);
+        if (target_size < 0) {
+            plan->never = true;  // 크기 파싱 실패
+        }
+        plan->size = (off_t)target_size;
+        plan->size_op = (opts->size_spec[0] == '+' || opts->size_spec[0] == '-') ? opts->size_spec[0] : '=';
+        add_pred(plan, PRED_SIZE);
+    }
+
+    if (opts->user_name) {
+        plan->uid = get_uid_by_name(opts->user_name);
+        if (plan->uid == (uid_t)-1) {
+            plan->never = true;  // 존재하지 않는 사용자
+        }
+        add_pred(plan, PRED_UID);
+    }
+
+    if (opts->perm_spec) {
+        plan->perm = parse_perm_spec(opts->perm_spec);
+        add_pred(plan, PRED_PERM);
+    }
+
+    if (opts->mtime_set || opts->time_count > 0) {
+        // 현재 시각은 여기서 한 번만 구하고, 모든 시각 조건을 종류별 범위 하나로 합침
+        struct timespec now_ts;
+        clock_gettime(CLOCK_REALTIME, &now_ts);
+        long long now = timespec_ns(&now_ts);
+        find_time_range_t range;
+
+        if (opts->mtime_set) {
+            // -t: "현재 시각 - 수정 시각"을 일 단위로 비교
+            age_to_range(now, opts->mtime_prefix, opts->mtime_days, NS_PER_DAY, &range);
+            narrow_time(plan, TIME_MTIME, &range);
+        }
+        for (int i = 0; i < opts->time_count; i++) {
+            const find_time_cond_t *cond = &opts->time_conds[i];
+            int field = cond->field == 'a' ? TIME_ATIME : cond->field == 'c' ? TIME_CTIME : TIME_MTIME;
+            if (cond->kind == TIME_AGE) {
+                minutes_to_range(now, cond->prefix, cond->value, &range);
+            } else if (cond->kind == TIME_AFTER) {
+                range.min = cond->value;
+                range.max = LLONG_MAX;
+            } else {
+                range.min = LLONG_MIN;
+                range.max = cond->value - 1;
+            }
+            narrow_time(plan, field, &range);
+        }
+        for (int field = 0; field < TIME_FIELDS; field++) {
+            if ((plan->time_mask & (1u << field)) && plan->times[field].min > plan->times[field].max) {
+                plan->never = true;  // 겹치지 않는 범위 (예: -after가 -before보다 나중)
+            }
+        }
+        add_pred(plan, PRED_TIME);
+    }
+
+    // === 4단계: 디렉토리를 열어야 할 수 있는 조건 ===
+    if (opts->empty_filter) {
+        add_pred(plan, PRED_EMPTY);
+    }
+
+    // === 5단계: 파일 내용을 읽어야 하는 조건 (다른 조건을 모두 통과한 파일만 읽음) ===
+    if (opts->content_literal || opts->content_regex) {
+        content_compile(&plan->content, opts->content_literal, opts->content_regex);
+        add_pred(plan, PRED_CONTENT);
+    }
+
+    plan->needs_stat = plan->stat_from < plan->pred_count;
+
+    // 탐색에서 제외할 디렉토리 패턴 (조건이 아니라 탐색 범위이므로 preds와 별도)
+    if (opts->prune_count > 0) {
+        plan->prunes = malloc(opts->prune_count * sizeof(find_glob_t));
+        if (!plan->prunes) {
+            fprintf(stderr, "find: 메모리 할당 실패\n");
+            exit(1);
+        }
+        for (int i = 0; i < opts->prune_count; i++) {
+            glob_compile(&plan->prunes[i], opts->prune_patterns[i], false);
+        }
+        plan->prune_count = opts->prune_count;
+    }
+}
+
+void free_plan(find_plan_t *plan) {
+    glob_free(&plan->name_glob);
+    glob_free(&plan->iname_glob);
+    content_free(&plan->content);
+    for (int i = 0; i < plan->prune_count; i++) {
+        glob_free(&plan->prunes[i]);
+    }
+    free(plan->prunes);
+}
+
+bool plan_matches(const find_plan_t *plan, const char *filepath, const char *filename, const struct stat *st) {
+    if (plan->never) {
+        return false;
+    }
+    return plan_match_name_type(plan, filename, strlen(filename), st->st_mode & S_IFMT) &&
+           plan_match_stat(plan, AT_FDCWD, filepath, st);
+}
+
+bool plan_match_name_type(const find_plan_t *plan, const char *filename, size_t name_len, mode_t type) {
+    for (int i = 0; i < plan->stat_from; i++) {
+        switch (plan->preds[i]) {
+            case PRED_TYPE:
+                if (type != plan->type) {
+                    return false;  // 찾는 타입이 아님
+                }
+                break;
+
+            case PRED_NAME:
+                if (!glob_match(&plan->name_glob, filename, name_len)) {
+                    return false;  // 이름 패턴이 일치하지 않음
+                }
+                break;
+
+            case PRED_INAME:
+                if (!glob_match(&plan->iname_glob, filename, name_len)) {
+                    return false;  // 이름 패턴이 일치하지 않음 (대소문자 무시)
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+    return true;
+}
+
+bool plan_prunes(const find_plan_t *plan, const char *name, size_t name_len) {
+    for (int i = 0; i < plan->prune_count; i++) {
+        if (glob_match(&plan->prunes[i], name, name_len)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool plan_match_stat(const find_plan_t *plan, int dirfd, const char *name, const struct stat *st) {
+    for (int i = plan->stat_from; i < plan->pred_count; i++) {
+        switch (plan->preds[i]) {
+            case PRED_SIZE:
+                if ((plan->size_op == '+' && st->st_size <= plan->size) ||
+                    (plan->size_op == '-' && st->st_size >= plan->size) ||
+                    (plan->size_op == '=' && st->st_size != plan->size)) {
+                    return false;  // 크기 조건 불일치
+                }
+                break;
+
+            case PRED_UID:
+                if (st->st_uid != plan->uid) {
+                    return false;  // 지정된 사용자의 파일이 아님
+                }
+                break;
+
+            case PRED_PERM:
+                // 파일 권한 부분만 비교 (하위 9비트: rwxrwxrwx)
+                if ((st->st_mode & 0777) != plan->perm) {
+                    return false;
+                }
+                break;
+
+            case PRED_TIME:
+                if (plan->time_mask & (1u << TIME_MTIME)) {
+                    long long t = timespec_ns(&st->st_mtim);
+                    if (t < plan->times[TIME_MTIME].min || t > plan->times[TIME_MTIME].max) {
+                        return false;  // 수정 시각 범위 밖
+                    }
+                }
+                if (plan->time_mask & (1u << TIME_ATIME)) {
+                    long long t = timespec_ns(&st->st_atim);
+                    if (t < plan->times[TIME_ATIME].min || t > plan->times[TIME_ATIME].max) {
+                        return false;  // 접근 시각 범위 밖
+                    }
+                }
+                if (plan->time_mask & (1u << TIME_CTIME)) {
+                    long long t = timespec_ns(&st->st_ctim);
+                    if (t < plan->times[TIME_CTIME].min || t > plan->times[TIME_CTIME].max) {
+                        return false;  // 상태 변경 시각 범위 밖
+                    }
+                }
+                break;
+
+            case PRED_EMPTY:
+                if (!is_empty_at(dirfd, name, st)) {
+                    return false;  // 빈 파일/디렉토리가 아님
+                }
+                break;
+
+            case PRED_CONTENT:
+                if (!content_match_at(&plan->content, dirfd, name, st)) {
+                    return false;  // 내용에 찾는 문자열/정규식이 없음
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    return true;  // 모든 조건에 부합
+}
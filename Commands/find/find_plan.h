@@ -0,0 +1,200 @@
+/*
+ * find_plan.h - find 검색 조건 실행 계획 선언
+ *
+ * 옵션 파싱이 끝난 뒤 find_options_t를 한 번만 해석하여 실행 계획으로
+ * 바꿉니다. 크기/권한 문자열 파싱, 사용자 이름 조회, 현재 시각 계산은
+ * 계획을 만들 때 한 번만 수행하고, 파일마다는 미리 계산된 값과 비교만 합니다.
+ * 시각 조건(-t, -newer, -mmin 등)은 시각 종류별로 하나의 나노초 범위로 합쳐서,
+ * 조건이 몇 개든 파일마다 시각 종류당 비교 두 번으로 끝납니다.
+ *
+ * 조건은 비용이 싼 순서로 정렬됩니다:
+ * 1. 파일 타입 (타입 정보만 필요)
+ * 2. 이름 패턴 (이름만 필요)
+ * 3. 크기/소유자/권한/시각 (stat 정보 필요)
+ * 4. 빈 파일/디렉토리 (디렉토리를 열어야 할 수 있음)
+ * 5. 파일 내용 (파일 전체를 읽어야 할 수 있음)
+ */
+
+#ifndef FIND_PLAN_H
+#define FIND_PLAN_H
+
+#include "find_options.h"
+#include "find_glob.h"
+#include "find_content.h"
+#include <stdbool.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+/** 실행 계획에 들어갈 수 있는 조건의 최대 수 */
+#define FIND_PLAN_MAX_PREDS 16
+
+/**
+ * 시각 종류 (find_plan_t.times의 번호)
+ */
+enum {
+    TIME_MTIME,     /**< 수정 시각 (st_mtim) */
+    TIME_ATIME,     /**< 접근 시각 (st_atim) */
+    TIME_CTIME,     /**< 상태 변경 시각 (st_ctim) */
+    TIME_FIELDS     /**< 시각 종류 수 */
+};
+
+/**
+ * 허용되는 시각 범위 (1970년부터 나노초, 양끝 포함)
+ */
+typedef struct {
+    long long min;          /**< 하한 */
+    long long max;          /**< 상한 */
+} find_time_range_t;
+
+/**
+ * 조건 종류 (비용이 싼 것부터 나열)
+ */
+typedef enum {
+    PRED_TYPE,      /**< 파일 타입 (-f, -d) */
+    PRED_NAME,      /**< 이름 패턴, 대소문자 구분 (-n) */
+    PRED_INAME,     /**< 이름 패턴, 대소문자 무시 (-i) */
+    PRED_SIZE,      /**< 파일 크기 (-s) */
+    PRED_UID,       /**< 소유자 (-u) */
+    PRED_PERM,      /**< 권한 (-p) */
+    PRED_TIME,      /**< 시각 (-t, -newer, -mmin, -amin, -cmin, -after, -before) */
+    PRED_EMPTY,     /**< 빈 파일/디렉토리 (-e) */
+    PRED_CONTENT    /**< 파일 내용 (-g, -G) */
+} find_pred_t;
+
+/**
+ * 미리 계산된 검색 조건 실행 계획
+ *
+ * compile_plan()으로 만든 뒤에는 바뀌지 않으므로
+ * 여러 작업 스레드가 잠금 없이 함께 사용할 수 있습니다.
+ */
+typedef struct {
+    find_pred_t preds[FIND_PLAN_MAX_PREDS]; /**< 검사할 조건들 (검사 순서대로) */
+    int pred_count;         /**< 조건 수 */
+    int stat_from;          /**< 이 번호의 조건부터 stat 정보가 필요 (pred_count면 필요 없음) */
+    bool needs_stat;        /**< stat 정보가 필요한 조건이 있는지 (stat_from < pred_count) */
+    bool never;             /**< 어떤 파일도 만족할 수 없는 조건 (-f와 -d 동시, 없는 사용자 등) */
+
+    mode_t type;            /**< 찾을 파일 타입 (S_IFREG 또는 S_IFDIR) */
+    find_glob_t name_glob;  /**< 컴파일된 -n 패턴 */
+    find_glob_t iname_glob; /**< 컴파일된 -i 패턴 (대소문자 무시) */
+    char size_op;           /**< 크기 비교: '+' (보다 큼), '-' (보다 작음), '=' (같음) */
+    off_t size;             /**< 비교할 크기 (바이트) */
+    uid_t uid;              /**< 찾을 소유자 UID */
+    mode_t perm;            /**< 찾을 권한 (하위 9비트) */
+    find_time_range_t times[TIME_FIELDS]; /**< 시각 종류별 허용 범위 (계획 생성 시 한 번 계산) */
+    unsigned time_mask;     /**< 검사할 시각 종류 (1 << TIME_MTIME 등) */
+    find_content_t content; /**< 컴파일된 내용 검색 조건 */
+    find_glob_t *prunes;    /**< 컴파일된 -prune 패턴들 (들어가지 않을 디렉토리 이름) */
+    int prune_count;        /**< prunes 개수 */
+} find_plan_t;
+
+/**
+ * 크기 문자열을 바이트 단위로 파싱
+ *
+ * @param size_spec 크기 문자열 (예: "100", "+1k", "-5M")
+ * @return 파싱된 바이트 크기, 실패시 -1
+ */
+long parse_size_spec(const char *size_spec);
+
+/**
+ * 권한 문자열을 8진수 모드로 변환
+ *
+ * @param perm_spec 8진수 권한 문자열 (예: "755", "644")
+ * @return 변환된 mode_t 값
+ */
+mode_t parse_perm_spec(const char *perm_spec);
+
+/**
+ * 사용자 이름으로부터 UID 획득
+ *
+ * @param username 사용자 이름
+ * @return 해당하는 UID, 실패시 (uid_t)-1
+ */
+uid_t get_uid_by_name(const char *username);
+
+/**
+ * 파일이나 디렉토리가 비어있는지 확인
+ *
+ * @param path 파일/디렉토리 경로
+ * @param st 파일 상태 정보 구조체
+ * @return 비어있으면 true, 아니면 false
+ */
+bool is_empty(const char *path, const struct stat *st);
+
+/**
+ * 디렉토리 fd 기준 상대 경로로 비어있는지 확인 (is_empty의 *at 버전)
+ *
+ * @param dirfd 기준 디렉토리 fd (AT_FDCWD면 현재 디렉토리)
+ * @param name dirfd 기준 경로
+ * @param st 파일 상태 정보 구조체
+ * @return 비어있으면 true, 아니면 false
+ */
+bool is_empty_at(int dirfd, const char *name, const struct stat *st);
+
+/**
+ * 옵션 구조체로부터 실행 계획 생성
+ *
+ * 계획은 opts의 패턴 문자열을 가리키므로 opts보다 먼저 해제되어야 합니다.
+ * 사용이 끝나면 free_plan()으로 해제합니다.
+ *
+ * @param opts 파싱이 끝난 옵션 구조체
+ * @param plan 결과를 저장할 실행 계획
+ */
+void compile_plan(const find_options_t *opts, find_plan_t *plan);
+
+/**
+ * 실행 계획이 가진 메모리 해제 (컴파일된 패턴)
+ *
+ * @param plan 해제할 실행 계획
+ */
+void free_plan(find_plan_t *plan);
+
+/**
+ * 파일이 실행 계획의 모든 조건에 맞는지 확인
+ *
+ * @param plan 실행 계획
+ * @param filepath 파일의 전체 경로
+ * @param filename 파일명만 (경로 제외)
+ * @param st 파일 상태 정보
+ * @return 조건에 맞으면 true, 아니면 false
+ */
+bool plan_matches(const find_plan_t *plan, const char *filepath, const char *filename, const struct stat *st);
+
+/**
+ * stat 없이 판단할 수 있는 앞부분 조건(타입, 이름)만 검사
+ *
+ * 디렉토리 항목의 d_type만으로 타입을 알 수 있으면 stat 호출 전에
+ * 대부분의 항목을 걸러낼 수 있습니다. plan->never는 검사하지 않습니다.
+ *
+ * @param plan 실행 계획
+ * @param filename 파일명
+ * @param name_len 파일명 길이
+ * @param type 파일 타입 (S_IFREG, S_IFDIR 등 S_IFMT 부분)
+ * @return 앞부분 조건에 맞으면 true
+ */
+bool plan_match_name_type(const find_plan_t *plan, const char *filename, size_t name_len, mode_t type);
+
+/**
+ * 디렉토리가 -prune 패턴에 맞아 건너뛰어야 하는지 확인
+ *
+ * 건너뛴 디렉토리는 열지도 출력하지도 않습니다.
+ *
+ * @param plan 실행 계획
+ * @param name 디렉토리 이름 (경로 제외)
+ * @param name_len 이름 길이
+ * @return 패턴 중 하나에 맞으면 true
+ */
+bool plan_prunes(const find_plan_t *plan, const char *name, size_t name_len);
+
+/**
+ * stat 정보가 필요한 뒷부분 조건만 검사
+ *
+ * @param plan 실행 계획
+ * @param dirfd 항목이 있는 디렉토리 fd (AT_FDCWD 가능)
+ * @param name dirfd 기준 경로 (-e에서 디렉토리를 열 때 사용)
+ * @param st 파일 상태 정보
+ * @return 뒷부분 조건에 맞으면 true
+ */
+bool plan_match_stat(const find_plan_t *plan, int dirfd, const char *name, const struct stat *st);
+
+#endif /* FIND_PLAN_H */
@@ -0,0 +1,766 @@
+/*
+ * find_walk.c - find 병렬 탐색 엔진
+ *
+ * 디렉토리마다 노드를 하나 만들고, 작업 스레드들이 작업 덱에서 노드를 꺼내
+ * 항목을 읽고 검색 조건을 검사합니다.
+ *
+ * 작업 덱:
+ * - 주인 스레드는 아래쪽(bottom)에서 넣고 꺼내므로 깊이 우선에 가깝게 진행되어
+ *   메모리 사용이 적습니다.
+ * - 일이 없는 스레드는 다른 덱의 위쪽(top)에서 훔쳐 오므로, 얕은 곳에 있는
+ *   큰 하위 트리가 다른 스레드로 넘어갑니다.
+ *
+ * 경로는 모두 필요한 길이만큼 힙에 할당하므로 PATH_MAX 제한이나 깊은 재귀로
+ * 인한 스택 증가가 없습니다.
+ */
+
+#include "find_walk.h"
+#include "find_output.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <fcntl.h>
+
+/**
+ * 디렉토리 노드의 상태
+ */
+enum {
+    NODE_PENDING,   /**< 아직 아무도 읽지 않음 */
+    NODE_SCANNING,  /**< 어떤 스레드가 읽는 중 */
+    NODE_DONE       /**< 읽기 완료 */
+};
+
+typedef struct find_node find_node_t;
+
+/**
+ * 순서 유지 모드에서 하위 디렉토리의 출력이 끼어들 위치
+ */
+typedef struct {
+    size_t offset;          /**< 부모 출력 버퍼에서 하위 디렉토리 출력이 들어갈 위치 */
+    find_node_t *child;     /**< 하위 디렉토리 노드 */
+} find_splice_t;
+
+/**
+ * 탐색할 디렉토리 하나를 나타내는 노드
+ */
+struct find_node {
+    char *path;                 /**< 디렉토리 경로 (힙 할당) */
+    size_t path_len;            /**< 경로 길이 */
+    int depth;                  /**< 시작 경로로부터의 깊이 (시작 경로는 0) */
+    atomic_int state;           /**< NODE_PENDING / NODE_SCANNING / NODE_DONE */
+    atomic_int refs;            /**< 참조 수 (작업 덱, 부모의 끼움 목록) */
+    int open_errno;             /**< 순서 유지 모드: 디렉토리를 열지 못한 이유 (0이면 성공) */
+    int ahead;                  /**< 순서 유지 모드: 작업 스레드가 미리 읽었으면 1 */
+    find_out_t out;             /**< 순서 유지 모드: 이 디렉토리 항목들의 출력 */
+    find_splice_t *splices;     /**< 순서 유지 모드: 하위 디렉토리 끼움 목록 */
+    int splice_count;           /**< 끼움 목록 길이 */
+    int splice_cap;             /**< 끼움 목록 용량 */
+};
+
+/**
+ * 스레드 하나의 작업 덱 (원형 버퍼)
+ */
+typedef struct {
+    pthread_mutex_t lock;
+    find_node_t **items;        /**< 노드 배열 (용량은 2의 거듭제곱) */
+    size_t cap;                 /**< 배열 용량 */
+    size_t top;                 /**< 다른 스레드가 훔쳐 가는 쪽 */
+    size_t bottom;              /**< 주인 스레드가 넣고 꺼내는 쪽 */
+} find_deque_t;
+
+typedef struct find_walk find_walk_t;
+
+/**
+ * 작업 스레드 하나의 상태
+ */
+typedef struct {
+    find_walk_t *walk;          /**< 공유 탐색 상태 */
+    int id;                     /**< 작업 덱 번호 (0은 메인 스레드) */
+    find_deque_t deque;         /**< 이 스레드의 작업 덱 */
+    find_out_t out;             /**< 비순서 모드: 이 스레드의 출력 버퍼 */
+    char *path_buf;             /**< 항목 경로를 만드는 작업 버퍼 */
+    size_t path_cap;            /**< 작업 버퍼 용량 */
+    find_node_t **children;     /**< 읽는 중인 디렉토리의 하위 디렉토리들 */
+    size_t child_count;         /**< 하위 디렉토리 수 */
+    size_t child_cap;           /**< 하위 디렉토리 배열 용량 */
+    pthread_t thread;           /**< 스레드 핸들 */
+    atomic_int started;         /**< 덱의 주인이 실행 중이면 1 (0번은 메인 스레드라 항상 1) */
+} find_worker_t;
+
+/**
+ * 모든 스레드가 공유하는 탐색 상태
+ */
+struct find_walk {
+    const find_options_t *opts; /**< 검색 옵션 */
+    const find_plan_t *plan;    /**< 검색 조건 실행 계획 (읽기 전용) */
+    find_dir_hook_t dir_hook;   /**< 디렉토리를 열 때마다 호출할 함수 (없으면 NULL) */
+    void *hook_ctx;             /**< dir_hook에 넘길 인자 */
+    int ordered;                /**< 순서 유지 모드 여부 */
+    dev_t root_dev;             /**< -xdev: 시작 경로의 장치 번호 */
+    find_worker_t *workers;     /**< 작업 스레드 배열 (0번은 메인 스레드) */
+    int slots;                  /**< 작업 덱 수 (작업 스레드 시작 후에는 바뀌지 않음) */
+    int threads;                /**< 실제로 시작된 작업 스레드 수 (메인 스레드만 읽고 씀) */
+    atomic_int finished;        /**< 탐색이 끝났으면 1 */
+    atomic_long pending;        /**< 비순서 모드: 아직 끝나지 않은 노드 수 */
+    atomic_long ahead;          /**< 순서 유지 모드: 미리 읽고 아직 출력하지 않은 노드 수 */
+    int idle;                   /**< 일을 기다리는 스레드 수 (idle_lock으로 보호) */
+    atomic_int had_error;       /**< 열지 못한 경로가 있었으면 1 */
+    pthread_mutex_t idle_lock;  /**< 일을 기다리는 스레드용 */
+    pthread_cond_t idle_cond;
+    pthread_mutex_t done_lock;  /**< 노드 읽기 완료를 기다리는 메인 스레드용 */
+    pthread_cond_t done_cond;
+};
+
+/**
+ * 메모리 할당 실패 시 종료하는 malloc/realloc 래퍼
+ */
+static void *xrealloc(void *ptr, size_t size) {
+    void *result = realloc(ptr, size);
+    if (!result) {
+        fprintf(stderr, "find: 메모리 할당 실패\n");
+        exit(1);
+    }
+    return result;
+}
+
+/**
+ * 새 디렉토리 노드 생성
+ *
+ * @param path 디렉토리 경로
+ * @param len 경로 길이
+ * @return 참조 수 1인 노드
+ */
+static find_node_t *node_new(const char *path, size_t len) {
+    find_node_t *node = xrealloc(NULL, sizeof(find_node_t));
+    memset(node, 0, sizeof(find_node_t));
+    node->path = xrealloc(NULL, len + 1);
+    memcpy(node->path, path, len + 1);
+    node->path_len = len;
+    atomic_init(&node->state, NODE_PENDING);
+    atomic_init(&node->refs, 1);
+    return node;
+}
+
+/**
+ * 노드의 출력 데이터와 끼움 목록 해제 (출력이 끝난 뒤 호출)
+ */
+static void node_clear(find_node_t *node) {
+    free(node->out.data);
+    free(node->splices);
+    node->out.data = NULL;
+    node->out.len = node->out.cap = 0;
+    node->splices = NULL;
+    node->splice_count = node->splice_cap = 0;
+}
+
+/**
+ * 노드 참조 해제 (마지막 참조였으면 메모리 해제)
+ */
+static void node_release(find_node_t *node) {
+    if (atomic_fetch_sub(&node->refs, 1) == 1) {
+        node_clear(node);
+        free(node->path);
+        free(node);
+    }
+}
+
+/**
+ * 작업 덱 초기화
+ */
+static void deque_init(find_deque_t *deque) {
+    pthread_mutex_init(&deque->lock, NULL);
+    deque->cap = FIND_DEQUE_INIT_CAP;
+    deque->items = xrealloc(NULL, deque->cap * sizeof(find_node_t *));
+    deque->top = deque->bottom = 0;
+}
+
+/**
+ * 주인 스레드가 덱 아래쪽에 노드를 넣음 (가득 차면 두 배로 키움)
+ */
+static void deque_push(find_deque_t *deque, find_node_t *node) {
+    pthread_mutex_lock(&deque->lock);
+    if (deque->bottom - deque->top == deque->cap) {
+        size_t new_cap = deque->cap * 2;
+        find_node_t **grown = xrealloc(NULL, new_cap * sizeof(find_node_t *));
+        for (size_t i = deque->top; i != deque->bottom; i++) {
+            grown[i & (new_cap - 1)] = deque->items[i & (deque->cap - 1)];
+        }
+        free(deque->items);
+        deque->items = grown;
+        deque->cap = new_cap;
+    }
+    deque->items[deque->bottom & (deque->cap - 1)] = node;
+    deque->bottom++;
+    pthread_mutex_unlock(&deque->lock);
+}
+
+/**
+ * 주인 스레드가 덱 아래쪽(가장 최근에 넣은 것)에서 노드를 꺼냄
+ *
+ * @return 꺼낸 노드, 비었으면 NULL
+ */
+static find_node_t *deque_pop(find_deque_t *deque) {
+    find_node_t *node = NULL;
+    pthread_mutex_lock(&deque->lock);
+    if (deque->bottom != deque->top) {
+        deque->bottom--;
+        node = deque->items[deque->bottom & (deque->cap - 1)];
+    }
+    pthread_mutex_unlock(&deque->lock);
+    return node;
+}
+
+/**
+ * 다른 스레드가 덱 위쪽(가장 오래된 것)에서 노드를 훔쳐 옴
+ *
+ * @return 훔친 노드, 비었으면 NULL
+ */
+static find_node_t *deque_steal(find_deque_t *deque) {
+    find_node_t *node = NULL;
+    pthread_mutex_lock(&deque->lock);
+    if (deque->bottom != deque->top) {
+        node = deque->items[deque->top & (deque->cap - 1)];
+        deque->top++;
+    }
+    pthread_mutex_unlock(&deque->lock);
+    return node;
+}
+
+/**
+ * 일을 기다리는 스레드를 깨움
+ * 상태(덱, finished, ahead)를 바꾼 뒤에 호출하며, idle_lock을 잡고 대기 스레드 수를 보므로
+ * 대기 스레드가 상태를 확인한 뒤 잠들기 직전의 신호도 놓치지 않음
+ *
+ * @param count 깨울 스레드 수 (음수면 모두)
+ */
+static void wake_idle(find_walk_t *walk, long count) {
+    pthread_mutex_lock(&walk->idle_lock);
+    if (count < 0 || count >= walk->idle) {
+        if (walk->idle > 0) {
+            pthread_cond_broadcast(&walk->idle_cond);
+        }
+    } else {
+        for (long i = 0; i < count; i++) {
+            pthread_cond_signal(&walk->idle_cond);
+        }
+    }
+    pthread_mutex_unlock(&walk->idle_lock);
+}
+
+/**
+ * 가져갈 수 있는 일이 있는지 확인 (idle_lock을 잡은 상태에서 호출)
+ * 순서 유지 모드에서 너무 앞서 읽었으면 일이 있어도 없는 것으로 봄
+ */
+static int work_ready(find_walk_t *walk) {
+    if (walk->ordered && atomic_load(&walk->ahead) >= FIND_WALK_AHEAD_LIMIT) {
+        return 0;
+    }
+    for (int i = 0; i < walk->slots; i++) {
+        find_deque_t *deque = &walk->workers[i].deque;
+        if (!atomic_load(&walk->workers[i].started)) {
+            continue;
+        }
+        pthread_mutex_lock(&deque->lock);
+        int empty = deque->bottom == deque->top;
+        pthread_mutex_unlock(&deque->lock);
+        if (!empty) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * 새 일이 생기거나 탐색이 끝날 때까지 대기
+ * 잠들기 전에 idle_lock을 잡은 채로 다시 확인하므로 깨우는 신호를 놓치지 않음
+ */
+static void wait_idle(find_walk_t *walk) {
+    pthread_mutex_lock(&walk->idle_lock);
+    walk->idle++;
+    while (!atomic_load(&walk->finished) && !work_ready(walk)) {
+        pthread_cond_wait(&walk->idle_cond, &walk->idle_lock);
+    }
+    walk->idle--;
+    pthread_mutex_unlock(&walk->idle_lock);
+}
+
+/**
+ * 디렉토리 경로 뒤에 항목 이름을 붙인 경로를 작업 버퍼에 만듦
+ *
+ * @return 만들어진 경로 (다음 호출 전까지 유효)
+ */
+static char *build_path(find_worker_t *self, const find_node_t *node, const char *name, size_t name_len) {
+    size_t need = node->path_len + name_len + 2;
+    if (need > self->path_cap) {
+        self->path_cap = need * 2;
+        self->path_buf = xrealloc(self->path_buf, self->path_cap);
+    }
+    memcpy(self->path_buf, node->path, node->path_len);
+    self->path_buf[node->path_len] = '/';
+    memcpy(self->path_buf + node->path_len + 1, name, name_len + 1);
+    return self->path_buf;
+}
+
+/**
+ * 순서 유지 모드에서 부모 출력의 현재 위치에 하위 디렉토리를 끼움
+ */
+static void add_splice(find_node_t *node, find_node_t *child) {
+    if (node->splice_count == node->splice_cap) {
+        node->splice_cap = node->splice_cap ? node->splice_cap * 2 : 8;
+        node->splices = xrealloc(node->splices, node->splice_cap * sizeof(find_splice_t));
+    }
+    node->splices[node->splice_count].offset = node->out.len;
+    node->splices[node->splice_count].child = child;
+    node->splice_count++;
+}
+
+/**
+ * 디렉토리 항목의 d_type을 stat의 파일 타입(S_IFMT 부분)으로 변환
+ *
+ * @return 파일 타입, 파일시스템이 타입을 알려주지 않으면 0
+ */
+static mode_t dtype_to_mode(unsigned char d_type) {
+    switch (d_type) {
+        case DT_REG:  return S_IFREG;
+        case DT_DIR:  return S_IFDIR;
+        case DT_LNK:  return S_IFLNK;
+        case DT_FIFO: return S_IFIFO;
+        case DT_SOCK: return S_IFSOCK;
+        case DT_CHR:  return S_IFCHR;
+        case DT_BLK:  return S_IFBLK;
+        default:      return 0;  // DT_UNKNOWN
+    }
+}
+
+/**
+ * 디렉토리 노드 하나를 읽어 조건에 맞는 항목을 출력하고
+ * 하위 디렉토리를 새 노드로 만들어 작업 덱에 넣음
+ *
+ * 항목은 디렉토리 fd 기준 fstatat으로 조회하여 경로 전체를 다시 해석하지 않으며,
+ * d_type으로 타입을 알 수 있고 stat이 필요한 조건이 없으면 stat을 생략합니다.
+ * (예: -n '*.log' -f는 stat 없이 readdir 결과만으로 판단)
+ *
+ * @param self 읽는 스레드
+ * @param node 읽을 디렉토리 노드
+ */
+static void scan_node(find_worker_t *self, find_node_t *node) {
+    find_walk_t *walk = self->walk;
+    const find_plan_t *plan = walk->plan;
+    struct dirent *entry;
+    struct stat st;
+
+    int fd = open(node->path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    DIR *dir = fd >= 0 ? fdopendir(fd) : NULL;
+    if (!dir) {
+        int err = errno;
+        if (fd >= 0) {
+            close(fd);
+        }
+        atomic_store(&walk->had_error, 1);
+        if (walk->ordered) {
+            node->open_errno = err;  // 출력 순서에 맞춰 메인 스레드가 보고
+        } else {
+            fprintf(stderr, "%s: %s\n", node->path, strerror(err));
+        }
+        return;
+    }
+
+    // 감시 모드: 항목을 읽기 전에 알려서, 읽는 도중 생긴 항목도 이벤트로 받게 함
+    if (walk->dir_hook) {
+        walk->dir_hook(walk->hook_ctx, node->path);
+    }
+
+    self->child_count = 0;
+    while ((entry = readdir(dir)) != NULL) {
+        // 현재 디렉토리(.)와 상위 디렉토리(..) 건너뛰기
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+            continue;
+        }
+
+        size_t name_len = strlen(entry->d_name);
+        mode_t type = dtype_to_mode(entry->d_type);
+        int have_stat = 0;
+        int depth = node->depth + 1;
+
+        // d_type을 알 수 없는 파일시스템에서는 타입을 알기 위해 stat 필요
+        // (심볼릭 링크는 링크 자체 정보)
+        if (type == 0) {
+            if (fstatat(fd, entry->d_name, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+                continue;  // 파일 정보 획득 실패시 건너뛰기
+            }
+            type = st.st_mode & S_IFMT;
+            have_stat = 1;
+        }
+
+        // -prune 패턴에 맞는 디렉토리는 열지도 출력하지도 않음
+        int is_dir = type == S_IFDIR;
+        if (is_dir && plan->prune_count > 0 && plan_prunes(plan, entry->d_name, name_len)) {
+            continue;
+        }
+
+        // 타입과 이름으로 먼저 거르고, 통과한 항목만 필요할 때 stat
+        int matched = depth >= walk->opts->mindepth && !plan->never &&
+                      plan_match_name_type(plan, entry->d_name, name_len, type);
+        if (matched && plan->needs_stat) {
+            if (!have_stat) {
+                if (fstatat(fd, entry->d_name, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+                    continue;
+                }
+                have_stat = 1;
+            }
+            matched = plan_match_stat(plan, fd, entry->d_name, &st);
+        }
+
+        // 하위 디렉토리로 내려갈지 결정 (-maxdepth, -xdev)
+        int descend = is_dir && (walk->opts->maxdepth < 0 || depth < walk->opts->maxdepth);
+        if (descend && walk->opts->xdev) {
+            if (!have_stat) {
+                if (fstatat(fd, entry->d_name, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+                    continue;
+                }
+                have_stat = 1;
+            }
+            descend = st.st_dev == walk->root_dev;  // 마운트 지점 아래로는 내려가지 않음
+        }
+
+        if (!matched && !descend) {
+            continue;  // 출력도 탐색도 하지 않는 항목은 경로를 만들 필요 없음
+        }
+
+        char *filepath = build_path(self, node, entry->d_name, name_len);
+        size_t filepath_len = node->path_len + 1 + name_len;
+
+        // 검색 조건에 맞으면 출력
+        if (matched) {
+            if (walk->ordered) {
+                if (!node->out.data) {
+                    fout_init(&node->out, -1);  // 결과가 처음 생겼을 때만 버퍼 할당
+                }
+                fout_entry(&node->out, filepath, filepath_len, have_stat ? &st : NULL);
+            } else {
+                fout_entry(&self->out, filepath, filepath_len, have_stat ? &st : NULL);
+            }
+        }
+
+        // 하위 디렉토리는 새 노드로 만들어 나중에 (또는 다른 스레드가) 탐색
+        if (descend) {
+            find_node_t *child = node_new(filepath, filepath_len);
+            child->depth = depth;
+            if (walk->ordered) {
+                add_splice(node, child);
+            }
+            if (self->child_count == self->child_cap) {
+                self->child_cap = self->child_cap ? self->child_cap * 2 : 16;
+                self->children = xrealloc(self->children, self->child_cap * sizeof(find_node_t *));
+            }
+            self->children[self->child_count++] = child;
+        }
+    }
+    closedir(dir);
+
+    if (self->child_count == 0) {
+        return;
+    }
+
+    if (walk->ordered) {
+        // 작업 스레드가 없으면 메인 스레드가 출력하면서 직접 읽으므로 덱에 넣지 않음
+        // (작업 스레드가 읽는 중이면 작업 스레드가 있는 것이므로 threads를 볼 필요가 없음)
+        if (self->id == 0 && walk->threads == 0) {
+            return;
+        }
+        // 역순으로 넣어 덱 아래쪽에서 꺼낼 때 출력 순서(첫 번째 하위 디렉토리)부터 나오게 함
+        for (size_t i = self->child_count; i > 0; i--) {
+            find_node_t *child = self->children[i - 1];
+            atomic_fetch_add(&child->refs, 1);  // 작업 덱이 가진 참조
+            deque_push(&self->deque, child);
+        }
+    } else {
+        // 현재 노드가 끝나기 전에 더하므로 pending이 중간에 0이 되지 않음
+        atomic_fetch_add(&walk->pending, (long)self->child_count);
+        for (size_t i = 0; i < self->child_count; i++) {
+            deque_push(&self->deque, self->children[i]);
+        }
+    }
+    wake_idle(walk, (long)self->child_count);
+}
+
+/**
+ * 노드 읽기 완료를 표시하고 기다리는 메인 스레드를 깨움
+ */
+static void mark_done(find_walk_t *walk, find_node_t *node) {
+    pthread_mutex_lock(&walk->done_lock);
+    atomic_store(&node->state, NODE_DONE);
+    pthread_cond_broadcast(&walk->done_cond);
+    pthread_mutex_unlock(&walk->done_lock);
+}
+
+/**
+ * 자기 덱에서 일을 꺼내고, 없으면 다른 스레드의 덱에서 훔쳐 옴
+ *
+ * @return 처리할 노드, 일이 없으면 NULL
+ */
+static find_node_t *take_work(find_worker_t *self) {
+    find_walk_t *walk = self->walk;
+    find_node_t *node = deque_pop(&self->deque);
+
+    // 시작하지 못한 스레드의 덱은 항상 비어 있으므로 건너뜀
+    for (int k = 1; !node && k < walk->slots; k++) {
+        find_worker_t *victim = &walk->workers[(self->id + k) % walk->slots];
+        if (atomic_load(&victim->started)) {
+            node = deque_steal(&victim->deque);
+        }
+    }
+    return node;
+}
+
+/**
+ * 작업 스레드 본체
+ * 탐색이 끝날 때까지 덱에서 노드를 꺼내 읽음
+ */
+static void *worker_main(void *arg) {
+    find_worker_t *self = arg;
+    find_walk_t *walk = self->walk;
+
+    while (!atomic_load(&walk->finished)) {
+        // 순서 유지 모드에서 너무 앞서 읽었으면 메인 스레드가 출력할 때까지 쉼
+        if (walk->ordered && atomic_load(&walk->ahead) >= FIND_WALK_AHEAD_LIMIT) {
+            wait_idle(walk);
+            continue;
+        }
+
+        find_node_t *node = take_work(self);
+        if (!node) {
+            wait_idle(walk);
+            continue;
+        }
+
+        // 메인 스레드가 먼저 가져간 노드는 건너뜀
+        int expected = NODE_PENDING;
+        if (atomic_compare_exchange_strong(&node->state, &expected, NODE_SCANNING)) {
+            scan_node(self, node);
+            if (walk->ordered) {
+                node->ahead = 1;
+                atomic_fetch_add(&walk->ahead, 1);
+                mark_done(walk, node);
+            }
+        }
+
+        // 비순서 모드: 마지막 노드를 끝낸 스레드가 탐색 종료를 알림
+        if (!walk->ordered && atomic_fetch_sub(&walk->pending, 1) == 1) {
+            atomic_store(&walk->finished, 1);
+            wake_idle(walk, -1);
+        }
+        node_release(node);
+    }
+    return NULL;
+}
+
+/**
+ * 출력할 차례가 된 노드가 읽혀 있도록 보장
+ * 아직 아무도 가져가지 않았으면 메인 스레드가 직접 읽고,
+ * 다른 스레드가 읽는 중이면 끝날 때까지 기다림
+ */
+static void ensure_done(find_walk_t *walk, find_node_t *node) {
+    int expected = NODE_PENDING;
+    if (atomic_compare_exchange_strong(&node->state, &expected, NODE_SCANNING)) {
+        scan_node(&walk->workers[0], node);
+        atomic_store(&node->state, NODE_DONE);
+        return;
+    }
+
+    pthread_mutex_lock(&walk->done_lock);
+    while (atomic_load(&node->state) != NODE_DONE) {
+        pthread_cond_wait(&walk->done_cond, &walk->done_lock);
+    }
+    pthread_mutex_unlock(&walk->done_lock);
+}
+
+/**
+ * 디렉토리를 열지 못했으면 출력 순서에 맞춰 에러 보고
+ */
+static void report_open_error(find_out_t *out, const find_node_t *node) {
+    if (node->open_errno) {
+        fout_flush(out);  // 에러 메시지가 앞선 출력보다 먼저 나오지 않도록 비움
+        fprintf(stderr, "%s: %s\n", node->path, strerror(node->open_errno));
+    }
+}
+
+/**
+ * 순서 유지 모드의 출력 루프 (메인 스레드)
+ * 노드의 출력과 끼움 목록을 따라 기존 재귀 탐색과 같은 순서로 출력함
+ * 재귀 대신 명시적 스택을 사용하므로 깊은 트리에서도 스택이 늘어나지 않음
+ *
+ * @param walk 탐색 상태
+ * @param root 시작 디렉토리 노드
+ * @param out 표준 출력 버퍼
+ */
+static void print_ordered(find_walk_t *walk, find_node_t *root, find_out_t *out) {
+    typedef struct {
+        find_node_t *node;      // 출력 중인 노드
+        int next;               // 다음에 처리할 끼움 번호
+        size_t pos;             // 출력 버퍼에서 이미 내보낸 위치
+    } frame_t;
+
+    frame_t *stack = NULL;
+    size_t depth = 0, cap = 0;
+
+    ensure_done(walk, root);
+    report_open_error(out, root);
+    stack = xrealloc(NULL, (cap = 64) * sizeof(frame_t));
+    stack[depth++] = (frame_t){root, 0, 0};
+
+    while (depth > 0) {
+        frame_t *frame = &stack[depth - 1];
+        find_node_t *node = frame->node;
+
+        if (frame->next < node->splice_count) {
+            // 하위 디렉토리가 끼어들 위치까지 출력한 뒤 하위 디렉토리로 내려감
+            find_splice_t splice = node->splices[frame->next++];
+            if (splice.offset > frame->pos) {
+                fout_write(out, node->out.data + frame->pos, splice.offset - frame->pos);
+                frame->pos = splice.offset;
+            }
+
+            ensure_done(walk, splice.child);
+            report_open_error(out, splice.child);
+            if (depth == cap) {
+                stack = xrealloc(stack, (cap *= 2) * sizeof(frame_t));
+            }
+            stack[depth++] = (frame_t){splice.child, 0, 0};
+            continue;
+        }
+
+        // 남은 출력을 내보내고 노드 정리
+        if (node->out.len > frame->pos) {
+            fout_write(out, node->out.data + frame->pos, node->out.len - frame->pos);
+        }
+        if (node->ahead && atomic_fetch_sub(&walk->ahead, 1) <= FIND_WALK_AHEAD_LIMIT) {
+            wake_idle(walk, 1);  // 한도 아래로 내려왔으면 쉬고 있던 스레드 하나를 깨움
+        }
+        node_clear(node);
+        node_release(node);
+        depth--;
+    }
+    free(stack);
+}
+
+int find_walk(const find_options_t *opts, const find_plan_t *plan) {
+    return find_walk_hooked(opts, plan, NULL, NULL);
+}
+
+int find_walk_hooked(const find_options_t *opts, const find_plan_t *plan,
+                     find_dir_hook_t hook, void *hook_ctx) {
+    const char *path = opts->search_path;
+    find_walk_t walk;
+    find_out_t out;
+    struct stat st;
+
+    // 시작 경로 자체도 조건 검사 대상 (시작 경로는 심볼릭 링크를 따라감)
+    if (stat(path, &st) != 0) {
+        perror(path);
+        return 1;
+    }
+
+    memset(&walk, 0, sizeof(walk));
+    walk.opts = opts;
+    walk.plan = plan;
+    walk.dir_hook = hook;
+    walk.hook_ctx = hook_ctx;
+    walk.ordered = opts->ordered || opts->jobs <= 1;
+    walk.root_dev = st.st_dev;
+    pthread_mutex_init(&walk.idle_lock, NULL);
+    pthread_cond_init(&walk.idle_cond, NULL);
+    pthread_mutex_init(&walk.done_lock, NULL);
+    pthread_cond_init(&walk.done_cond, NULL);
+
+    // 순서 유지 모드: 메인 스레드는 출력 전담 + jobs개의 작업 스레드
+    // 비순서 모드: 메인 스레드도 작업 스레드 0번으로 참여 + (jobs - 1)개의 작업 스레드
+    int wanted = walk.ordered ? (opts->jobs > 1 ? opts->jobs : 0) : opts->jobs - 1;
+    walk.slots = wanted + 1;
+    walk.workers = xrealloc(NULL, walk.slots * sizeof(find_worker_t));
+    memset(walk.workers, 0, walk.slots * sizeof(find_worker_t));
+    for (int i = 0; i < walk.slots; i++) {
+        walk.workers[i].walk = &walk;
+        walk.workers[i].id = i;
+        atomic_init(&walk.workers[i].started, i == 0);
+        deque_init(&walk.workers[i].deque);
+        if (!walk.ordered) {
+            fout_init(&walk.workers[i].out, STDOUT_FILENO);
+            walk.workers[i].out.shared = walk.slots > 1;
+        }
+    }
+
+    // 비순서 모드에서는 메인 스레드의 출력 버퍼를 그대로 사용
+    if (walk.ordered) {
+        fout_init(&out, STDOUT_FILENO);
+    }
+    find_out_t *main_out = walk.ordered ? &out : &walk.workers[0].out;
+
+    const char *filename = strrchr(path, '/');
+    filename = filename ? filename + 1 : path;  // '/' 이후 부분, 없으면 전체
+    if (opts->mindepth == 0 && plan_matches(plan, path, filename, &st)) {
+        fout_entry(main_out, path, strlen(path), &st);
+    }
+
+    // -maxdepth 0이면 시작 경로만 검사
+    if (S_ISDIR(st.st_mode) && opts->maxdepth != 0) {
+        find_node_t *root = node_new(path, strlen(path));
+        if (!walk.ordered) {
+            atomic_store(&walk.pending, 1);
+            deque_push(&walk.workers[0].deque, root);
+        }
+
+        // 작업 스레드 실행 (생성에 실패하면 있는 스레드만으로 진행)
+        // 이미 시작된 스레드가 slots를 읽고 있으므로 slots는 바꾸지 않고 started로 표시
+        for (int i = 1; i < walk.slots; i++) {
+            if (pthread_create(&walk.workers[i].thread, NULL, worker_main, &walk.workers[i]) != 0) {
+                break;
+            }
+            atomic_store(&walk.workers[i].started, 1);
+            walk.threads++;
+        }
+
+        if (walk.ordered) {
+            print_ordered(&walk, root, &out);
+        } else {
+            worker_main(&walk.workers[0]);
+        }
+
+        atomic_store(&walk.finished, 1);
+        wake_idle(&walk, -1);
+        for (int i = 1; i <= walk.threads; i++) {
+            pthread_join(walk.workers[i].thread, NULL);
+        }
+    }
+
+    // 덱에 남은 참조(메인 스레드가 먼저 처리한 노드) 해제 및 정리
+    for (int i = 0; i < wanted + 1; i++) {
+        find_worker_t *worker = &walk.workers[i];
+        find_node_t *node;
+        while ((node = deque_pop(&worker->deque)) != NULL) {
+            node_release(node);
+        }
+        if (!walk.ordered) {
+            fout_free(&worker->out);
+        }
+        free(worker->deque.items);
+        pthread_mutex_destroy(&worker->deque.lock);
+        free(worker->path_buf);
+        free(worker->children);
+    }
+    if (walk.ordered) {
+        fout_free(&out);
+    }
+    free(walk.workers);
+    pthread_mutex_destroy(&walk.idle_lock);
+    pthread_cond_destroy(&walk.idle_cond);
+    pthread_mutex_destroy(&walk.done_lock);
+    pthread_cond_destroy(&walk.done_cond);
+
+    return atomic_load(&walk.had_error) ? 1 : 0;
+}
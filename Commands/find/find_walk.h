@@ -0,0 +1,62 @@
+/*
+ * find_walk.h - find 병렬 탐색 엔진 선언
+ *
+ * 디렉토리 하나를 작업 단위로 삼아 여러 작업 스레드가 동시에 탐색합니다.
+ * 각 스레드는 자신의 작업 덱(deque)을 가지며, 자기 덱이 비면 다른 스레드의
+ * 덱에서 작업을 훔쳐 옵니다(work stealing).
+ *
+ * 출력 방식:
+ * - 순서 유지 모드(-O, 또는 -j를 주지 않은 기본 실행): 메인 스레드가
+ *   기존 find와 같은 깊이 우선 순서로 결과를 출력하고, 작업 스레드는
+ *   앞으로 출력할 디렉토리를 미리 읽어 둡니다.
+ * - 비순서 모드(-j N): 각 스레드가 자신의 출력 버퍼에 결과를 모아
+ *   잠금 없이 바로 내보냅니다. 줄 단위로는 섞이지 않지만 순서는 정해지지 않습니다.
+ */
+
+#ifndef FIND_WALK_H
+#define FIND_WALK_H
+
+#include "find_options.h"
+#include "find_plan.h"
+
+/** 순서 유지 모드에서 출력되지 않은 채 미리 읽어 둘 수 있는 디렉토리 수 상한 */
+#define FIND_WALK_AHEAD_LIMIT 4096
+
+/** 작업 덱의 초기 용량 (2의 거듭제곱) */
+#define FIND_DEQUE_INIT_CAP 64
+
+/**
+ * 검색 경로에서 탐색을 수행하고 조건에 맞는 경로를 표준 출력에 출력
+ *
+ * 작업 스레드 수와 출력 순서는 opts->jobs, opts->ordered를 따릅니다.
+ *
+ * @param opts 검색 옵션
+ * @param plan compile_plan()으로 만든 검색 조건 실행 계획
+ * @return 모든 경로를 문제없이 탐색했으면 0, 열지 못한 경로가 있으면 1
+ */
+int find_walk(const find_options_t *opts, const find_plan_t *plan);
+
+/**
+ * 디렉토리를 열 때마다 호출되는 함수 형식
+ *
+ * 디렉토리를 연 직후, 항목을 읽기 전에 호출됩니다.
+ * 병렬 탐색에서는 여러 스레드에서 동시에 호출될 수 있습니다.
+ *
+ * @param ctx find_walk_hooked에 넘긴 인자
+ * @param path 열린 디렉토리 경로
+ */
+typedef void (*find_dir_hook_t)(void *ctx, const char *path);
+
+/**
+ * 디렉토리마다 hook을 호출하면서 탐색 (감시 모드에서 사용)
+ *
+ * @param opts 검색 옵션
+ * @param plan 검색 조건 실행 계획
+ * @param hook 디렉토리를 열 때마다 호출할 함수
+ * @param hook_ctx hook에 넘길 인자
+ * @return find_walk와 동일
+ */
+int find_walk_hooked(const find_options_t *opts, const find_plan_t *plan,
+                     find_dir_hook_t hook, void *hook_ctx);
+
+#endif /* FIND_WALK_H */
@@ -0,0 +1,269 @@
+/*
+ * find_watch.c - find 감시 모드 모듈
+ *
+ * inotify 감시 번호(wd)마다 디렉토리 경로를 기억해 두고,
+ * 이벤트의 (wd, 이름)으로 전체 경로를 만들어 검색 조건을 검사합니다.
+ *
+ * fanotify는 관리자 권한(CAP_SYS_ADMIN)이 필요하므로 일반 사용자도 쓸 수 있는
+ * inotify를 사용합니다.
+ */
+
+#include "find_watch.h"
+#include "find_walk.h"
+#include "find_output.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+
+/** 디렉토리마다 받을 이벤트 */
+#define WATCH_MASK (IN_CREATE | IN_MOVED_TO | IN_MOVED_FROM | IN_CLOSE_WRITE | \
+                    IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR)
+
+/**
+ * 감시 상태
+ */
+typedef struct {
+    int fd;                     /**< inotify 파일 디스크립터 */
+    pthread_mutex_t lock;       /**< 병렬 탐색 중 paths 보호 */
+    char **paths;               /**< wd → 디렉토리 경로 */
+    int path_cap;               /**< paths 배열 크기 */
+    int limit_warned;           /**< 감시 수 한도 경고를 이미 출력했으면 1 */
+    size_t root_len;            /**< 시작 경로 길이 (깊이 계산용) */
+} watch_state_t;
+
+/**
+ * 탐색 중 디렉토리를 열 때마다 호출되어 감시를 추가하는 함수
+ * 같은 디렉토리(inode)는 같은 wd를 돌려받으므로, 이름이 바뀐 디렉토리는 경로만 갱신됨
+ */
+static void add_watch(void *ctx, const char *path) {
+    watch_state_t *state = ctx;
+    int wd = inotify_add_watch(state->fd, path, WATCH_MASK);
+
+    pthread_mutex_lock(&state->lock);
+    if (wd < 0) {
+        if (errno == ENOSPC && !state->limit_warned) {
+            fprintf(stderr, "find: inotify 감시 수 한도에 도달했습니다 (fs.inotify.max_user_watches)\n");
+            state->limit_warned = 1;
+        }
+        pthread_mutex_unlock(&state->lock);
+        return;
+    }
+
+    if (wd >= state->path_cap) {
+        int new_cap = state->path_cap ? state->path_cap : 1024;
+        while (wd >= new_cap) {
+            new_cap *= 2;
+        }
+        char **grown = realloc(state->paths, new_cap * sizeof(char *));
+        if (!grown) {
+            fprintf(stderr, "find: 메모리 할당 실패\n");
+            exit(1);
+        }
+        memset(grown + state->path_cap, 0, (new_cap - state->path_cap) * sizeof(char *));
+        state->paths = grown;
+        state->path_cap = new_cap;
+    }
+    free(state->paths[wd]);
+    state->paths[wd] = strdup(path);
+    pthread_mutex_unlock(&state->lock);
+}
+
+/**
+ * 디렉토리와 그 아래 디렉토리들의 감시를 해제하는 함수
+ * 옮겨진 디렉토리에 사용함 (트리 밖으로 나갔으면 예전 경로가 남지 않고,
+ * 트리 안으로 옮겨졌으면 IN_MOVED_TO에서 새 경로로 다시 감시를 추가함)
+ */
+static void drop_watches(watch_state_t *state, const char *path) {
+    size_t len = strlen(path);
+
+    pthread_mutex_lock(&state->lock);
+    for (int wd = 0; wd < state->path_cap; wd++) {
+        char *watched = state->paths[wd];
+        if (watched && strncmp(watched, path, len) == 0 &&
+            (watched[len] == '\0' || watched[len] == '/')) {
+            inotify_rm_watch(state->fd, wd);  // 뒤따르는 IN_IGNORED는 경로가 없어 무시됨
+            free(watched);
+            state->paths[wd] = NULL;
+        }
+    }
+    pthread_mutex_unlock(&state->lock);
+}
+
+/**
+ * 새로 생긴 디렉토리 아래를 탐색 (조건에 맞으면 디렉토리 자신도 출력)
+ */
+static void walk_subtree(const find_options_t *opts, const find_plan_t *plan,
+                         watch_state_t *state, char *path, int depth) {
+    find_options_t sub = *opts;  // 시작 경로와 깊이 제한만 바꾼 얕은 복사본
+    sub.search_path = path;
+    sub.mindepth = opts->mindepth > depth ? opts->mindepth - depth : 0;
+    sub.maxdepth = opts->maxdepth < 0 ? -1 : opts->maxdepth - depth;
+    find_walk_hooked(&sub, plan, add_watch, state);
+}
+
+/**
+ * 감시 중인 디렉토리 경로의 시작 경로로부터의 깊이
+ * (탐색 엔진은 경로를 "부모/이름"으로 만들므로 시작 경로 뒤의 '/' 수와 같음)
+ */
+static int path_depth(const watch_state_t *state, const char *dir) {
+    int depth = 0;
+    for (const char *p = dir + state->root_len; *p; p++) {
+        if (*p == '/') {
+            depth++;
+        }
+    }
+    return depth;
+}
+
+/**
+ * inotify 이벤트 하나를 처리하는 내부 함수
+ */
+static void handle_event(const find_options_t *opts, const find_plan_t *plan,
+                         watch_state_t *state, find_out_t *out,
+                         const struct inotify_event *event) {
+    if (event->mask & IN_Q_OVERFLOW) {
+        fprintf(stderr, "find: 이벤트가 너무 많아 일부 변경을 놓쳤을 수 있습니다\n");
+        return;
+    }
+    if (event->wd < 0 || event->wd >= state->path_cap || !state->paths[event->wd]) {
+        return;
+    }
+
+    // 감시 중인 디렉토리 자신이 사라짐
+    if (event->mask & (IN_IGNORED | IN_DELETE_SELF)) {
+        if (event->mask & IN_IGNORED) {
+            free(state->paths[event->wd]);
+            state->paths[event->wd] = NULL;
+        }
+        return;
+    }
+
+    // 감시 중인 디렉토리 자신이 옮겨짐 (상위 디렉토리를 감시하지 않는 시작 경로 등)
+    if (event->mask & IN_MOVE_SELF) {
+        char *moved = strdup(state->paths[event->wd]);
+        if (moved) {
+            drop_watches(state, moved);
+            free(moved);
+        }
+        return;
+    }
+    if (event->len == 0) {
+        return;
+    }
+
+    // 전체 경로 구성 (부모경로/항목명)
+    const char *dir = state->paths[event->wd];
+    size_t dir_len = strlen(dir);
+    size_t name_len = strlen(event->name);
+    char *path = malloc(dir_len + name_len + 2);
+    if (!path) {
+        fprintf(stderr, "find: 메모리 할당 실패\n");
+        exit(1);
+    }
+    memcpy(path, dir, dir_len);
+    path[dir_len] = '/';
+    memcpy(path + dir_len + 1, event->name, name_len + 1);
+
+    // 다른 곳으로 옮겨진 디렉토리는 예전 경로의 감시를 해제
+    if (event->mask & IN_MOVED_FROM) {
+        if (event->mask & IN_ISDIR) {
+            drop_watches(state, path);
+        }
+        free(path);
+        return;
+    }
+
+    struct stat st;
+    int depth = path_depth(state, dir) + 1;
+    if (lstat(path, &st) != 0) {
+        free(path);
+        return;  // 이벤트를 처리하기 전에 이미 사라짐
+    }
+
+    if (S_ISDIR(st.st_mode)) {
+        // 새 디렉토리(또는 옮겨 온 디렉토리)는 안을 탐색하며 감시를 추가 (-prune 대상 제외)
+        if ((event->mask & (IN_CREATE | IN_MOVED_TO)) && !plan_prunes(plan, event->name, name_len)) {
+            fout_flush(out);  // 앞선 출력이 하위 탐색 출력보다 먼저 나가도록 비움
+            walk_subtree(opts, plan, state, path, depth);
+        }
+    } else if (depth >= opts->mindepth &&  // -mindepth보다 얕은 항목은 출력하지 않음
+               ((S_ISREG(st.st_mode) && (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))) ||
+                (S_ISREG(st.st_mode) && (event->mask & IN_CREATE) && st.st_nlink > 1) ||
+                (!S_ISREG(st.st_mode) && (event->mask & (IN_CREATE | IN_MOVED_TO))))) {
+        // 일반 파일은 쓰기가 끝난 뒤에 검사해야 크기 조건 등이 정확함
+        // 단, link()로 만든 하드링크는 IN_CLOSE_WRITE 없이 IN_CREATE만 오므로 바로 검사
+        if (plan_matches(plan, path, event->name, &st)) {
+            fout_entry(out, path, dir_len + 1 + name_len, &st);
+        }
+    }
+    free(path);
+}
+
+int find_watch(const find_options_t *opts, const find_plan_t *plan) {
+    watch_state_t state;
+    struct stat st;
+
+    if (stat(opts->search_path, &st) != 0) {
+        perror(opts->search_path);
+        return 1;
+    }
+    if (!S_ISDIR(st.st_mode)) {
+        fprintf(stderr, "find: %s: -W는 디렉토리에서만 사용할 수 있습니다\n", opts->search_path);
+        return 1;
+    }
+
+    memset(&state, 0, sizeof(state));
+    state.fd = inotify_init1(IN_CLOEXEC);
+    if (state.fd < 0) {
+        perror("find: inotify_init1");
+        return 1;
+    }
+    pthread_mutex_init(&state.lock, NULL);
+    state.root_len = strlen(opts->search_path);
+
+    // === 1단계: 처음 탐색 (디렉토리를 읽기 전에 감시를 걸어 틈이 없게 함) ===
+    find_walk_hooked(opts, plan, add_watch, &state);
+
+    // === 2단계: 이벤트 처리 ===
+    // 버퍼는 inotify_event 정렬을 맞춤
+    static char buf[FIND_WATCH_BUF_SIZE] __attribute__((aligned(__alignof__(struct inotify_event))));
+    find_out_t out;
+    fout_init(&out, STDOUT_FILENO);
+
+    for (;;) {
+        ssize_t len = read(state.fd, buf, sizeof(buf));
+        if (len < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            perror("find: inotify");
+            break;
+        }
+
+        for (char *p = buf; p < buf + len; ) {
+            const struct inotify_event *event = (const struct inotify_event *)p;
+            handle_event(opts, plan, &state, &out, event);
+            p += sizeof(struct inotify_event) + event->len;
+        }
+
+        // 한 번에 읽은 이벤트 묶음을 처리할 때마다 바로 내보냄
+        if (fout_commit(&out) != 0) {
+            break;  // 출력 파이프가 닫힘
+        }
+    }
+
+    fout_free(&out);
+    for (int i = 0; i < state.path_cap; i++) {
+        free(state.paths[i]);
+    }
+    free(state.paths);
+    pthread_mutex_destroy(&state.lock);
+    close(state.fd);
+    return 1;
+}
@@ -0,0 +1,35 @@
+/*
+ * find_watch.h - find 감시 모드 선언
+ *
+ * 처음에 한 번 탐색해 조건에 맞는 경로를 출력한 뒤, 트리의 모든 디렉토리를
+ * inotify로 감시하면서 새로 생기거나 바뀐 경로 중 조건에 맞는 것을
+ * 발생하는 즉시 출력합니다. 트리를 다시 훑지 않습니다.
+ *
+ * 보고하는 이벤트:
+ * - 일반 파일: 쓰기를 마치고 닫혔을 때(IN_CLOSE_WRITE), 다른 곳에서 옮겨 왔을 때(IN_MOVED_TO)
+ * - 그 외(디렉토리, 심볼릭 링크 등): 생성(IN_CREATE), 옮겨 옴(IN_MOVED_TO)
+ * 새 디렉토리가 생기면 그 안을 한 번 탐색하면서 감시를 추가하므로,
+ * 감시가 걸리기 전에 그 안에 만들어진 파일도 놓치지 않습니다.
+ */
+
+#ifndef FIND_WATCH_H
+#define FIND_WATCH_H
+
+#include "find_options.h"
+#include "find_plan.h"
+
+/** 이벤트를 읽는 버퍼 크기 */
+#define FIND_WATCH_BUF_SIZE (64 * 1024)
+
+/**
+ * 감시 모드 실행 (-W 옵션)
+ *
+ * 중단될 때(SIGINT 등)까지 반환하지 않으며, 출력은 이벤트 묶음마다 바로 내보냅니다.
+ *
+ * @param opts 검색 옵션
+ * @param plan 검색 조건 실행 계획
+ * @return 감시를 시작할 수 없으면 1
+ */
+int find_watch(const find_options_t *opts, const find_plan_t *plan);
+
+#endif /* FIND_WATCH_H */
@@ -1,42 +1,57 @@
 #include "ls_options.h"
+#include "ls_parallel.h"
+#include "ls_cache.h"
+#include "ls_du.h"
 
-// qsort용 비교 함수 래퍼
-// qsort는 옵션 정보를 전달받을 방법이 없어서 전역 변수 사용
-static ls_options_t *global_options = NULL;
+// 표준 출력용 버퍼 (모든 출력은 이 버퍼에 모였다가 write()로 한 번에 나감)
+static ls_out_t stdout_buf;
 
 /**
- * qsort 함수에서 사용하는 비교 함수 래퍼
- * qsort는 사용자 정의 데이터를 전달할 방법이 없어서
- * 전역 변수를 통해 옵션 정보를 compare_files 함수에 전달
+ * qsort_r 함수에서 사용하는 비교 함수 래퍼
+ * 옵션 정보를 인자로 직접 전달받으므로 전역 변수 없이
+ * 여러 스레드가 동시에 정렬해도 안전함
  */
-int qsort_compare_wrapper(const void *a, const void *b) {
-    return compare_files(a, b, global_options);
+int qsort_compare_wrapper(const void *a, const void *b, void *options) {
+    return compare_files(a, b, (ls_options_t *)options);
 }
 
 /**
- * 지정된 디렉토리의 내용을 나열하는 메인 함수
- * 파일 정보를 수집하고, 정렬하고, 옵션에 따라 출력
+ * 수집 중 발생한 에러 메시지를 listing의 에러 버퍼에 기록하는 내부 함수
+ * 에러는 바로 출력하지 않고, 목록을 출력할 때 원래 순서대로 함께 출력됨
  */
-void list_directory(const char *path, ls_options_t *options, int is_recursive) {
+static void record_error(dir_listing_t *listing, const char *prefix, const char *path, int err) {
+    if (!listing->errors.data) {
+        out_init(&listing->errors, -1);  // 에러가 처음 생겼을 때만 버퍼 할당
+    }
+    const char *msg = strerror(err);
+    out_write(&listing->errors, prefix, strlen(prefix));
+    out_write(&listing->errors, path, strlen(path));
+    out_write(&listing->errors, "': ", 3);
+    out_write(&listing->errors, msg, strlen(msg));
+    out_char(&listing->errors, '\n');
+}
+
+/**
+ * 디렉토리의 항목들을 읽고 stat 정보를 수집한 뒤 정렬하는 함수
+ * 출력은 하지 않으므로 작업 스레드에서 미리 호출할 수 있음
+ */
+int read_directory(const char *path, ls_options_t *options, dir_listing_t *listing) {
     DIR *dir;
     struct dirent *entry;
     file_info_t *files = NULL;  // 동적 배열로 파일 정보 저장
     int file_count = 0;         // 현재 저장된 파일 개수
     int capacity = 0;           // 배열의 현재 용량
-    
+    size_t path_len = strlen(path);  // 디렉토리 경로 길이 (경로 조합 시 재사용)
+
+    memset(listing, 0, sizeof(dir_listing_t));
+
     // 디렉토리 열기
     dir = opendir(path);
     if (!dir) {
-        fprintf(stderr, "ls: cannot access '%s': %s\n", path, strerror(errno));
-        return;
+        listing->open_errno = errno;
+        return -1;
     }
-    
-    // 재귀 호출 시에만 디렉토리 이름 출력
-    // 최초 호출 시에는 디렉토리명을 출력하지 않음
-    if (is_recursive) {
-        printf("\n%s:\n", path);
-    }
-    
+
     // === 1단계: 파일 정보 수집 ===
     // 디렉토리 내의 모든 항목을 순회하며 파일 정보 수집
     while ((entry = readdir(dir)) != NULL) {
@@ -44,83 +59,203 @@ void list_directory(const char *path, ls_options_t *options, int is_recursive) {
         if (!should_show_file(entry->d_name, options)) {
             continue;
         }
-        
+
         // 동적 배열 크기 확장 (필요시)
         if (file_count >= capacity) {
             capacity = capacity == 0 ? 10 : capacity * 2;  // 초기 10개, 이후 2배씩 증가
-            files = realloc(files, capacity * sizeof(file_info_t));
-            if (!files) {
+            file_info_t *grown = realloc(files, capacity * sizeof(file_info_t));
+            if (!grown) {
                 fprintf(stderr, "ls: memory allocation failed\n");
-                closedir(dir);
-                return;
+                break;  // 지금까지 수집한 항목만 출력
             }
+            files = grown;
         }
-        
+
         // 파일 정보 저장
-        files[file_count].name = strdup(entry->d_name);  // 파일명 복사
-        
+        size_t name_len = strlen(entry->d_name);  // 파일명 길이는 여기서 한 번만 계산
+        files[file_count].name = malloc(name_len + 1);
+        memcpy(files[file_count].name, entry->d_name, name_len + 1);  // 파일명 복사
+        files[file_count].name_len = name_len;
+        files[file_count].name_width = display_width(entry->d_name, name_len);
+
         // 전체 경로 생성 (디렉토리 경로 + "/" + 파일명)
-        files[file_count].path = malloc(strlen(path) + strlen(entry->d_name) + 2);
-        sprintf(files[file_count].path, "%s/%s", path, entry->d_name);
-        
+        files[file_count].path = malloc(path_len + name_len + 2);
+        memcpy(files[file_count].path, path, path_len);
+        files[file_count].path[path_len] = '/';
+        memcpy(files[file_count].path + path_len + 1, entry->d_name, name_len + 1);
+
         // 파일의 상세 정보 (stat) 수집
         if (stat(files[file_count].path, &files[file_count].stat_info) != 0) {
-            // stat 실패 시 에러 출력하고 해당 파일 제외
-            fprintf(stderr, "ls: cannot stat '%s': %s\n", 
-                    files[file_count].path, strerror(errno));
+            // stat 실패 시 에러를 기록하고 해당 파일 제외
+            record_error(listing, "ls: cannot stat '", files[file_count].path, errno);
             free(files[file_count].name);
             free(files[file_count].path);
             continue;  // 다음 파일로 계속
         }
-        
+
+        if (files[file_count].name_width > listing->max_name_width) {
+            listing->max_name_width = files[file_count].name_width;  // 열 배치용 최대 칸 수도 함께 갱신
+        }
         file_count++;
     }
-    
+
     closedir(dir);
-    
-    // 파일이 하나도 없으면 메모리 해제 후 종료
-    if (file_count == 0) {
-        free(files);
+
+    // === 2단계: 파일 정렬 ===
+    if (file_count > 0) {
+        qsort_r(files, file_count, sizeof(file_info_t), qsort_compare_wrapper, options);
+    }
+
+    listing->files = files;
+    listing->count = file_count;
+
+    // -S: 하위 디렉토리의 크기를 하위 트리 전체 합계로 바꿈
+    if (options->subtree_usage) {
+        compute_subtree_usage(listing, options);
+    }
+    return 0;
+}
+
+/**
+ * read_directory로 수집한 목록을 출력 버퍼에 출력하는 함수
+ * 직렬/병렬 모드 모두 이 함수로 출력하므로 출력 형식이 항상 동일함
+ */
+void print_listing(ls_out_t *out, const char *path, dir_listing_t *listing,
+                   ls_options_t *options, int is_recursive) {
+    // 디렉토리를 열지 못한 경우 에러만 출력
+    if (listing->open_errno) {
+        out_flush(out);  // 에러 메시지가 앞선 출력보다 먼저 나오지 않도록 비움
+        fprintf(stderr, "ls: cannot access '%s': %s\n", path, strerror(listing->open_errno));
         return;
     }
-    
-    // === 2단계: 파일 정렬 ===
-    // 전역 변수에 옵션 설정 후 qsort 실행
-    global_options = options;
-    qsort(files, file_count, sizeof(file_info_t), qsort_compare_wrapper);
-    
+
+    // 재귀 호출 시에만 디렉토리 이름 출력
+    // 최초 호출 시에는 디렉토리명을 출력하지 않음
+    if (is_recursive) {
+        out_char(out, '\n');
+        out_write(out, path, strlen(path));
+        out_write(out, ":\n", 2);
+    }
+
+    // 수집 중 발생한 stat 에러 출력
+    if (listing->errors.len > 0) {
+        out_flush(out);
+        fwrite(listing->errors.data, 1, listing->errors.len, stderr);
+    }
+
+    // 파일이 하나도 없으면 종료
+    if (listing->count == 0) {
+        return;
+    }
+
     // === 3단계: 헤더 정보 출력 ===
     // long format에서는 총 블록 수를 먼저 출력
     if (options->long_format) {
         long total_blocks = 0;
-        for (int i = 0; i < file_count; i++) {
-            total_blocks += files[i].stat_info.st_blocks;
+        for (int i = 0; i < listing->count; i++) {
+            total_blocks += listing->files[i].stat_info.st_blocks;
         }
-        printf("total %ld\n", total_blocks / 2); // 512바이트 블록을 1K 블록으로 변환
+        out_write(out, "total ", 6);
+        out_int(out, total_blocks / 2, 0);  // 512바이트 블록을 1K 블록으로 변환
+        out_char(out, '\n');
     }
-    
+
     // === 4단계: 파일 정보 출력 ===
-    // 정렬된 순서대로 각 파일의 정보를 출력
-    for (int i = 0; i < file_count; i++) {
-        print_file_info(&files[i], options);
+    // 열 배치 모드에서는 여러 열로, 그 외에는 정렬된 순서대로 한 줄씩 출력
+    if (options->grid) {
+        print_grid(out, listing, options);
+        return;
     }
-    
+    for (int i = 0; i < listing->count; i++) {
+        print_file_info(out, &listing->files[i], options);
+    }
+}
+
+/**
+ * 목록 구조체가 가진 모든 메모리를 해제하는 함수
+ */
+void free_listing(dir_listing_t *listing) {
+    free_file_info_array(listing->files, listing->count);
+    if (listing->errors.data) {
+        free(listing->errors.data);
+    }
+    memset(listing, 0, sizeof(dir_listing_t));
+}
+
+/**
+ * 재귀 탐색 대상이 되는 하위 디렉토리인지 확인하는 함수
+ * 현재/상위 디렉토리(., ..)는 제외
+ */
+int is_recursion_target(const file_info_t *file) {
+    return S_ISDIR(file->stat_info.st_mode) &&
+           strcmp(file->name, ".") != 0 &&
+           strcmp(file->name, "..") != 0;
+}
+
+/**
+ * 지정된 디렉토리의 내용을 나열하는 메인 함수
+ * 파일 정보를 수집하고, 정렬하고, 옵션에 따라 출력
+ */
+void list_directory(const char *path, ls_options_t *options, int is_recursive) {
+    dir_listing_t listing;
+
+    // === 1~2단계: 파일 정보 수집 및 정렬 ===
+    read_directory(path, options, &listing);
+
+    // === 3~4단계: 헤더 및 파일 정보 출력 ===
+    print_listing(&stdout_buf, path, &listing, options, is_recursive);
+
     // === 5단계: 재귀 처리 ===
     // 재귀 옵션이 설정된 경우, 하위 디렉토리들을 재귀적으로 처리
     if (options->recursive) {
-        for (int i = 0; i < file_count; i++) {
-            // 디렉토리이면서 현재/상위 디렉토리가 아닌 경우만 재귀 호출
-            if (S_ISDIR(files[i].stat_info.st_mode) && 
-                strcmp(files[i].name, ".") != 0 && 
-                strcmp(files[i].name, "..") != 0) {
-                list_directory(files[i].path, options, 1);  // is_recursive=1로 호출
+        for (int i = 0; i < listing.count; i++) {
+            if (is_recursion_target(&listing.files[i])) {
+                list_directory(listing.files[i].path, options, 1);  // is_recursive=1로 호출
             }
         }
     }
-    
+
     // === 6단계: 메모리 정리 ===
     // 동적으로 할당된 모든 메모리 해제
-    free_file_info_array(files, file_count);
+    free_listing(&listing);
+}
+
+/**
+ * 캐시를 사용해 디렉토리를 나열하는 함수 (-k 옵션, -R이 아닐 때)
+ * 디렉토리의 mtime이 캐시와 같으면 stat 한 번으로 저장된 출력을 재생하고,
+ * 달라졌으면 다시 읽어서 출력한 뒤 캐시를 갱신함
+ * 주의: 파일 내용이나 속성만 바뀌면 디렉토리 mtime이 변하지 않으므로
+ *       -l의 크기/시간 등은 디렉토리가 바뀔 때까지 이전 값이 표시될 수 있음
+ */
+static void list_directory_cached(const char *path, ls_options_t *options) {
+    struct stat dir_st;
+    dir_listing_t listing;
+
+    // 디렉토리 stat 실패 시에는 일반 경로로 처리 (에러 메시지 출력)
+    if (stat(path, &dir_st) != 0) {
+        list_directory(path, options, 0);
+        return;
+    }
+
+    // 캐시 적중: 디렉토리를 열지 않고 저장된 출력을 그대로 재생
+    if (cache_replay(&stdout_buf, &dir_st, options)) {
+        return;
+    }
+
+    // 캐시 미스: 다시 읽고 메모리에 포맷한 뒤 캐시에 저장하고 출력
+    read_directory(path, options, &listing);
+    if (listing.open_errno == 0 && listing.errors.len == 0) {
+        ls_out_t captured;
+        out_init(&captured, -1);
+        print_listing(&captured, path, &listing, options, 0);
+        cache_store(&dir_st, options, captured.data, captured.len);
+        out_write(&stdout_buf, captured.data, captured.len);
+        free(captured.data);
+    } else {
+        // 에러가 있었던 목록은 캐시하지 않음
+        print_listing(&stdout_buf, path, &listing, options, 0);
+    }
+    free_listing(&listing);
 }
 
 /**
@@ -130,25 +265,46 @@ void list_directory(const char *path, ls_options_t *options, int is_recursive) {
 int main(int argc, char *argv[]) {
     ls_options_t options;           // 옵션 정보를 저장할 구조체
     const char *directory = ".";    // 기본 디렉토리는 현재 디렉토리
-    
+
+    // 파일명 칸 수 계산(wcwidth)에 사용자의 문자 인코딩을 사용
+    // (정렬과 날짜 형식은 그대로 두기 위해 LC_CTYPE만 설정)
+    setlocale(LC_CTYPE, "");
+
     // === 1단계: 명령행 옵션 파싱 ===
     parse_options(argc, argv, &options);
-    
+
     // === 2단계: 디렉토리 인자 처리 ===
     // 옵션이 아닌 인자가 있으면 그것을 디렉토리 경로로 사용
     if (optind < argc) {
         directory = argv[optind];  // optind는 getopt에서 설정하는 다음 인자 인덱스
     }
-    
+
     // === 3단계: 디렉토리 나열 실행 ===
     // is_recursive=0으로 설정하여 최초 호출임을 표시
-    list_directory(directory, &options, 0);
-    
+    // -R과 -j N(N > 1)이 함께 주어지면 하위 디렉토리를 작업 스레드가 미리 읽음
+    out_init(&stdout_buf, STDOUT_FILENO);
+    // -S -R: 모든 단계의 하위 트리 합계를 트리 한 번 탐색으로 미리 계산
+    if (options.subtree_usage && options.recursive) {
+        options.usage = build_usage_table(directory, &options);
+    }
+    // -k가 주어지면 (재귀가 아닐 때) 디렉토리 mtime 기준 캐시 사용
+    // -S의 합계는 하위 트리 깊은 곳이 바뀌어도 디렉토리 mtime이 변하지 않으므로 캐시하지 않음
+    if (options.recursive && options.jobs > 1) {
+        list_directory_parallel(&stdout_buf, directory, &options);
+    } else if (options.cache_dir && !options.recursive && !options.subtree_usage) {
+        list_directory_cached(directory, &options);
+    } else {
+        list_directory(directory, &options, 0);
+    }
+    out_free(&stdout_buf);  // 남은 출력을 내보내고 버퍼 해제
+
     // === 4단계: 메모리 정리 ===
     // 확장자 필터 문자열이 동적 할당되었다면 해제
     if (options.filter_ext) {
         free(options.filter_ext);
     }
-    
+    free(options.cache_dir);
+    free_usage_table(options.usage);
+
     return 0;  // 정상 종료
 }
\ No newline at end of file
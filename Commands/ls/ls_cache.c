@@ -0,0 +1,156 @@
+#include "ls_cache.h"
+#include <fcntl.h>
+#include <limits.h>
+
+#ifndef PATH_MAX
+#define PATH_MAX 4096
+#endif
+
+/**
+ * FNV-1a 64비트 해시에 바이트열을 누적하는 내부 함수
+ */
+static unsigned long long fnv1a(unsigned long long hash, const void *data, size_t len) {
+    const unsigned char *p = data;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= p[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+/**
+ * 출력 결과에 영향을 주는 옵션들만 모아 해시를 계산하는 내부 함수
+ * (-j처럼 출력이 같은 옵션은 제외하여 캐시를 공유함)
+ */
+static unsigned long long options_key(ls_options_t *options) {
+    char signature[512];
+    int len = snprintf(signature, sizeof(signature),
+                       "a%d l%d h%d t%d s%d r%d i%d e%d d%d C%d w%d f%s",
+                       options->show_all, options->long_format, options->human_readable,
+                       options->sort_by_time, options->show_size, options->reverse_sort,
+                       options->show_inode, options->group_by_ext, options->dirs_first,
+                       options->grid, options->grid ? options->term_width : 0,
+                       options->filter_ext ? options->filter_ext : "");
+    if (len < 0 || len >= (int)sizeof(signature)) {
+        len = sizeof(signature) - 1;
+    }
+    return fnv1a(14695981039346656037ULL, signature, len);
+}
+
+/**
+ * 디렉토리와 옵션 조합에 해당하는 캐시 파일 경로를 만드는 내부 함수
+ * 같은 디렉토리/옵션은 항상 같은 파일을 쓰므로 캐시가 무한히 늘어나지 않음
+ */
+static void cache_file_path(char *buffer, size_t size, const struct stat *dir_st,
+                            ls_options_t *options, unsigned long long key) {
+    unsigned long long dev = dir_st->st_dev;
+    unsigned long long ino = dir_st->st_ino;
+    unsigned long long hash = fnv1a(key, &dev, sizeof(dev));
+    hash = fnv1a(hash, &ino, sizeof(ino));
+    snprintf(buffer, size, "%s/%016llx", options->cache_dir, hash);
+}
+
+/**
+ * 헤더에 기록할 값을 디렉토리 stat 정보로부터 채우는 내부 함수
+ */
+static void fill_header(ls_cache_header_t *header, const struct stat *dir_st, unsigned long long key) {
+    memset(header, 0, sizeof(ls_cache_header_t));
+    memcpy(header->magic, LS_CACHE_MAGIC, sizeof(header->magic));
+    header->dev = dir_st->st_dev;
+    header->ino = dir_st->st_ino;
+    header->mtime_sec = dir_st->st_mtim.tv_sec;
+    header->mtime_nsec = dir_st->st_mtim.tv_nsec;
+    header->options_key = key;
+}
+
+int cache_replay(ls_out_t *out, const struct stat *dir_st, ls_options_t *options) {
+    char cache_path[PATH_MAX];
+    unsigned long long key = options_key(options);
+    ls_cache_header_t expected, header;
+
+    cache_file_path(cache_path, sizeof(cache_path), dir_st, options, key);
+    int fd = open(cache_path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return 0;  // 캐시 없음
+    }
+
+    // 헤더의 키가 모두 일치해야 캐시 적중 (디렉토리가 바뀌었으면 mtime이 다름)
+    fill_header(&expected, dir_st, key);
+    if (read(fd, &header, sizeof(header)) != (ssize_t)sizeof(header) ||
+        memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 ||
+        header.dev != expected.dev || header.ino != expected.ino ||
+        header.mtime_sec != expected.mtime_sec || header.mtime_nsec != expected.mtime_nsec ||
+        header.options_key != expected.options_key) {
+        close(fd);
+        return 0;
+    }
+
+    // 먼저 메모리로 모두 읽은 뒤 출력 버퍼에 넣어, 읽기 도중 실패해도 일부만 출력되지 않게 함
+    char *data = malloc(header.data_len ? header.data_len : 1);
+    size_t done = 0;
+    while (data && done < header.data_len) {
+        ssize_t n = read(fd, data + done, header.data_len - done);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        done += (size_t)n;
+    }
+    close(fd);
+
+    if (!data || done != header.data_len) {
+        free(data);
+        return 0;  // 잘린 캐시 파일은 무시하고 다시 생성
+    }
+
+    out_write(out, data, done);
+    free(data);
+    return 1;
+}
+
+void cache_store(const struct stat *dir_st, ls_options_t *options, const char *data, size_t len) {
+    char cache_path[PATH_MAX];
+    char temp_path[PATH_MAX + 32];
+    unsigned long long key = options_key(options);
+    ls_cache_header_t header;
+
+    // 방금 수정된 디렉토리는 같은 mtime 안에서 또 바뀔 수 있으므로 저장하지 않음
+    if (time(NULL) - dir_st->st_mtim.tv_sec < LS_CACHE_MIN_AGE) {
+        return;
+    }
+
+    mkdir(options->cache_dir, 0700);  // 이미 있으면 실패해도 무방
+    cache_file_path(cache_path, sizeof(cache_path), dir_st, options, key);
+    snprintf(temp_path, sizeof(temp_path), "%s.%ld.tmp", cache_path, (long)getpid());
+
+    int fd = open(temp_path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        return;  // 캐시는 부가 기능이므로 실패해도 조용히 넘어감
+    }
+
+    fill_header(&header, dir_st, key);
+    header.data_len = len;
+
+    int ok = write(fd, &header, sizeof(header)) == (ssize_t)sizeof(header);
+    size_t done = 0;
+    while (ok && done < len) {
+        ssize_t n = write(fd, data + done, len - done);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            ok = 0;
+            break;
+        }
+        done += (size_t)n;
+    }
+
+    if (close(fd) != 0) {
+        ok = 0;
+    }
+    if (!ok || rename(temp_path, cache_path) != 0) {
+        unlink(temp_path);
+    }
+}
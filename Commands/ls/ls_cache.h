@@ -0,0 +1,47 @@
+#ifndef LS_CACHE_H
+#define LS_CACHE_H
+
+#include "ls_options.h"
+
+// 캐시 파일 식별용 매직 문자열 (형식이 바뀌면 숫자를 올림)
+#define LS_CACHE_MAGIC "LSCACHE1"
+
+// 수정된 지 이 시간(초)이 지나지 않은 디렉토리는 캐시에 저장하지 않음
+// (같은 mtime 안에서 다시 바뀌면 변경을 감지할 수 없기 때문)
+#define LS_CACHE_MIN_AGE 2
+
+/**
+ * 캐시 파일 앞에 저장되는 헤더
+ * (dev, ino, mtime, 옵션 해시)가 모두 일치해야 캐시를 사용함
+ */
+typedef struct {
+    char magic[8];                  // LS_CACHE_MAGIC
+    unsigned long long dev;         // 디렉토리의 st_dev
+    unsigned long long ino;         // 디렉토리의 st_ino
+    long long mtime_sec;            // 디렉토리의 st_mtim.tv_sec
+    long long mtime_nsec;           // 디렉토리의 st_mtim.tv_nsec
+    unsigned long long options_key; // 출력에 영향을 주는 옵션들의 해시
+    unsigned long long data_len;    // 헤더 뒤에 저장된 출력 데이터 길이
+} ls_cache_header_t;
+
+/**
+ * 캐시된 목록이 있으면 출력 버퍼에 그대로 재생하는 함수
+ * 디렉토리는 호출자가 이미 stat한 정보를 사용하므로 추가 stat이 없음
+ * @param out 출력 버퍼
+ * @param dir_st 나열할 디렉토리의 stat 정보
+ * @param options 적용할 옵션들 (options->cache_dir 사용)
+ * @return 캐시를 재생했으면 1, 캐시가 없거나 오래되었으면 0
+ */
+int cache_replay(ls_out_t *out, const struct stat *dir_st, ls_options_t *options);
+
+/**
+ * 포맷된 목록을 캐시 파일에 저장하는 함수
+ * 임시 파일에 쓴 뒤 rename()하므로 다른 ls가 동시에 읽어도 안전함
+ * @param dir_st 목록을 읽기 전에 구한 디렉토리의 stat 정보
+ * @param options 적용된 옵션들 (options->cache_dir 사용)
+ * @param data 포맷된 출력 데이터
+ * @param len 데이터 길이
+ */
+void cache_store(const struct stat *dir_st, ls_options_t *options, const char *data, size_t len);
+
+#endif // LS_CACHE_H
@@ -0,0 +1,449 @@
+#include "ls_du.h"
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+/**
+ * 디렉토리 하나의 하위 트리 누적 사용량 (여러 스레드가 동시에 더함)
+ * 디렉토리를 다 읽으면 그 디렉토리와 모든 상위 노드에 항목 합계를 더하므로
+ * 탐색이 끝나면 각 노드가 자기 하위 트리 전체의 값을 가짐
+ */
+typedef struct du_node {
+    dev_t dev;                  // 디렉토리의 장치 번호
+    ino_t ino;                  // 디렉토리의 inode 번호 (합계 표의 키)
+    atomic_llong bytes;         // 파일 크기(st_size) 합계
+    atomic_llong blocks;        // 512바이트 블록(st_blocks) 합계
+    struct du_node *parent;     // 상위 디렉토리의 노드 (탐색 시작 디렉토리면 NULL)
+    struct du_node *next;       // 탐색 중 만든 노드 목록의 다음 노드
+} du_node_t;
+
+/**
+ * 한 번의 탐색으로 만든 (dev, ino) -> 하위 트리 합계 표 (-S -R)
+ */
+struct du_table {
+    du_node_t **slots;          // 열린 주소법 해시 테이블 (NULL이면 빈 칸)
+    size_t cap;                 // 테이블 크기 (2의 거듭제곱)
+    du_node_t *nodes;           // 표가 소유하는 모든 노드
+};
+
+/**
+ * 탐색할 디렉토리 하나를 나타내는 작업
+ */
+typedef struct du_task {
+    char *path;                 // 디렉토리 경로
+    du_node_t *node;            // 이 디렉토리의 합계 노드
+    struct du_task *next;       // 작업 스택의 다음 작업
+} du_task_t;
+
+/**
+ * (dev, ino) 집합의 샤드 하나 (열린 주소법 해시 테이블)
+ */
+typedef struct {
+    pthread_mutex_t lock;
+    dev_t *devs;                // 저장된 장치 번호
+    ino_t *inos;                // 저장된 inode 번호 (0이면 빈 칸)
+    size_t cap;                 // 테이블 크기 (2의 거듭제곱)
+    size_t count;               // 저장된 항목 수
+} inode_shard_t;
+
+/**
+ * 작업 스레드들이 공유하는 탐색 상태
+ */
+typedef struct {
+    pthread_mutex_t lock;       // 작업 스택, pending, nodes 보호
+    pthread_cond_t cond;        // 새 작업 또는 탐색 종료를 알림
+    du_task_t *stack;           // 작업 스택 (깊이 우선에 가깝게 진행되어 메모리 사용이 적음)
+    int pending;                // 스택에 있거나 처리 중인 작업 수 (0이면 탐색 종료)
+    du_node_t *nodes;           // 지금까지 만든 모든 노드 (탐색이 끝난 뒤 표로 옮기거나 해제)
+    inode_shard_t shards[DU_INODE_SHARDS];
+} du_state_t;
+
+/**
+ * (dev, ino)를 해시하는 내부 함수
+ */
+static size_t inode_hash(dev_t dev, ino_t ino) {
+    unsigned long long h = (unsigned long long)ino * 0x9E3779B97F4A7C15ULL;
+    h ^= (unsigned long long)dev + (h >> 29);
+    return (size_t)(h ^ (h >> 32));
+}
+
+/**
+ * 샤드 테이블에 (dev, ino)를 넣는 내부 함수 (lock을 잡은 상태에서 호출)
+ * @return 새로 추가되었으면 1, 이미 있었으면 0
+ */
+static int shard_insert(inode_shard_t *shard, dev_t dev, ino_t ino, size_t hash) {
+    size_t mask = shard->cap - 1;
+    for (size_t i = hash & mask; ; i = (i + 1) & mask) {
+        if (shard->inos[i] == 0) {
+            shard->devs[i] = dev;
+            shard->inos[i] = ino;
+            shard->count++;
+            return 1;
+        }
+        if (shard->inos[i] == ino && shard->devs[i] == dev) {
+            return 0;
+        }
+    }
+}
+
+/**
+ * 하드링크된 파일을 처음 보는지 확인하고 기록하는 함수
+ * @return 처음 보는 파일이면 1 (사용량에 포함), 이미 센 파일이면 0
+ */
+static int inode_set_insert(du_state_t *state, dev_t dev, ino_t ino) {
+    size_t hash = inode_hash(dev, ino);
+    inode_shard_t *shard = &state->shards[hash % DU_INODE_SHARDS];
+    hash /= DU_INODE_SHARDS;
+
+    // inode 0은 빈 칸 표시로 쓰므로 중복 제거 대상에서 제외
+    if (ino == 0) {
+        return 1;
+    }
+
+    pthread_mutex_lock(&shard->lock);
+
+    // 사용률이 절반을 넘으면 테이블을 두 배로 키움
+    if ((shard->count + 1) * 2 > shard->cap) {
+        inode_shard_t grown = *shard;
+        grown.cap = shard->cap ? shard->cap * 2 : 64;
+        grown.count = 0;
+        grown.devs = calloc(grown.cap, sizeof(dev_t));
+        grown.inos = calloc(grown.cap, sizeof(ino_t));
+        if (!grown.devs || !grown.inos) {
+            fprintf(stderr, "ls: memory allocation failed\n");
+            exit(1);
+        }
+        for (size_t i = 0; i < shard->cap; i++) {
+            if (shard->inos[i] != 0) {
+                shard_insert(&grown, shard->devs[i], shard->inos[i],
+                             inode_hash(shard->devs[i], shard->inos[i]) / DU_INODE_SHARDS);
+            }
+        }
+        free(shard->devs);
+        free(shard->inos);
+        shard->devs = grown.devs;
+        shard->inos = grown.inos;
+        shard->cap = grown.cap;
+        shard->count = grown.count;
+    }
+
+    int added = shard_insert(shard, dev, ino, hash);
+    pthread_mutex_unlock(&shard->lock);
+    return added;
+}
+
+/**
+ * 디렉토리의 합계 노드를 만드는 함수 (디렉토리 자신의 크기로 시작)
+ */
+static du_node_t *new_node(const struct stat *st, du_node_t *parent) {
+    du_node_t *node = malloc(sizeof(du_node_t));
+    if (!node) {
+        fprintf(stderr, "ls: memory allocation failed\n");
+        exit(1);
+    }
+    node->dev = st->st_dev;
+    node->ino = st->st_ino;
+    atomic_init(&node->bytes, st->st_size);
+    atomic_init(&node->blocks, st->st_blocks);
+    node->parent = parent;
+    node->next = NULL;
+    return node;
+}
+
+/**
+ * 작업 스택에 디렉토리를 추가하는 함수 (노드도 상태의 노드 목록에 등록)
+ */
+static void push_task(du_state_t *state, char *path, du_node_t *node) {
+    du_task_t *task = malloc(sizeof(du_task_t));
+    if (!task) {
+        fprintf(stderr, "ls: memory allocation failed\n");
+        exit(1);
+    }
+    task->path = path;
+    task->node = node;
+
+    pthread_mutex_lock(&state->lock);
+    node->next = state->nodes;
+    state->nodes = node;
+    task->next = state->stack;
+    state->stack = task;
+    state->pending++;
+    pthread_cond_signal(&state->cond);
+    pthread_mutex_unlock(&state->lock);
+}
+
+/**
+ * 디렉토리 하나의 항목들을 합산하고 하위 디렉토리를 작업으로 추가하는 함수
+ * 항목은 디렉토리 fd 기준 fstatat으로 조회하여 경로 전체를 다시 해석하지 않음
+ * 심볼릭 링크는 따라가지 않음 (du와 동일)
+ */
+static void scan_task(du_state_t *state, du_task_t *task) {
+    DIR *dir = opendir(task->path);
+    if (!dir) {
+        return;  // 권한이 없는 디렉토리는 건너뜀 (du처럼 부분 합계만 반영)
+    }
+
+    int fd = dirfd(dir);
+    size_t path_len = strlen(task->path);
+    long long bytes = 0, blocks = 0;
+    struct dirent *entry;
+    struct stat st;
+
+    while ((entry = readdir(dir)) != NULL) {
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+            continue;
+        }
+        if (fstatat(fd, entry->d_name, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+            continue;
+        }
+
+        // 하드링크된 파일은 처음 만났을 때만 셈
+        if (!S_ISDIR(st.st_mode) && st.st_nlink > 1 &&
+            !inode_set_insert(state, st.st_dev, st.st_ino)) {
+            continue;
+        }
+        bytes += st.st_size;
+        blocks += st.st_blocks;
+
+        // 하위 디렉토리는 자기 노드를 가진 작업으로 추가 (다른 스레드도 가져갈 수 있음)
+        if (S_ISDIR(st.st_mode)) {
+            size_t name_len = strlen(entry->d_name);
+            char *child = malloc(path_len + name_len + 2);
+            if (!child) {
+                fprintf(stderr, "ls: memory allocation failed\n");
+                exit(1);
+            }
+            memcpy(child, task->path, path_len);
+            child[path_len] = '/';
+            memcpy(child + path_len + 1, entry->d_name, name_len + 1);
+            push_task(state, child, new_node(&st, task->node));
+        }
+    }
+    closedir(dir);
+
+    // 이 디렉토리의 항목 합계를 자신과 모든 상위 디렉토리의 하위 트리 합계에 더함
+    for (du_node_t *node = task->node; node; node = node->parent) {
+        atomic_fetch_add(&node->bytes, bytes);
+        atomic_fetch_add(&node->blocks, blocks);
+    }
+}
+
+/**
+ * 작업 스레드 본체
+ * 모든 작업이 끝날 때까지(pending == 0) 스택에서 작업을 꺼내 처리
+ */
+static void *du_worker(void *arg) {
+    du_state_t *state = arg;
+
+    for (;;) {
+        pthread_mutex_lock(&state->lock);
+        while (state->stack == NULL && state->pending > 0) {
+            pthread_cond_wait(&state->cond, &state->lock);
+        }
+        if (state->stack == NULL) {
+            pthread_mutex_unlock(&state->lock);
+            break;  // 남은 작업이 없음
+        }
+        du_task_t *task = state->stack;
+        state->stack = task->next;
+        pthread_mutex_unlock(&state->lock);
+
+        scan_task(state, task);
+
+        pthread_mutex_lock(&state->lock);
+        if (--state->pending == 0) {
+            pthread_cond_broadcast(&state->cond);  // 대기 중인 스레드들을 모두 종료시킴
+        }
+        pthread_mutex_unlock(&state->lock);
+
+        free(task->path);
+        free(task);
+    }
+    return NULL;
+}
+
+/**
+ * 탐색 상태를 초기화하는 내부 함수
+ */
+static void state_init(du_state_t *state) {
+    memset(state, 0, sizeof(du_state_t));
+    pthread_mutex_init(&state->lock, NULL);
+    pthread_cond_init(&state->cond, NULL);
+    for (int i = 0; i < DU_INODE_SHARDS; i++) {
+        pthread_mutex_init(&state->shards[i].lock, NULL);
+    }
+}
+
+/**
+ * 탐색 상태의 자원을 해제하는 내부 함수 (노드 목록은 호출자가 처리)
+ */
+static void state_destroy(du_state_t *state) {
+    for (int i = 0; i < DU_INODE_SHARDS; i++) {
+        pthread_mutex_destroy(&state->shards[i].lock);
+        free(state->shards[i].devs);
+        free(state->shards[i].inos);
+    }
+    pthread_mutex_destroy(&state->lock);
+    pthread_cond_destroy(&state->cond);
+}
+
+/**
+ * 스택에 등록된 작업들을 작업 스레드로 모두 처리하는 내부 함수
+ * 생성에 실패하면 호출 스레드가 직접 처리
+ */
+static void run_workers(du_state_t *state, ls_options_t *options) {
+    int worker_count = options->jobs;
+
+    // -j가 없으면 온라인 CPU 수만큼 (상한 DU_MAX_DEFAULT_JOBS) 사용
+    if (worker_count < 1) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        worker_count = cpus < 1 ? 1 : cpus > DU_MAX_DEFAULT_JOBS ? DU_MAX_DEFAULT_JOBS : (int)cpus;
+    }
+
+    pthread_t *workers = malloc(worker_count * sizeof(pthread_t));
+    int started = 0;
+    for (int i = 0; workers && i < worker_count; i++) {
+        if (pthread_create(&workers[started], NULL, du_worker, state) == 0) {
+            started++;
+        }
+    }
+    if (started == 0) {
+        du_worker(state);
+    }
+    for (int i = 0; i < started; i++) {
+        pthread_join(workers[i], NULL);
+    }
+    free(workers);
+}
+
+/**
+ * 노드 목록을 해제하는 내부 함수
+ */
+static void free_nodes(du_node_t *node) {
+    while (node) {
+        du_node_t *next = node->next;
+        free(node);
+        node = next;
+    }
+}
+
+du_table_t *build_usage_table(const char *root, ls_options_t *options) {
+    du_state_t state;
+    struct stat st;
+
+    if (stat(root, &st) != 0 || !S_ISDIR(st.st_mode)) {
+        return NULL;
+    }
+
+    state_init(&state);
+    push_task(&state, strdup(root), new_node(&st, NULL));
+    run_workers(&state, options);
+    state_destroy(&state);
+
+    du_table_t *table = malloc(sizeof(du_table_t));
+    if (!table) {
+        fprintf(stderr, "ls: memory allocation failed\n");
+        exit(1);
+    }
+    size_t count = 0;
+    for (du_node_t *node = state.nodes; node; node = node->next) {
+        count++;
+    }
+    table->cap = 64;
+    while (table->cap < count * 2) {
+        table->cap *= 2;
+    }
+    table->slots = calloc(table->cap, sizeof(du_node_t *));
+    if (!table->slots) {
+        fprintf(stderr, "ls: memory allocation failed\n");
+        exit(1);
+    }
+    table->nodes = state.nodes;
+
+    // 같은 디렉토리를 두 번 만났으면 (바인드 마운트 등) 먼저 넣은 노드를 사용
+    size_t mask = table->cap - 1;
+    for (du_node_t *node = state.nodes; node; node = node->next) {
+        size_t i = inode_hash(node->dev, node->ino) & mask;
+        while (table->slots[i] &&
+               !(table->slots[i]->ino == node->ino && table->slots[i]->dev == node->dev)) {
+            i = (i + 1) & mask;
+        }
+        if (!table->slots[i]) {
+            table->slots[i] = node;
+        }
+    }
+    return table;
+}
+
+void free_usage_table(du_table_t *table) {
+    if (!table) {
+        return;
+    }
+    free_nodes(table->nodes);
+    free(table->slots);
+    free(table);
+}
+
+/**
+ * 합계 표에서 디렉토리의 노드를 찾는 내부 함수
+ * @return 찾은 노드, 표에 없으면 NULL
+ */
+static du_node_t *table_lookup(du_table_t *table, dev_t dev, ino_t ino) {
+    size_t mask = table->cap - 1;
+    for (size_t i = inode_hash(dev, ino) & mask; table->slots[i]; i = (i + 1) & mask) {
+        if (table->slots[i]->ino == ino && table->slots[i]->dev == dev) {
+            return table->slots[i];
+        }
+    }
+    return NULL;
+}
+
+void compute_subtree_usage(dir_listing_t *listing, ls_options_t *options) {
+    du_state_t state;
+    du_node_t **nodes;
+    int walked = 0;
+
+    if (listing->count == 0) {
+        return;
+    }
+
+    nodes = calloc(listing->count, sizeof(du_node_t *));
+    if (!nodes) {
+        fprintf(stderr, "ls: memory allocation failed\n");
+        exit(1);
+    }
+
+    // 합계 표에 있는 디렉토리는 그대로 사용하고, 없는 디렉토리만
+    // (예: 탐색 시작 트리 밖을 가리키는 심볼릭 링크) 하위 트리의 시작 작업으로 등록
+    state_init(&state);
+    for (int i = 0; i < listing->count; i++) {
+        file_info_t *file = &listing->files[i];
+        if (!is_recursion_target(file)) {
+            continue;
+        }
+        if (options->usage) {
+            nodes[i] = table_lookup(options->usage, file->stat_info.st_dev, file->stat_info.st_ino);
+            if (nodes[i]) {
+                continue;
+            }
+        }
+        nodes[i] = new_node(&file->stat_info, NULL);
+        push_task(&state, strdup(file->path), nodes[i]);
+        walked++;
+    }
+    if (walked > 0) {
+        run_workers(&state, options);
+    }
+
+    // 계산된 합계를 목록에 반영
+    for (int i = 0; i < listing->count; i++) {
+        if (nodes[i]) {
+            listing->files[i].stat_info.st_size = (off_t)atomic_load(&nodes[i]->bytes);
+            listing->files[i].stat_info.st_blocks = (blkcnt_t)atomic_load(&nodes[i]->blocks);
+        }
+    }
+
+    free(nodes);
+    free_nodes(state.nodes);
+    state_destroy(&state);
+}
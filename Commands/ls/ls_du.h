@@ -0,0 +1,44 @@
+#ifndef LS_DU_H
+#define LS_DU_H
+
+#include "ls_options.h"
+
+// 하드링크 중복 제거용 (dev, ino) 집합의 샤드 개수 (스레드 간 잠금 경쟁 분산)
+#define DU_INODE_SHARDS 64
+
+// -j가 없을 때 사용할 최대 작업 스레드 수
+#define DU_MAX_DEFAULT_JOBS 16
+
+/**
+ * 트리 전체를 한 번 탐색해 계산한 디렉토리별 하위 트리 합계 표 (-S -R)
+ * 탐색이 끝난 뒤에는 읽기만 하므로 여러 스레드가 동시에 조회해도 안전함
+ */
+typedef struct du_table du_table_t;
+
+/**
+ * 시작 디렉토리 아래 모든 디렉토리의 하위 트리 합계를 한 번에 계산하는 함수 (-S -R)
+ * 디렉토리마다 자기와 상위 디렉토리들의 합계에 더하므로 트리를 한 번만 읽음
+ * (-R로 나열하는 각 단계에서 하위 트리를 다시 탐색하지 않음)
+ * @param root 나열을 시작하는 디렉토리
+ * @param options 적용할 옵션들 (options->jobs를 스레드 수로 사용)
+ * @return 합계 표 (root가 디렉토리가 아니면 NULL)
+ */
+du_table_t *build_usage_table(const char *root, ls_options_t *options);
+
+/**
+ * 합계 표의 메모리를 해제하는 함수 (NULL이면 아무것도 하지 않음)
+ */
+void free_usage_table(du_table_t *table);
+
+/**
+ * 목록에 있는 각 하위 디렉토리의 전체 사용량을 계산하여 반영하는 함수 (-S 옵션)
+ * options->usage 표가 있으면 표의 값을 사용하고, 표에 없는 디렉토리만
+ * 하위 트리를 여러 스레드로 병렬 탐색함. 하드링크는 (dev, ino) 기준으로 한 번만 셈
+ * 계산이 끝나면 각 디렉토리 항목의 stat_info.st_size(바이트 합계)와
+ * st_blocks(512바이트 블록 합계)가 하위 트리 전체의 값으로 바뀜
+ * @param listing read_directory로 수집한 목록
+ * @param options 적용할 옵션들 (options->jobs를 스레드 수로 사용)
+ */
+void compute_subtree_usage(dir_listing_t *listing, ls_options_t *options);
+
+#endif // LS_DU_H
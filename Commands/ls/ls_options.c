@@ -11,9 +11,9 @@ void parse_options(int argc, char *argv[], ls_options_t *options) {
     int opt;
     
     // getopt를 사용한 옵션 파싱
-    // 문자열 "alhtsrRiedf:"는 허용되는 옵션들을 정의
-    // 콜론(:)이 붙은 옵션(f:)은 인자를 받음
-    while ((opt = getopt(argc, argv, "alhtsrRiedf:")) != -1) {
+    // 문자열 "alhtsrRiedf:j:C1k:S"는 허용되는 옵션들을 정의
+    // 콜론(:)이 붙은 옵션(f:, j:, k:)은 인자를 받음
+    while ((opt = getopt(argc, argv, "alhtsrRiedf:j:C1k:S")) != -1) {
         switch (opt) {
             case 'a':   // 숨김 파일 표시 옵션
                 options->show_all = 1;
@@ -51,11 +51,66 @@ void parse_options(int argc, char *argv[], ls_options_t *options) {
                     options->filter_ext = strdup(optarg);
                 }
                 break;
+            case 'j':   // 병렬 재귀 탐색 스레드 수 옵션 (인자 필요)
+                options->jobs = atoi(optarg);
+                if (options->jobs < 1) {
+                    fprintf(stderr, "ls: invalid number of jobs: '%s'\n", optarg);
+                    exit(1);
+                }
+                break;
+            case 'k':   // 목록 캐시 디렉토리 옵션 (인자 필요)
+                free(options->cache_dir);
+                options->cache_dir = strdup(optarg);
+                break;
+            case 'S':   // 하위 트리 전체 사용량 표시 옵션
+                options->subtree_usage = 1;
+                break;
+            case 'C':   // 여러 열 표시 옵션
+                options->grid = 1;
+                options->one_per_line = 0;
+                break;
+            case '1':   // 한 줄에 하나씩 표시 옵션
+                options->one_per_line = 1;
+                options->grid = 0;
+                break;
             case '?':   // 알 수 없는 옵션이나 잘못된 사용
                 print_usage(argv[0]);
                 exit(1);
         }
     }
+    
+    // 열 배치 여부 결정: long format이 아니고, -C가 주어졌거나
+    // -1 없이 터미널에 출력하는 경우 여러 열로 표시
+    if (options->long_format) {
+        options->grid = 0;
+    } else if (!options->one_per_line && isatty(STDOUT_FILENO)) {
+        options->grid = 1;
+    }
+    if (options->grid) {
+        options->term_width = get_terminal_width();
+    }
+}
+
+/**
+ * 출력 터미널의 폭을 구하는 함수
+ * TIOCGWINSZ로 구하고, 실패하면 COLUMNS 환경 변수, 그것도 없으면 80을 사용
+ */
+int get_terminal_width(void) {
+    struct winsize ws;
+    
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) == 0 && ws.ws_col > 0) {
+        return ws.ws_col;
+    }
+    
+    const char *columns = getenv("COLUMNS");
+    if (columns) {
+        int width = atoi(columns);
+        if (width > 0) {
+            return width;
+        }
+    }
+    
+    return 80;
 }
 
 /**
@@ -75,6 +130,11 @@ void print_usage(const char *program_name) {
     printf("  -e    Group by file extension\n");
     printf("  -d    List directories first\n");
     printf("  -f EXT Filter by file extension\n");
+    printf("  -j N  With -R, read subdirectories ahead using N threads\n");
+    printf("  -C    List entries in columns (default on a terminal)\n");
+    printf("  -1    List one entry per line\n");
+    printf("  -k DIR Cache formatted listings in DIR, reused while the directory is unchanged\n");
+    printf("  -S    Show total size of each subdirectory's whole tree (like du)\n");
 }
 
 /**
@@ -143,50 +203,126 @@ int compare_files(const void *a, const void *b, ls_options_t *options) {
 }
 
 /**
- * 단일 파일의 정보를 설정된 형식에 맞춰 출력하는 함수
+ * 단일 파일의 정보를 설정된 형식에 맞춰 출력 버퍼에 포맷팅하는 함수
+ * 필드마다 printf를 호출하지 않고 숫자, 권한, 날짜를 직접 버퍼에 써넣음
  */
-void print_file_info(file_info_t *file, ls_options_t *options) {
+void print_file_info(ls_out_t *out, file_info_t *file, ls_options_t *options) {
     // inode 번호 출력 (옵션이 설정된 경우)
     if (options->show_inode) {
-        printf("%8lu ", (unsigned long)file->stat_info.st_ino);
+        out_uint(out, (unsigned long long)file->stat_info.st_ino, 8);
+        out_char(out, ' ');
     }
     
     // 블록 단위 크기 출력 (옵션이 설정된 경우)
     if (options->show_size) {
-        printf("%8ld ", (long)file->stat_info.st_blocks);
+        out_int(out, (long long)file->stat_info.st_blocks, 8);
+        out_char(out, ' ');
     }
     
     // 상세 정보 출력 (long format 옵션이 설정된 경우)
     if (options->long_format) {
-        // 파일 권한 문자열 생성 및 출력
-        char permissions[11];
-        format_permissions(file->stat_info.st_mode, permissions);
-        printf("%s ", permissions);
+        // 파일 권한 문자열 출력
+        out_permissions(out, file->stat_info.st_mode);
+        out_char(out, ' ');
         
         // 하드링크 수 출력
-        printf("%3lu ", (unsigned long)file->stat_info.st_nlink);
-        
-        // 소유자 및 그룹 정보 조회 및 출력
-        struct passwd *pwd = getpwuid(file->stat_info.st_uid);
-        struct group *grp = getgrgid(file->stat_info.st_gid);
+        out_uint(out, (unsigned long long)file->stat_info.st_nlink, 3);
+        out_char(out, ' ');
         
-        printf("%-8s %-8s ", 
-               pwd ? pwd->pw_name : "unknown",    // 소유자명 (또는 "unknown")
-               grp ? grp->gr_name : "unknown");   // 그룹명 (또는 "unknown")
+        // 소유자 및 그룹 이름 출력 (조회 결과는 캐시됨)
+        size_t name_len;
+        const char *owner = lookup_user_name(file->stat_info.st_uid, &name_len);
+        out_str_left(out, owner, name_len, 8);
+        out_char(out, ' ');
+        const char *group = lookup_group_name(file->stat_info.st_gid, &name_len);
+        out_str_left(out, group, name_len, 8);
+        out_char(out, ' ');
         
-        // 파일 크기 포맷팅 및 출력
-        char size_str[20];
-        format_size(file->stat_info.st_size, size_str, options->human_readable);
-        printf("%8s ", size_str);
+        // 파일 크기 출력 (사람이 읽기 쉬운 형식일 때만 format_size 사용)
+        if (options->human_readable) {
+            char size_str[20];
+            format_size(file->stat_info.st_size, size_str, 1);
+            out_str_right(out, size_str, strlen(size_str), 8);
+        } else {
+            out_int(out, (long long)file->stat_info.st_size, 8);
+        }
+        out_char(out, ' ');
         
-        // 수정 시간 포맷팅 및 출력
-        char *time_str = ctime(&file->stat_info.st_mtime);
-        time_str[strlen(time_str) - 1] = '\0'; // 개행 문자 제거
-        printf("%.12s ", time_str + 4);        // "Mon DD HH:MM" 형식으로 출력
+        // 수정 시간 출력 ("Mon DD HH:MM" 형식, 분 단위로 캐시됨)
+        out_date(out, file->stat_info.st_mtime);
+        out_char(out, ' ');
     }
     
     // 파일명 출력 (항상 마지막에)
-    printf("%s\n", file->name);
+    out_write(out, file->name, file->name_len);
+    out_char(out, '\n');
+}
+
+/**
+ * 목록을 터미널 폭에 맞춰 여러 열로 출력하는 함수
+ * GNU ls -C와 같이 위에서 아래, 왼쪽에서 오른쪽(열 우선) 순서로 배치
+ */
+void print_grid(ls_out_t *out, dir_listing_t *listing, ls_options_t *options) {
+    int count = listing->count;
+    
+    // inode/블록 수 필드는 항목마다 고정 폭(각 9칸)으로 파일명 앞에 붙음
+    int prefix_width = (options->show_inode ? 9 : 0) + (options->show_size ? 9 : 0);
+    
+    // 가장 넓은 항목을 기준으로 열 개수를 정하고(열 사이 공백 2칸),
+    // 행 개수에 맞춰 빈 열이 생기지 않도록 열 개수를 다시 줄임
+    // (폭은 바이트 수가 아니라 터미널 칸 수, 한글은 글자당 3바이트지만 2칸)
+    int max_width = prefix_width + listing->max_name_width + 2;
+    int cols = options->term_width / max_width;
+    if (cols < 1) {
+        cols = 1;
+    }
+    int rows = (count + cols - 1) / cols;
+    cols = (count + rows - 1) / rows;
+    
+    // 각 열의 실제 폭은 미리 계산된 파일명 칸 수를 한 번만 훑어서 구함
+    int *col_width = calloc(cols, sizeof(int));
+    if (!col_width) {
+        fprintf(stderr, "ls: memory allocation failed\n");
+        exit(1);
+    }
+    for (int i = 0; i < count; i++) {
+        int width = prefix_width + listing->files[i].name_width;
+        if (width > col_width[i / rows]) {
+            col_width[i / rows] = width;
+        }
+    }
+    
+    // 행 단위로 출력 (마지막 열 뒤에는 공백을 붙이지 않음)
+    for (int row = 0; row < rows; row++) {
+        for (int col = 0; col < cols; col++) {
+            int index = col * rows + row;
+            if (index >= count) {
+                break;
+            }
+            
+            file_info_t *file = &listing->files[index];
+            if (options->show_inode) {
+                out_uint(out, (unsigned long long)file->stat_info.st_ino, 8);
+                out_char(out, ' ');
+            }
+            if (options->show_size) {
+                out_int(out, (long long)file->stat_info.st_blocks, 8);
+                out_char(out, ' ');
+            }
+            
+            // 채울 폭은 칸 수 기준이므로 바이트 수와의 차이만큼 넓혀서 전달
+            if (col + 1 < cols && index + rows < count) {
+                out_str_left(out, file->name, file->name_len,
+                             col_width[col] - prefix_width + 2 +
+                             (int)file->name_len - file->name_width);
+            } else {
+                out_write(out, file->name, file->name_len);
+            }
+        }
+        out_char(out, '\n');
+    }
+    
+    free(col_width);
 }
 
 /**
@@ -248,6 +384,39 @@ void format_permissions(mode_t mode, char *buffer) {
     buffer[10] = '\0';  // 문자열 종료
 }
 
+/**
+ * 파일명의 터미널 칸 수를 구하는 함수
+ */
+int display_width(const char *name, size_t len) {
+    // 대부분의 파일명은 ASCII이므로 먼저 바이트만 훑어봄
+    size_t i = 0;
+    while (i < len && (unsigned char)name[i] < 0x80) {
+        i++;
+    }
+    if (i == len) {
+        return (int)len;
+    }
+
+    int width = (int)i;
+    mbstate_t state;
+    memset(&state, 0, sizeof(state));
+    while (i < len) {
+        wchar_t wc;
+        size_t n = mbrtowc(&wc, name + i, len - i, &state);
+        if (n == (size_t)-1 || n == (size_t)-2 || n == 0) {
+            // 잘못된 바이트열은 바이트마다 한 칸 (출력은 바이트 그대로)
+            memset(&state, 0, sizeof(state));
+            width++;
+            i++;
+            continue;
+        }
+        int w = wcwidth(wc);
+        width += w < 0 ? 1 : w;
+        i += n;
+    }
+    return width;
+}
+
 /**
  * 파일명에서 확장자 부분을 추출하는 함수
  */
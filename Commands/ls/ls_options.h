@@ -11,6 +11,12 @@
 #include <grp.h>
 #include <time.h>
 #include <errno.h>
+#include <sys/ioctl.h>
+#include <wchar.h>
+#include <locale.h>
+#include "ls_output.h"
+
+struct du_table;
 
 /**
  * ls 명령어의 다양한 옵션 플래그들을 저장하는 구조체
@@ -28,6 +34,13 @@ typedef struct {
     int group_by_ext;       // -e: 파일들을 확장자별로 그룹화하여 표시
     int dirs_first;         // -d: 디렉토리를 일반 파일보다 먼저 표시
     char *filter_ext;       // -f [확장자]: 지정된 확장자를 가진 파일만 필터링하여 표시
+    int jobs;               // -j [개수]: -R에서 하위 디렉토리를 미리 읽을 작업 스레드 수
+    int grid;               // -C: 터미널 폭에 맞춰 여러 열로 표시 (터미널 출력 시 기본값)
+    int one_per_line;       // -1: 터미널 출력이어도 한 줄에 하나씩 표시
+    int term_width;         // 열 배치에 사용할 터미널 폭 (TIOCGWINSZ, 실패 시 COLUMNS 또는 80)
+    char *cache_dir;        // -k [디렉토리]: 포맷된 목록을 저장/재사용할 캐시 디렉토리
+    int subtree_usage;      // -S: 디렉토리의 크기/블록 수를 하위 트리 전체 합계로 표시 (du와 유사)
+    struct du_table *usage; // -S -R: 한 번에 계산한 하위 트리 합계 표 (없으면 목록마다 계산)
 } ls_options_t;
 
 /**
@@ -36,10 +49,24 @@ typedef struct {
  */
 typedef struct {
     char *name;             // 파일명 (디렉토리 경로 제외)
+    size_t name_len;        // 파일명 길이 (수집 시 한 번만 계산)
+    int name_width;         // 파일명이 터미널에서 차지하는 칸 수 (한글 등은 글자당 2칸)
     struct stat stat_info;  // 파일의 상세 통계 정보 (크기, 권한, 시간 등)
     char *path;             // 파일의 전체 경로
 } file_info_t;
 
+/**
+ * 한 디렉토리를 읽고 정렬한 결과를 저장하는 구조체
+ * 수집과 출력을 분리하여, 병렬 -R 모드에서 작업 스레드가 미리 수집할 수 있게 함
+ */
+typedef struct {
+    file_info_t *files;     // 정렬된 파일 정보 배열
+    int count;              // 배열의 요소 개수
+    int max_name_width;     // 가장 넓은 파일명의 칸 수 (열 배치 계산용, 수집 시 함께 계산)
+    int open_errno;         // 디렉토리를 열지 못한 경우의 errno (성공 시 0)
+    ls_out_t errors;        // 수집 중 발생한 stat 에러 메시지 (출력 시점에 함께 출력)
+} dir_listing_t;
+
 // === 옵션 파싱 관련 함수 ===
 /**
  * 명령행 인자를 파싱하여 ls_options_t 구조체에 옵션 정보를 저장
@@ -55,6 +82,12 @@ void parse_options(int argc, char *argv[], ls_options_t *options);
  */
 void print_usage(const char *program_name);
 
+/**
+ * 표준 출력이 연결된 터미널의 폭을 구하는 함수
+ * @return 터미널 폭 (TIOCGWINSZ 실패 시 COLUMNS 환경 변수, 기본값 80)
+ */
+int get_terminal_width(void);
+
 // === 디렉토리 처리 관련 함수 ===
 /**
  * 지정된 디렉토리의 내용을 나열하는 메인 함수
@@ -64,6 +97,39 @@ void print_usage(const char *program_name);
  */
 void list_directory(const char *path, ls_options_t *options, int is_recursive);
 
+/**
+ * 디렉토리의 항목을 읽어 stat 정보를 수집하고 정렬 (출력은 하지 않음)
+ * @param path 읽을 디렉토리 경로
+ * @param options 필터링 및 정렬 기준이 되는 옵션들
+ * @param listing 결과를 저장할 구조체 (free_listing으로 해제)
+ * @return 성공 시 0, 디렉토리를 열지 못하면 -1 (listing->open_errno 설정)
+ */
+int read_directory(const char *path, ls_options_t *options, dir_listing_t *listing);
+
+/**
+ * 수집된 디렉토리 목록을 출력 버퍼에 출력
+ * @param out 출력 버퍼
+ * @param path 디렉토리 경로 (헤더 및 에러 메시지용)
+ * @param listing read_directory로 수집한 목록
+ * @param options 출력 형식을 결정하는 옵션들
+ * @param is_recursive 재귀 호출 여부 (디렉토리명 출력 제어용)
+ */
+void print_listing(ls_out_t *out, const char *path, dir_listing_t *listing,
+                   ls_options_t *options, int is_recursive);
+
+/**
+ * 목록 구조체의 모든 메모리를 해제
+ * @param listing 해제할 목록
+ */
+void free_listing(dir_listing_t *listing);
+
+/**
+ * -R에서 재귀적으로 들어갈 하위 디렉토리인지 확인 (., .. 제외)
+ * @param file 검사할 파일 정보
+ * @return 재귀 대상이면 1, 아니면 0
+ */
+int is_recursion_target(const file_info_t *file);
+
 // === 파일 비교 및 정렬 관련 함수 ===
 /**
  * qsort에서 사용할 파일 비교 함수
@@ -77,11 +143,21 @@ int compare_files(const void *a, const void *b, ls_options_t *options);
 
 // === 파일 정보 출력 관련 함수 ===
 /**
- * 단일 파일의 정보를 설정된 옵션에 따라 출력
+ * 단일 파일의 정보를 설정된 옵션에 따라 출력 버퍼에 한 줄로 포맷팅
+ * @param out 포맷된 줄을 추가할 출력 버퍼
  * @param file 출력할 파일 정보
  * @param options 출력 형식을 결정하는 옵션들
  */
-void print_file_info(file_info_t *file, ls_options_t *options);
+void print_file_info(ls_out_t *out, file_info_t *file, ls_options_t *options);
+
+/**
+ * 목록 전체를 터미널 폭에 맞춘 여러 열(열 우선 순서)로 출력 버퍼에 포맷팅
+ * 각 열의 폭은 미리 계산된 파일명 칸 수를 한 번 훑어서 구함
+ * @param out 포맷된 줄을 추가할 출력 버퍼
+ * @param listing 출력할 디렉토리 목록
+ * @param options 출력 형식을 결정하는 옵션들
+ */
+void print_grid(ls_out_t *out, dir_listing_t *listing, ls_options_t *options);
 
 /**
  * 파일 크기를 옵션에 따라 포맷팅하여 문자열로 변환
@@ -106,6 +182,16 @@ void format_permissions(mode_t mode, char *buffer);
  */
 char *get_file_extension(const char *filename);
 
+/**
+ * 파일명이 터미널에서 차지하는 칸 수를 구하는 함수 (현재 LC_CTYPE 기준)
+ * ASCII만 있으면 바이트 수, 멀티바이트 문자는 wcwidth로 셈
+ * (해석할 수 없는 바이트는 한 칸으로 셈)
+ * @param name 파일명
+ * @param len 파일명 바이트 수
+ * @return 칸 수
+ */
+int display_width(const char *name, size_t len);
+
 /**
  * 설정된 옵션에 따라 해당 파일을 표시할지 결정
  * 숨김 파일 옵션, 확장자 필터 등을 고려
@@ -0,0 +1,274 @@
+#include "ls_output.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <pwd.h>
+#include <grp.h>
+#include <sys/stat.h>
+
+// 날짜 캐시 크기 (분 단위 시간을 인덱스로 사용하는 direct-mapped 캐시)
+#define DATE_CACHE_SIZE 256
+
+/**
+ * 한 분(minute)에 해당하는 날짜 문자열 캐시 항목
+ */
+typedef struct {
+    long long minute;       // time_t를 60으로 나눈 값 (캐시 키)
+    int valid;              // 항목이 채워졌는지 여부
+    char text[12];          // "Mon DD HH:MM" (널 종료 없음)
+} date_cache_entry_t;
+
+static date_cache_entry_t date_cache[DATE_CACHE_SIZE];
+
+static const char month_names[12][3] = {
+    {'J','a','n'}, {'F','e','b'}, {'M','a','r'}, {'A','p','r'},
+    {'M','a','y'}, {'J','u','n'}, {'J','u','l'}, {'A','u','g'},
+    {'S','e','p'}, {'O','c','t'}, {'N','o','v'}, {'D','e','c'}
+};
+
+// 공백 패딩용 문자열 (한 번에 memcpy로 복사)
+static const char spaces[] = "                                ";
+
+void out_init(ls_out_t *out, int fd) {
+    out->cap = LS_OUT_BUFSIZE;
+    out->data = malloc(out->cap);
+    out->len = 0;
+    out->fd = fd;
+    if (!out->data) {
+        fprintf(stderr, "ls: memory allocation failed\n");
+        exit(1);
+    }
+}
+
+void out_flush(ls_out_t *out) {
+    // 메모리 누적 모드에서는 호출자가 직접 data를 사용함
+    if (out->fd < 0) {
+        return;
+    }
+
+    size_t written = 0;
+    while (written < out->len) {
+        ssize_t n = write(out->fd, out->data + written, out->len - written);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;   // 시그널로 중단된 경우 다시 시도
+            }
+            break;          // 파이프가 닫힌 경우 등은 남은 출력을 버림
+        }
+        written += (size_t)n;
+    }
+    out->len = 0;
+}
+
+void out_free(ls_out_t *out) {
+    out_flush(out);
+    free(out->data);
+    out->data = NULL;
+    out->len = out->cap = 0;
+}
+
+/**
+ * 버퍼에 최소 need 바이트의 여유 공간을 확보하는 내부 함수
+ * fd 출력 모드에서는 먼저 flush하고, 그래도 부족하면 버퍼를 키움
+ */
+static void out_reserve(ls_out_t *out, size_t need) {
+    if (out->len + need <= out->cap) {
+        return;
+    }
+    out_flush(out);
+    if (out->len + need <= out->cap) {
+        return;
+    }
+
+    size_t new_cap = out->cap;
+    while (out->len + need > new_cap) {
+        new_cap *= 2;
+    }
+    char *new_data = realloc(out->data, new_cap);
+    if (!new_data) {
+        fprintf(stderr, "ls: memory allocation failed\n");
+        exit(1);
+    }
+    out->data = new_data;
+    out->cap = new_cap;
+}
+
+void out_write(ls_out_t *out, const char *str, size_t len) {
+    out_reserve(out, len);
+    memcpy(out->data + out->len, str, len);
+    out->len += len;
+}
+
+void out_char(ls_out_t *out, char c) {
+    out_reserve(out, 1);
+    out->data[out->len++] = c;
+}
+
+/**
+ * count개의 공백을 추가하는 내부 함수
+ */
+static void out_spaces(ls_out_t *out, int count) {
+    while (count > 0) {
+        int chunk = count < (int)sizeof(spaces) - 1 ? count : (int)sizeof(spaces) - 1;
+        out_write(out, spaces, chunk);
+        count -= chunk;
+    }
+}
+
+void out_str_left(ls_out_t *out, const char *str, size_t len, int width) {
+    out_write(out, str, len);
+    if ((int)len < width) {
+        out_spaces(out, width - (int)len);
+    }
+}
+
+void out_str_right(ls_out_t *out, const char *str, size_t len, int width) {
+    if ((int)len < width) {
+        out_spaces(out, width - (int)len);
+    }
+    out_write(out, str, len);
+}
+
+void out_uint(ls_out_t *out, unsigned long long value, int width) {
+    char digits[24];
+    char *p = digits + sizeof(digits);
+
+    // 뒤에서부터 한 자리씩 채움
+    do {
+        *--p = (char)('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+
+    out_str_right(out, p, digits + sizeof(digits) - p, width);
+}
+
+void out_int(ls_out_t *out, long long value, int width) {
+    if (value >= 0) {
+        out_uint(out, (unsigned long long)value, width);
+        return;
+    }
+
+    char digits[24];
+    char *p = digits + sizeof(digits);
+    unsigned long long magnitude = 0ULL - (unsigned long long)value;
+
+    do {
+        *--p = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+    *--p = '-';
+
+    out_str_right(out, p, digits + sizeof(digits) - p, width);
+}
+
+void out_permissions(ls_out_t *out, mode_t mode) {
+    out_reserve(out, 10);
+    char *buffer = out->data + out->len;
+
+    // 첫 번째 문자: 파일 타입
+    buffer[0] = S_ISDIR(mode) ? 'd' :
+                S_ISLNK(mode) ? 'l' :
+                S_ISCHR(mode) ? 'c' :
+                S_ISBLK(mode) ? 'b' :
+                S_ISFIFO(mode) ? 'p' :
+                S_ISSOCK(mode) ? 's' : '-';
+
+    // 소유자 / 그룹 / 기타 사용자 권한
+    buffer[1] = (mode & S_IRUSR) ? 'r' : '-';
+    buffer[2] = (mode & S_IWUSR) ? 'w' : '-';
+    buffer[3] = (mode & S_IXUSR) ? 'x' : '-';
+    buffer[4] = (mode & S_IRGRP) ? 'r' : '-';
+    buffer[5] = (mode & S_IWGRP) ? 'w' : '-';
+    buffer[6] = (mode & S_IXGRP) ? 'x' : '-';
+    buffer[7] = (mode & S_IROTH) ? 'r' : '-';
+    buffer[8] = (mode & S_IWOTH) ? 'w' : '-';
+    buffer[9] = (mode & S_IXOTH) ? 'x' : '-';
+
+    out->len += 10;
+}
+
+void out_date(ls_out_t *out, time_t t) {
+    // 음수 시간도 올바르게 내림하여 분 단위 키 계산
+    long long minute = t >= 0 ? (long long)t / 60 : ((long long)t - 59) / 60;
+    date_cache_entry_t *entry = &date_cache[(unsigned long long)minute % DATE_CACHE_SIZE];
+
+    // 캐시 미스: localtime 변환은 서로 다른 분마다 한 번만 수행
+    // (시간대 오프셋이 분 단위라는 가정 하에 같은 분의 시간은 같은 문자열을 가짐)
+    if (!entry->valid || entry->minute != minute) {
+        struct tm tm_info;
+        time_t minute_start = (time_t)(minute * 60);
+        char *text = entry->text;
+
+        if (localtime_r(&minute_start, &tm_info) == NULL) {
+            memset(&tm_info, 0, sizeof(tm_info));
+        }
+
+        // ctime() 결과의 "Mon DD HH:MM" 부분과 동일한 형식 (일자는 공백 패딩)
+        memcpy(text, month_names[tm_info.tm_mon % 12], 3);
+        text[3] = ' ';
+        text[4] = tm_info.tm_mday >= 10 ? (char)('0' + tm_info.tm_mday / 10) : ' ';
+        text[5] = (char)('0' + tm_info.tm_mday % 10);
+        text[6] = ' ';
+        text[7] = (char)('0' + tm_info.tm_hour / 10);
+        text[8] = (char)('0' + tm_info.tm_hour % 10);
+        text[9] = ':';
+        text[10] = (char)('0' + tm_info.tm_min / 10);
+        text[11] = (char)('0' + tm_info.tm_min % 10);
+
+        entry->minute = minute;
+        entry->valid = 1;
+    }
+
+    out_write(out, entry->text, sizeof(entry->text));
+}
+
+const char *lookup_user_name(uid_t uid, size_t *len) {
+    // 한 디렉토리의 파일들은 대부분 소유자가 같으므로 직전 결과만 캐시해도 충분함
+    static int cached = 0;
+    static uid_t cached_uid;
+    static char cached_name[256];
+    static size_t cached_len;
+
+    if (!cached || cached_uid != uid) {
+        struct passwd *pwd = getpwuid(uid);
+        const char *name = pwd ? pwd->pw_name : "unknown";
+
+        cached_len = strlen(name);
+        if (cached_len >= sizeof(cached_name)) {
+            cached_len = sizeof(cached_name) - 1;
+        }
+        memcpy(cached_name, name, cached_len);
+        cached_name[cached_len] = '\0';
+        cached_uid = uid;
+        cached = 1;
+    }
+
+    *len = cached_len;
+    return cached_name;
+}
+
+const char *lookup_group_name(gid_t gid, size_t *len) {
+    static int cached = 0;
+    static gid_t cached_gid;
+    static char cached_name[256];
+    static size_t cached_len;
+
+    if (!cached || cached_gid != gid) {
+        struct group *grp = getgrgid(gid);
+        const char *name = grp ? grp->gr_name : "unknown";
+
+        cached_len = strlen(name);
+        if (cached_len >= sizeof(cached_name)) {
+            cached_len = sizeof(cached_name) - 1;
+        }
+        memcpy(cached_name, name, cached_len);
+        cached_name[cached_len] = '\0';
+        cached_gid = gid;
+        cached = 1;
+    }
+
+    *len = cached_len;
+    return cached_name;
+}
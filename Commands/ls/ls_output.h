@@ -0,0 +1,128 @@
+#ifndef LS_OUTPUT_H
+#define LS_OUTPUT_H
+
+#include <stddef.h>
+#include <sys/types.h>
+#include <time.h>
+
+// 출력 버퍼 기본 크기 (이 크기가 찰 때마다 write() 한 번으로 내보냄)
+#define LS_OUT_BUFSIZE (64 * 1024)
+
+/**
+ * ls 출력을 모아두는 버퍼 구조체
+ * printf를 필드마다 호출하는 대신 한 줄씩 직접 포맷팅해서 버퍼에 쌓고,
+ * 버퍼가 가득 차면 write() 한 번으로 내보낸다
+ */
+typedef struct {
+    char *data;             // 포맷팅된 출력 데이터
+    size_t len;             // 현재 버퍼에 쌓인 바이트 수
+    size_t cap;             // 버퍼 용량
+    int fd;                 // 출력 대상 파일 디스크립터 (음수면 메모리에 계속 누적)
+} ls_out_t;
+
+// === 버퍼 관리 함수 ===
+/**
+ * 출력 버퍼를 초기화하는 함수
+ * @param out 초기화할 버퍼
+ * @param fd 출력 대상 파일 디스크립터 (-1이면 flush하지 않고 메모리에 누적)
+ */
+void out_init(ls_out_t *out, int fd);
+
+/**
+ * 버퍼에 쌓인 내용을 write()로 모두 내보내는 함수
+ * fd가 음수인 메모리 버퍼에서는 아무 일도 하지 않음
+ * @param out 내보낼 버퍼
+ */
+void out_flush(ls_out_t *out);
+
+/**
+ * 남은 내용을 flush하고 버퍼 메모리를 해제하는 함수
+ * @param out 해제할 버퍼
+ */
+void out_free(ls_out_t *out);
+
+// === 기본 출력 함수 ===
+/**
+ * 임의의 바이트열을 버퍼에 추가
+ * @param out 출력 버퍼
+ * @param str 추가할 데이터
+ * @param len 데이터 길이
+ */
+void out_write(ls_out_t *out, const char *str, size_t len);
+
+/**
+ * 문자 하나를 버퍼에 추가
+ * @param out 출력 버퍼
+ * @param c 추가할 문자
+ */
+void out_char(ls_out_t *out, char c);
+
+/**
+ * 문자열을 왼쪽 정렬로 추가하고 width까지 공백으로 채움 (printf "%-*s"와 동일)
+ * @param out 출력 버퍼
+ * @param str 추가할 문자열
+ * @param len 문자열 길이
+ * @param width 최소 출력 폭
+ */
+void out_str_left(ls_out_t *out, const char *str, size_t len, int width);
+
+/**
+ * 문자열을 오른쪽 정렬로 추가 (printf "%*s"와 동일)
+ * @param out 출력 버퍼
+ * @param str 추가할 문자열
+ * @param len 문자열 길이
+ * @param width 최소 출력 폭
+ */
+void out_str_right(ls_out_t *out, const char *str, size_t len, int width);
+
+/**
+ * 부호 없는 정수를 10진수로 변환하여 오른쪽 정렬로 추가 (printf "%*lu"와 동일)
+ * snprintf를 거치지 않고 직접 자릿수를 계산함
+ * @param out 출력 버퍼
+ * @param value 출력할 값
+ * @param width 최소 출력 폭
+ */
+void out_uint(ls_out_t *out, unsigned long long value, int width);
+
+/**
+ * 부호 있는 정수를 오른쪽 정렬로 추가 (printf "%*ld"와 동일)
+ * @param out 출력 버퍼
+ * @param value 출력할 값
+ * @param width 최소 출력 폭
+ */
+void out_int(ls_out_t *out, long long value, int width);
+
+// === ls 필드 전용 출력 함수 ===
+/**
+ * mode 비트를 권한 문자열(-rwxr-xr-x)로 변환하여 바로 버퍼에 추가
+ * @param out 출력 버퍼
+ * @param mode 파일의 mode 비트
+ */
+void out_permissions(ls_out_t *out, mode_t mode);
+
+/**
+ * 수정 시간을 "Mon DD HH:MM" 형식(ctime의 5~16번째 글자)으로 추가
+ * 같은 분(minute)에 해당하는 시간은 캐시된 문자열을 재사용하므로
+ * localtime 변환은 서로 다른 분마다 한 번만 일어남
+ * @param out 출력 버퍼
+ * @param t 출력할 시간
+ */
+void out_date(ls_out_t *out, time_t t);
+
+/**
+ * uid에 해당하는 사용자 이름을 반환 (직전 조회 결과를 캐시)
+ * @param uid 조회할 사용자 ID
+ * @param len 이름 길이를 저장할 포인터
+ * @return 사용자 이름 (찾지 못하면 "unknown")
+ */
+const char *lookup_user_name(uid_t uid, size_t *len);
+
+/**
+ * gid에 해당하는 그룹 이름을 반환 (직전 조회 결과를 캐시)
+ * @param gid 조회할 그룹 ID
+ * @param len 이름 길이를 저장할 포인터
+ * @return 그룹 이름 (찾지 못하면 "unknown")
+ */
+const char *lookup_group_name(gid_t gid, size_t *len);
+
+#endif // LS_OUTPUT_H
@@ -0,0 +1,242 @@
+#include "ls_parallel.h"
+#include <pthread.h>
+
+/**
+ * 디렉토리 노드의 처리 상태
+ */
+typedef enum {
+    NODE_PENDING,           // 작업 큐에서 대기 중 (아직 아무도 읽지 않음)
+    NODE_SCANNING,          // 작업 스레드 또는 출력 스레드가 읽는 중
+    NODE_DONE               // 읽기와 정렬이 끝나 출력 가능
+} node_state_t;
+
+/**
+ * 재귀 나열 트리의 디렉토리 하나를 나타내는 노드
+ * 자식 노드 배열은 정렬된 순서를 유지하므로 출력 스레드가 그대로 따라가면
+ * 직렬 버전의 깊이 우선 순서와 같아짐
+ */
+typedef struct ls_node {
+    const char *path;           // 디렉토리 경로 (부모 listing의 path를 참조)
+    dir_listing_t listing;      // 읽기 결과
+    node_state_t state;         // 현재 처리 상태
+    struct ls_node **children;  // 재귀 대상 하위 디렉토리 노드들 (정렬 순서)
+    int child_count;            // 자식 노드 개수
+    struct ls_node *prev;       // 작업 큐 이전 노드
+    struct ls_node *next;       // 작업 큐 다음 노드
+} ls_node_t;
+
+/**
+ * 작업 스레드와 출력 스레드가 공유하는 스케줄러 상태
+ */
+typedef struct {
+    ls_options_t *options;      // 모든 스레드가 공유하는 옵션 (읽기 전용)
+    pthread_mutex_t lock;       // 아래 필드들과 노드 state를 보호
+    pthread_cond_t work_cond;   // 작업 스레드가 새 작업을 기다리는 조건 변수
+    pthread_cond_t done_cond;   // 출력 스레드가 노드 완료를 기다리는 조건 변수
+    ls_node_t *head;            // 작업 큐 앞 (FIFO)
+    ls_node_t *tail;            // 작업 큐 뒤
+    int ahead;                  // 읽기 시작했지만 아직 출력되지 않은 노드 수
+    int stop;                   // 작업 스레드 종료 요청 플래그
+} ls_scheduler_t;
+
+/**
+ * 새 디렉토리 노드를 할당하는 내부 함수
+ */
+static ls_node_t *node_create(const char *path) {
+    ls_node_t *node = calloc(1, sizeof(ls_node_t));
+    if (!node) {
+        fprintf(stderr, "ls: memory allocation failed\n");
+        exit(1);
+    }
+    node->path = path;
+    node->state = NODE_PENDING;
+    return node;
+}
+
+/**
+ * 작업 큐 뒤에 노드를 추가 (lock을 잡은 상태에서 호출)
+ */
+static void queue_push(ls_scheduler_t *sched, ls_node_t *node) {
+    node->next = NULL;
+    node->prev = sched->tail;
+    if (sched->tail) {
+        sched->tail->next = node;
+    } else {
+        sched->head = node;
+    }
+    sched->tail = node;
+}
+
+/**
+ * 작업 큐의 임의 위치에서 노드를 제거 (lock을 잡은 상태에서 호출)
+ * 출력 스레드가 아직 아무도 가져가지 않은 노드를 직접 처리할 때 사용
+ */
+static void queue_remove(ls_scheduler_t *sched, ls_node_t *node) {
+    if (node->prev) {
+        node->prev->next = node->next;
+    } else {
+        sched->head = node->next;
+    }
+    if (node->next) {
+        node->next->prev = node->prev;
+    } else {
+        sched->tail = node->prev;
+    }
+    node->prev = node->next = NULL;
+}
+
+/**
+ * 노드의 디렉토리를 읽고 정렬한 뒤, 하위 디렉토리를 작업 큐에 넣는 함수
+ * 호출 시점에 노드는 이미 NODE_SCANNING 상태여야 하며 lock은 잡지 않은 상태
+ */
+static void scan_node(ls_scheduler_t *sched, ls_node_t *node) {
+    read_directory(node->path, sched->options, &node->listing);
+
+    // 재귀 대상 하위 디렉토리를 정렬된 순서 그대로 자식 노드로 만듦
+    int target_count = 0;
+    for (int i = 0; i < node->listing.count; i++) {
+        if (is_recursion_target(&node->listing.files[i])) {
+            target_count++;
+        }
+    }
+    if (target_count > 0) {
+        node->children = malloc(target_count * sizeof(ls_node_t *));
+        if (!node->children) {
+            fprintf(stderr, "ls: memory allocation failed\n");
+            exit(1);
+        }
+        for (int i = 0; i < node->listing.count; i++) {
+            if (is_recursion_target(&node->listing.files[i])) {
+                node->children[node->child_count++] = node_create(node->listing.files[i].path);
+            }
+        }
+    }
+
+    pthread_mutex_lock(&sched->lock);
+    node->state = NODE_DONE;
+    for (int i = 0; i < node->child_count; i++) {
+        queue_push(sched, node->children[i]);
+    }
+    if (node->child_count > 0) {
+        pthread_cond_broadcast(&sched->work_cond);
+    }
+    pthread_cond_broadcast(&sched->done_cond);
+    pthread_mutex_unlock(&sched->lock);
+}
+
+/**
+ * 작업 스레드 본체
+ * 큐에서 디렉토리를 꺼내 미리 읽어 두되, 출력되지 않은 노드가
+ * 상한을 넘으면 출력 스레드가 따라올 때까지 기다림
+ */
+static void *worker_main(void *arg) {
+    ls_scheduler_t *sched = arg;
+
+    pthread_mutex_lock(&sched->lock);
+    for (;;) {
+        while (!sched->stop &&
+               (sched->head == NULL || sched->ahead >= LS_PARALLEL_AHEAD_LIMIT)) {
+            pthread_cond_wait(&sched->work_cond, &sched->lock);
+        }
+        if (sched->stop) {
+            break;
+        }
+
+        ls_node_t *node = sched->head;
+        queue_remove(sched, node);
+        node->state = NODE_SCANNING;
+        sched->ahead++;
+        pthread_mutex_unlock(&sched->lock);
+
+        scan_node(sched, node);
+
+        pthread_mutex_lock(&sched->lock);
+    }
+    pthread_mutex_unlock(&sched->lock);
+    return NULL;
+}
+
+/**
+ * 출력할 노드가 준비될 때까지 기다리는 함수
+ * 아직 어떤 작업 스레드도 가져가지 않은 노드라면 기다리지 않고 직접 읽음
+ * (작업 스레드가 모두 다른 디렉토리를 읽는 중이어도 출력이 멈추지 않음)
+ */
+static void wait_for_node(ls_scheduler_t *sched, ls_node_t *node) {
+    pthread_mutex_lock(&sched->lock);
+    if (node->state == NODE_PENDING) {
+        queue_remove(sched, node);
+        node->state = NODE_SCANNING;
+        sched->ahead++;
+        pthread_mutex_unlock(&sched->lock);
+        scan_node(sched, node);
+        return;
+    }
+    while (node->state != NODE_DONE) {
+        pthread_cond_wait(&sched->done_cond, &sched->lock);
+    }
+    pthread_mutex_unlock(&sched->lock);
+}
+
+/**
+ * 노드와 그 하위 트리를 직렬 버전과 같은 깊이 우선 순서로 출력하는 함수
+ * 출력이 끝난 노드는 바로 해제함
+ */
+static void print_tree(ls_scheduler_t *sched, ls_out_t *out, ls_node_t *node, int is_recursive) {
+    wait_for_node(sched, node);
+    print_listing(out, node->path, &node->listing, sched->options, is_recursive);
+
+    // 출력이 끝났으므로 작업 스레드가 더 앞서 읽을 수 있도록 알림
+    pthread_mutex_lock(&sched->lock);
+    sched->ahead--;
+    pthread_cond_signal(&sched->work_cond);
+    pthread_mutex_unlock(&sched->lock);
+
+    for (int i = 0; i < node->child_count; i++) {
+        print_tree(sched, out, node->children[i], 1);
+    }
+
+    // 자식 노드의 path가 listing을 참조하므로 자식 출력 후에 해제
+    free(node->children);
+    free_listing(&node->listing);
+    free(node);
+}
+
+/**
+ * 병렬 재귀 나열의 진입점
+ * 작업 스레드를 만들고, 호출 스레드가 출력 스레드 역할을 수행함
+ */
+void list_directory_parallel(ls_out_t *out, const char *path, ls_options_t *options) {
+    ls_scheduler_t sched;
+    int worker_count = options->jobs;
+    pthread_t *workers = malloc(worker_count * sizeof(pthread_t));
+    int started = 0;
+
+    memset(&sched, 0, sizeof(sched));
+    sched.options = options;
+    pthread_mutex_init(&sched.lock, NULL);
+    pthread_cond_init(&sched.work_cond, NULL);
+    pthread_cond_init(&sched.done_cond, NULL);
+
+    // 스레드 생성에 실패해도 출력 스레드가 직접 읽으므로 결과는 동일함
+    for (int i = 0; workers && i < worker_count; i++) {
+        if (pthread_create(&workers[started], NULL, worker_main, &sched) == 0) {
+            started++;
+        }
+    }
+
+    print_tree(&sched, out, node_create(path), 0);
+
+    // 모든 노드가 출력되었으므로 작업 스레드 종료
+    pthread_mutex_lock(&sched.lock);
+    sched.stop = 1;
+    pthread_cond_broadcast(&sched.work_cond);
+    pthread_mutex_unlock(&sched.lock);
+    for (int i = 0; i < started; i++) {
+        pthread_join(workers[i], NULL);
+    }
+
+    free(workers);
+    pthread_mutex_destroy(&sched.lock);
+    pthread_cond_destroy(&sched.work_cond);
+    pthread_cond_destroy(&sched.done_cond);
+}
@@ -0,0 +1,19 @@
+#ifndef LS_PARALLEL_H
+#define LS_PARALLEL_H
+
+#include "ls_options.h"
+
+// 출력되지 않은 채 미리 읽혀 있을 수 있는 디렉토리 수의 상한 (메모리 사용량 제한)
+#define LS_PARALLEL_AHEAD_LIMIT 4096
+
+/**
+ * -R 재귀 나열을 병렬로 수행하는 함수
+ * 작업 스레드들이 하위 디렉토리를 미리 읽고 정렬해 두고,
+ * 호출한 스레드(출력 스레드)는 직렬 버전과 완전히 같은 순서로 출력함
+ * @param out 출력 버퍼
+ * @param path 나열을 시작할 디렉토리 경로
+ * @param options 적용할 옵션들 (options->jobs개의 작업 스레드 사용)
+ */
+void list_directory_parallel(ls_out_t *out, const char *path, ls_options_t *options);
+
+#endif // LS_PARALLEL_H
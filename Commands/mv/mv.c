@@ -6,6 +6,9 @@
 #include <errno.h>
 #include <libgen.h>
 #include "mv_options.h"
+#include "mv_copy.h"
+#include "mv_rename.h"
+#include "mv_unique.h"
 
 /**
  * 주어진 경로가 디렉토리인지 확인하는 함수
@@ -20,26 +23,68 @@ bool is_directory(const char *path) {
     return (stat(path, &st) == 0 && S_ISDIR(st.st_mode));
 }
 
+/**
+ * 원본을 최종 대상 경로로 옮기는 함수
+ * @param src 원본 경로
+ * @param dest 최종 대상 경로
+ * @param no_clobber true면 대상이 이미 있을 때 옮기지 않음 (확인과 이동이 시스템 콜 하나로 원자적)
+ * @return 성공시 0, 실패시 -1 (오류 메시지 출력), no_clobber이고 대상이 이미 있으면 1
+ * 
+ * 같은 파일시스템 내에서는 rename으로 빠르게 이동하고,
+ * 다른 파일시스템 간에는 (EXDEV) 복사 후 원본을 삭제한다.
+ */
+static int move_to(const char *src, const char *dest, bool no_clobber) {
+    int moved = no_clobber ? rename_noreplace(src, dest) : rename(src, dest);
+    if (moved == 0) {
+        return 0;
+    }
+    if (errno == EXDEV) {
+        return move_across_filesystems(src, dest, no_clobber);
+    }
+    if (errno == EEXIST && no_clobber) {
+        return 1;
+    }
+    fprintf(stderr, "mv: '%s'에서 '%s'로 이동할 수 없습니다: %s\n", 
+            src, dest, strerror(errno));
+    return -1;
+}
+
 /**
  * 실제 파일 이동/이름변경을 수행하는 핵심 함수
  * @param src 원본 파일 경로
  * @param dest 대상 파일/디렉토리 경로
  * @param opts 명령줄 옵션 구조체 포인터
+ * @param names -s 옵션용 접미사 캐시 (원본들 사이에서 공유)
  * @return 성공시 0, 실패시 -1
  * 
  * 이 함수는 다음 작업들을 순차적으로 수행한다:
  * 1. 대상이 디렉토리인 경우 파일명을 추가하여 최종 경로 생성
- * 2. -s 옵션 처리: 중복 파일명 시 고유한 이름 생성
- * 3. 덮어쓰기 여부 확인 (옵션에 따라)
- * 4. rename() 시스템 콜로 실제 이동 수행
- * 5. -v 옵션 시 상세 정보 출력
+ * 2. 덮어쓰기 여부 확인 (옵션에 따라, -n은 3단계에서 원자적으로)
+ * 3. rename() 시스템 콜로 실제 이동 수행 (다른 파일시스템이면 복사 후 원본 삭제)
+ *    -s 옵션이면 중복 파일명 시 고유한 이름으로 다시 시도
+ * 4. -v 옵션 시 상세 정보 출력
+ * 
+ * -x 옵션이면 대상 디렉토리 안으로 옮기지 않고 원본과 대상을 맞바꾼다.
  */
-int perform_move(const char *src, const char *dest, mv_options_t *opts) {
+int perform_move(const char *src, const char *dest, mv_options_t *opts, unique_cache_t *names) {
     char *final_dest = NULL;        // 최종 대상 경로
     char *unique_dest = NULL;       // -s 옵션으로 생성된 고유 경로
     bool allocated_dest = false;    // 메모리 할당 여부 추적 플래그
     int result = 0;                 // 함수 반환값
     
+    // -x 옵션: renameat2(RENAME_EXCHANGE)로 두 항목을 한 번에 교환
+    // (교환은 같은 파일시스템 안에서만 가능하므로 복사로 대신하지 않음)
+    if (opts->exchange) {
+        if (rename_exchange(src, dest) != 0) {
+            fprintf(stderr, "mv: '%s'와 '%s'를 교환할 수 없습니다: %s\n", src, dest, strerror(errno));
+            return -1;
+        }
+        if (opts->verbose) {
+            printf("'%s' <-> '%s'\n", src, dest);
+        }
+        return 0;
+    }
+    
     // 대상이 디렉토리인 경우, 원본 파일명을 유지하여 디렉토리 내부로 이동
     // 예: mv file.txt /home/user/ -> /home/user/file.txt
     if (is_directory(dest)) {
@@ -53,17 +98,26 @@ int perform_move(const char *src, const char *dest, mv_options_t *opts) {
         final_dest = (char*)dest;
     }
     
-    // -s 옵션 처리: 중복 파일이 있을 때 고유한 이름 생성 (예: file_1.txt)
     if (opts->suffix) {
-        unique_dest = generate_unique_name(final_dest);
-        if (allocated_dest) {
-            free(final_dest);  // 이전에 할당한 메모리 해제
+        // -s 옵션: 원래 이름부터 대상이 없을 때만 옮기고, 이미 있으면 고유한 이름으로 재시도
+        // (예: file_1.txt). 다음 번호는 대상 디렉토리를 한 번 스캔한 캐시에서 바로 얻고,
+        // 그 사이 다른 프로세스가 같은 이름을 만들었으면 RENAME_NOREPLACE가 거부하므로 다음 번호로
+        result = move_to(src, final_dest, true);
+        while (result > 0) {
+            free(unique_dest);
+            unique_dest = unique_next(names, final_dest);
+            result = move_to(src, unique_dest, true);
+        }
+        if (unique_dest) {
+            if (allocated_dest) {
+                free(final_dest);  // 이전에 할당한 메모리 해제
+            }
+            final_dest = unique_dest;
+            allocated_dest = true;
         }
-        final_dest = unique_dest;
-        allocated_dest = true;
     } else {
-        // -s 옵션이 없는 경우 덮어쓰기 여부 확인
-        if (!should_overwrite(final_dest, opts)) {
+        // 덮어쓰기 여부 확인 (-n은 이동할 때 원자적으로 확인)
+        if (!opts->no_clobber && !should_overwrite(final_dest, opts)) {
             if (opts->verbose) {
                 printf("'%s' 이동이 취소되었습니다.\n", src);
             }
@@ -73,19 +127,18 @@ int perform_move(const char *src, const char *dest, mv_options_t *opts) {
             }
             return 0;
         }
+        result = move_to(src, final_dest, opts->no_clobber);
     }
     
-    // rename() 시스템 콜을 사용하여 실제 파일 이동 수행
-    // 같은 파일시스템 내에서는 빠른 이동, 다른 파일시스템 간에는 복사 후 삭제
-    if (rename(src, final_dest) != 0) {
-        fprintf(stderr, "mv: '%s'에서 '%s'로 이동할 수 없습니다: %s\n", 
-                src, final_dest, strerror(errno));
-        result = -1;
-    } else {
-        // -v 옵션: 이동 성공 시 상세 정보 출력
+    // -n으로 이동하지 않은 경우는 실패가 아님
+    if (result > 0) {
         if (opts->verbose) {
-            printf("'%s' -> '%s'\n", src, final_dest);
+            printf("'%s' 이동이 취소되었습니다.\n", src);
         }
+        result = 0;
+    } else if (result == 0 && opts->verbose) {
+        // -v 옵션: 이동 성공 시 상세 정보 출력
+        printf("'%s' -> '%s'\n", src, final_dest);
     }
     
     // 할당된 메모리가 있다면 해제하여 메모리 누수 방지
@@ -111,6 +164,7 @@ int main(int argc, char *argv[]) {
     mv_options_t opts;              // 명령줄 옵션을 저장할 구조체
     int first_file_index;           // 옵션이 아닌 첫 번째 인자의 인덱스
     struct stat st;                 // 파일 상태 정보를 위한 구조체
+    unique_cache_t names;           // -s 옵션용 접미사 캐시 (대상 디렉토리를 한 번만 스캔)
     
     // 옵션 구조체의 모든 필드를 기본값(false)으로 초기화
     init_options(&opts);
@@ -126,6 +180,7 @@ int main(int argc, char *argv[]) {
     if (argc - first_file_index < 2) {
         fprintf(stderr, "사용법: mv [-ifnvs] 원본 대상\n");
         fprintf(stderr, "       mv [-ifnvs] 원본1 원본2 ... 대상디렉토리\n");
+        fprintf(stderr, "       mv -x [-v] 경로1 경로2\n");
         return 1;
     }
     
@@ -138,12 +193,17 @@ int main(int argc, char *argv[]) {
     // 여러 파일을 이동하는 경우, 대상은 반드시 기존 디렉토리여야 함
     // 예: mv file1 file2 file3 /home/user/ (O)
     //     mv file1 file2 file3 newfile (X - newfile이 디렉토리가 아니면 오류)
+    if (opts.exchange && num_sources > 1) {
+        fprintf(stderr, "mv: -x는 경로 두 개만 받습니다\n");
+        return 1;
+    }
     if (num_sources > 1 && !is_directory(destination)) {
         fprintf(stderr, "mv: 대상 '%s'가 디렉토리가 아닙니다\n", destination);
         return 1;
     }
     
     // 각 원본 파일에 대해 순차적으로 이동 작업 수행
+    unique_cache_init(&names);
     for (int i = 0; i < num_sources; i++) {
         // stat() 시스템 콜로 원본 파일의 존재 여부 및 접근 권한 확인
         if (stat(sources[i], &st) != 0) {
@@ -163,10 +223,12 @@ int main(int argc, char *argv[]) {
         
         // 실제 파일 이동 수행
         // 하나라도 실패하면 프로그램 전체가 실패로 종료
-        if (perform_move(sources[i], destination, &opts) != 0) {
+        if (perform_move(sources[i], destination, &opts, &names) != 0) {
+            unique_cache_free(&names);
             return 1;
         }
     }
     
+    unique_cache_free(&names);
     return 0;  // 모든 파일 이동 성공
 }
\ No newline at end of file
@@ -0,0 +1,646 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <sys/stat.h>
+#include <sys/ioctl.h>
+#include <sys/xattr.h>
+#include <linux/fs.h>
+#include "mv_copy.h"
+#include "mv_rename.h"
+
+/**
+ * 복사 중인 디렉토리 하나
+ */
+typedef struct mv_dir {
+    struct mv_dir *parent;      // 상위 디렉토리 (시작 디렉토리면 NULL)
+    char *path;                 // 원본 경로 (메시지 출력용)
+    size_t path_len;            // 경로 길이
+    const char *name;           // 상위 디렉토리 fd 기준 이름 (path 안을 가리킴, 원본과 복사본이 같음)
+    DIR *dp;                    // 원본 디렉토리 (하위 작업이 fd를 쓰므로 끝날 때까지 열어 둠)
+    int dst_fd;                 // 복사본 디렉토리 fd (-1이면 아직 만들지 못함)
+    struct stat st;             // 원본 디렉토리 정보 (끝날 때 복사본에 적용)
+    atomic_long pending;        // 끝나지 않은 작업 수 (자기 읽기 + 하위 디렉토리 + 파일 묶음)
+    atomic_int failed;          // 하위 항목 중 복사하지 못한 것이 있으면 1
+} mv_dir_t;
+
+/**
+ * 작업 하나 (디렉토리 읽기 또는 파일 묶음 복사)
+ */
+typedef struct mv_task {
+    mv_dir_t *dir;              // 작업 대상 디렉토리
+    char *names;                // 복사할 이름들 ('\0'으로 구분, NULL이면 디렉토리 읽기 작업)
+    int name_count;             // names의 이름 수
+    struct mv_task *next;       // 작업 스택의 다음 작업
+} mv_task_t;
+
+/**
+ * 작업 스레드들이 공유하는 복사 상태
+ */
+typedef struct {
+    const char *dst_root;       // 시작 디렉토리의 복사본 경로 (현재 디렉토리 기준)
+    pthread_mutex_t lock;       // 작업 스택과 done 보호
+    pthread_cond_t cond;        // 새 작업 또는 복사 종료를 알림
+    mv_task_t *stack;           // 작업 스택
+    bool done;                  // 시작 디렉토리까지 처리가 끝났는지
+    int result;                 // 시작 디렉토리의 결과 (0: 성공, -1: 실패)
+} mv_copy_t;
+
+/**
+ * 파일 내용을 복사하는 함수
+ * 커널 안에서 끝나는 방법부터 시도: FICLONE(블록 공유) -> copy_file_range -> read/write
+ * @return 성공시 0, 실패시 -1 (errno 설정)
+ */
+static int copy_data(int in, int out, off_t size) {
+    // reflink는 같은 파일시스템 종류 사이(btrfs 서브볼륨 등)에서만 성공함
+    if (ioctl(out, FICLONE, in) == 0) {
+        return 0;
+    }
+
+    off_t copied = 0;
+    for (;;) {
+        ssize_t n = copy_file_range(in, NULL, out, NULL, 1 << 30, 0);
+        if (n > 0) {
+            copied += n;
+            continue;
+        }
+        if (n == 0 && (copied > 0 || size == 0)) {
+            return 0;  // 파일 끝
+        }
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        // 아직 아무것도 복사하지 않았다면 지원하지 않는 경우이므로 read/write로 전환
+        // (0을 돌려주는 가상 파일시스템 포함)
+        if (copied == 0 && (n == 0 || errno == EXDEV || errno == ENOSYS || errno == EINVAL ||
+                            errno == EOPNOTSUPP || errno == EBADF)) {
+            break;
+        }
+        return -1;
+    }
+
+    char *buffer = malloc(MV_COPY_BUFFER);
+    if (!buffer) {
+        errno = ENOMEM;
+        return -1;
+    }
+    for (;;) {
+        ssize_t n = read(in, buffer, MV_COPY_BUFFER);
+        if (n == 0) {
+            break;
+        }
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            free(buffer);
+            return -1;
+        }
+        for (ssize_t off = 0; off < n; ) {
+            ssize_t w = write(out, buffer + off, n - off);
+            if (w < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                free(buffer);
+                return -1;
+            }
+            off += w;
+        }
+    }
+    free(buffer);
+    return 0;
+}
+
+/**
+ * 확장 속성(xattr)을 복사하는 함수
+ * 권한(security.*, trusted.*)이나 대상 파일시스템이 지원하지 않는 속성은 건너뜀
+ */
+static void copy_xattrs(int src_fd, int dst_fd) {
+    ssize_t len = flistxattr(src_fd, NULL, 0);
+    if (len <= 0) {
+        return;
+    }
+    char *names = malloc(len);
+    if (!names || (len = flistxattr(src_fd, names, len)) <= 0) {
+        free(names);
+        return;
+    }
+
+    char *value = NULL;
+    size_t value_cap = 0;
+    for (char *name = names; name < names + len; name += strlen(name) + 1) {
+        ssize_t value_len = fgetxattr(src_fd, name, NULL, 0);
+        if (value_len < 0) {
+            continue;
+        }
+        if ((size_t)value_len > value_cap) {
+            char *grown = realloc(value, value_len);
+            if (!grown) {
+                break;
+            }
+            value = grown;
+            value_cap = value_len;
+        }
+        value_len = fgetxattr(src_fd, name, value, value_len);
+        if (value_len >= 0) {
+            fsetxattr(dst_fd, name, value, value_len, 0);
+        }
+    }
+    free(value);
+    free(names);
+}
+
+/**
+ * 열린 복사본에 원본의 소유자, 확장 속성, 권한, 시각을 적용하는 함수
+ * 소유자를 바꿀 수 없으면 (일반 사용자) setuid/setgid 비트는 복사하지 않음
+ * @return 성공시 0, 실패시 -1 (errno 설정)
+ */
+static int apply_metadata(int src_fd, int dst_fd, const struct stat *st) {
+    mode_t mode = st->st_mode & 07777;
+    if (fchown(dst_fd, st->st_uid, st->st_gid) != 0) {
+        if (errno != EPERM) {
+            return -1;
+        }
+        mode &= ~(S_ISUID | S_ISGID);
+    }
+    copy_xattrs(src_fd, dst_fd);
+    if (fchmod(dst_fd, mode) != 0) {
+        return -1;
+    }
+    // 시각은 마지막에 (다른 변경이 mtime/ctime을 바꾸지 않도록)
+    struct timespec times[2] = { st->st_atim, st->st_mtim };
+    return futimens(dst_fd, times);
+}
+
+/**
+ * 디렉토리가 아닌 항목 하나를 복사하는 함수 (일반 파일, 심볼릭 링크, FIFO, 장치 파일, 소켓)
+ * @param src_dirfd 원본이 있는 디렉토리 fd
+ * @param src_name src_dirfd 기준 원본 이름
+ * @param dst_dirfd 복사본을 만들 디렉토리 fd
+ * @param dst_name dst_dirfd 기준 복사본 이름 (없어야 함)
+ * @param st 원본의 lstat 정보
+ * @param path 메시지 출력용 원본 경로
+ * @return 성공시 0, 실패시 -1
+ */
+static int copy_entry(int src_dirfd, const char *src_name, int dst_dirfd, const char *dst_name,
+                      const struct stat *st, const char *path) {
+    int err = 0;
+
+    if (S_ISREG(st->st_mode)) {
+        int in = openat(src_dirfd, src_name, O_RDONLY | O_NOFOLLOW | O_CLOEXEC);
+        int out = in < 0 ? -1 : openat(dst_dirfd, dst_name, O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+        if (out < 0 || copy_data(in, out, st->st_size) != 0 ||
+            apply_metadata(in, out, st) != 0 || fsync(out) != 0) {
+            err = errno;
+        }
+        if (out >= 0 && close(out) != 0 && err == 0) {
+            err = errno;
+        }
+        if (in >= 0) {
+            close(in);
+        }
+    } else if (S_ISLNK(st->st_mode)) {
+        // 링크 내용 읽기 (st_size가 0인 파일시스템도 있으므로 잘릴 때마다 버퍼를 키움)
+        size_t cap = st->st_size > 0 ? (size_t)st->st_size + 1 : 256;
+        char *target = NULL;
+        ssize_t n;
+        for (;;) {
+            char *grown = realloc(target, cap);
+            if (!grown) {
+                n = -1;
+                errno = ENOMEM;
+                break;
+            }
+            target = grown;
+            n = readlinkat(src_dirfd, src_name, target, cap);
+            if (n < 0 || (size_t)n < cap) {
+                break;
+            }
+            cap *= 2;
+        }
+        if (n < 0) {
+            err = errno;
+        } else {
+            target[n] = '\0';
+            if (symlinkat(target, dst_dirfd, dst_name) != 0) {
+                err = errno;
+            } else {
+                struct timespec times[2] = { st->st_atim, st->st_mtim };
+                if ((fchownat(dst_dirfd, dst_name, st->st_uid, st->st_gid, AT_SYMLINK_NOFOLLOW) != 0 &&
+                     errno != EPERM) ||
+                    utimensat(dst_dirfd, dst_name, times, AT_SYMLINK_NOFOLLOW) != 0) {
+                    err = errno;
+                }
+            }
+        }
+        free(target);
+    } else {
+        // FIFO, 장치 파일, 소켓: 같은 종류의 노드를 만들고 메타데이터 적용
+        struct timespec times[2] = { st->st_atim, st->st_mtim };
+        if (mknodat(dst_dirfd, dst_name, st->st_mode & (S_IFMT | 0700), st->st_rdev) != 0 ||
+            (fchownat(dst_dirfd, dst_name, st->st_uid, st->st_gid, AT_SYMLINK_NOFOLLOW) != 0 && errno != EPERM) ||
+            fchmodat(dst_dirfd, dst_name, st->st_mode & 0777, 0) != 0 ||
+            utimensat(dst_dirfd, dst_name, times, AT_SYMLINK_NOFOLLOW) != 0) {
+            err = errno;
+        }
+    }
+
+    if (err != 0) {
+        fprintf(stderr, "mv: '%s'을(를) 복사할 수 없습니다: %s\n", path, strerror(err));
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * 디렉토리 트리를 fd 기준으로 삭제하는 함수 (원본 삭제와 실패한 임시 복사본 정리용)
+ * @return 성공시 0, 실패시 -1 (errno 설정)
+ */
+static int remove_tree_at(int dirfd, const char *name) {
+    int fd = openat(dirfd, name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+    if (fd < 0) {
+        // 디렉토리가 아니면 (심볼릭 링크 포함) 항목 자체만 삭제
+        return (errno == ENOTDIR || errno == ELOOP) ? unlinkat(dirfd, name, 0) : -1;
+    }
+    DIR *dp = fdopendir(fd);
+    if (!dp) {
+        close(fd);
+        return -1;
+    }
+
+    int result = 0;
+    int err = 0;
+    struct dirent *entry;
+    while ((entry = readdir(dp)) != NULL) {
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+            continue;
+        }
+        int removed = (entry->d_type == DT_DIR || entry->d_type == DT_UNKNOWN)
+                          ? remove_tree_at(fd, entry->d_name)
+                          : unlinkat(fd, entry->d_name, 0);
+        if (removed != 0 && result == 0) {
+            result = -1;
+            err = errno;
+        }
+    }
+    closedir(dp);
+
+    if (result == 0 && unlinkat(dirfd, name, AT_REMOVEDIR) != 0) {
+        return -1;
+    }
+    errno = err;
+    return result;
+}
+
+/**
+ * 작업 스택에 작업을 추가하는 함수
+ * 호출 전에 dir->pending을 미리 늘려 두어야 함
+ */
+static void push_task(mv_copy_t *copy, mv_dir_t *dir, char *names, int name_count) {
+    mv_task_t *task = malloc(sizeof(mv_task_t));
+    if (!task) {
+        fprintf(stderr, "mv: 메모리 할당 실패\n");
+        exit(1);
+    }
+    task->dir = dir;
+    task->names = names;
+    task->name_count = name_count;
+
+    pthread_mutex_lock(&copy->lock);
+    task->next = copy->stack;
+    copy->stack = task;
+    pthread_cond_signal(&copy->cond);
+    pthread_mutex_unlock(&copy->lock);
+}
+
+/**
+ * 디렉토리 경로 뒤에 이름을 붙일 때 '/'가 필요한지 확인하는 함수 ("dir/"처럼 주어진 경우 제외)
+ */
+static size_t needs_slash(const mv_dir_t *dir) {
+    return dir->path_len > 0 && dir->path[dir->path_len - 1] != '/';
+}
+
+/**
+ * 새 디렉토리 노드를 만드는 함수 (자기 읽기 작업 하나를 pending으로 가짐)
+ * 시작 디렉토리는 parent가 NULL이고 name을 그대로 경로로 사용
+ */
+static mv_dir_t *new_dir(mv_dir_t *parent, const char *name) {
+    mv_dir_t *dir = malloc(sizeof(mv_dir_t));
+    size_t name_len = strlen(name);
+    size_t prefix = parent ? parent->path_len + needs_slash(parent) : 0;
+    char *path = malloc(prefix + name_len + 1);
+    if (!dir || !path) {
+        fprintf(stderr, "mv: 메모리 할당 실패\n");
+        exit(1);
+    }
+    if (parent) {
+        memcpy(path, parent->path, parent->path_len);
+        path[prefix - 1] = '/';
+    }
+    memcpy(path + prefix, name, name_len + 1);
+    dir->parent = parent;
+    dir->path = path;
+    dir->path_len = prefix + name_len;
+    dir->name = path + prefix;
+    dir->dp = NULL;
+    dir->dst_fd = -1;
+    atomic_init(&dir->pending, 1);
+    atomic_init(&dir->failed, 0);
+    return dir;
+}
+
+/**
+ * 메시지 출력용으로 "디렉토리 경로/이름"을 버퍼에 만드는 함수
+ */
+static const char *entry_path(const mv_dir_t *dir, const char *name, char **buf, size_t *cap) {
+    size_t name_len = strlen(name);
+    size_t prefix = dir->path_len + needs_slash(dir);
+    size_t need = prefix + name_len + 1;
+    if (need > *cap) {
+        *cap = need * 2;
+        *buf = realloc(*buf, *cap);
+        if (!*buf) {
+            fprintf(stderr, "mv: 메모리 할당 실패\n");
+            exit(1);
+        }
+    }
+    memcpy(*buf, dir->path, dir->path_len);
+    (*buf)[prefix - 1] = '/';
+    memcpy(*buf + prefix, name, name_len + 1);
+    return *buf;
+}
+
+/**
+ * 디렉토리의 작업 하나가 끝났음을 알리는 함수
+ * 마지막 작업이었다면 복사본 디렉토리에 권한과 시각을 적용하고 fsync한 뒤
+ * 부모에게 같은 처리를 이어감 (하위 항목을 만드는 동안은 0700으로 두어야
+ * 읽기 전용 디렉토리도 채울 수 있고, 항목 생성이 mtime을 바꾸지 않음)
+ */
+static void finish_dir(mv_copy_t *copy, mv_dir_t *dir) {
+    while (dir && atomic_fetch_sub(&dir->pending, 1) == 1) {
+        mv_dir_t *parent = dir->parent;
+        int ok = !atomic_load(&dir->failed);
+
+        if (ok && (apply_metadata(dirfd(dir->dp), dir->dst_fd, &dir->st) != 0 || fsync(dir->dst_fd) != 0)) {
+            fprintf(stderr, "mv: '%s'을(를) 복사할 수 없습니다: %s\n", dir->path, strerror(errno));
+            ok = 0;
+        }
+        if (dir->dst_fd >= 0) {
+            close(dir->dst_fd);
+        }
+        if (dir->dp) {
+            closedir(dir->dp);
+        }
+
+        if (parent) {
+            if (!ok) {
+                atomic_store(&parent->failed, 1);
+            }
+        } else {
+            // 시작 디렉토리까지 끝남: 대기 중인 스레드들을 모두 종료시킴
+            pthread_mutex_lock(&copy->lock);
+            copy->result = ok ? 0 : -1;
+            copy->done = true;
+            pthread_cond_broadcast(&copy->cond);
+            pthread_mutex_unlock(&copy->lock);
+        }
+
+        free(dir->path);
+        free(dir);
+        dir = parent;
+    }
+}
+
+/**
+ * 디렉토리가 아닌 항목 묶음을 복사하는 함수
+ */
+static void copy_batch(mv_dir_t *dir, const char *names, int name_count) {
+    int src_fd = dirfd(dir->dp);
+    char *path = NULL;
+    size_t path_cap = 0;
+
+    for (int i = 0; i < name_count; i++) {
+        struct stat st;
+        const char *msg = entry_path(dir, names, &path, &path_cap);
+        if (fstatat(src_fd, names, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+            fprintf(stderr, "mv: '%s'에 접근할 수 없습니다: %s\n", msg, strerror(errno));
+            atomic_store(&dir->failed, 1);
+        } else if (copy_entry(src_fd, names, dir->dst_fd, names, &st, msg) != 0) {
+            atomic_store(&dir->failed, 1);
+        }
+        names += strlen(names) + 1;
+    }
+    free(path);
+}
+
+/**
+ * 원본 디렉토리를 열고 복사본 디렉토리를 만든 뒤, 하위 디렉토리와 파일 묶음을 작업으로 나누는 함수
+ * 마지막 묶음은 작업으로 넘기지 않고 읽은 스레드가 바로 복사함
+ */
+static void scan_dir(mv_copy_t *copy, mv_dir_t *dir) {
+    mv_dir_t *parent = dir->parent;
+    int src_parent = parent ? dirfd(parent->dp) : AT_FDCWD;
+    int dst_parent = parent ? parent->dst_fd : AT_FDCWD;
+    const char *dst_name = parent ? dir->name : copy->dst_root;
+
+    int fd = openat(src_parent, dir->name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+    dir->dp = fd >= 0 ? fdopendir(fd) : NULL;
+    if (!dir->dp || fstat(fd, &dir->st) != 0) {
+        fprintf(stderr, "mv: '%s'에 접근할 수 없습니다: %s\n", dir->path, strerror(errno));
+        if (!dir->dp && fd >= 0) {
+            close(fd);
+        }
+        atomic_store(&dir->failed, 1);
+        return;
+    }
+    if (mkdirat(dst_parent, dst_name, 0700) != 0 ||
+        (dir->dst_fd = openat(dst_parent, dst_name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC)) < 0) {
+        fprintf(stderr, "mv: '%s'을(를) 복사할 수 없습니다: %s\n", dir->path, strerror(errno));
+        atomic_store(&dir->failed, 1);
+        return;
+    }
+
+    char *batch = NULL;
+    size_t batch_len = 0, batch_cap = 0;
+    int batch_count = 0;
+    struct dirent *entry;
+
+    while ((entry = readdir(dir->dp)) != NULL) {
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+            continue;
+        }
+
+        // d_type을 모르는 파일시스템에서만 fstatat (심볼릭 링크는 따라가지 않음)
+        bool is_dir = entry->d_type == DT_DIR;
+        if (entry->d_type == DT_UNKNOWN) {
+            struct stat st;
+            is_dir = fstatat(fd, entry->d_name, &st, AT_SYMLINK_NOFOLLOW) == 0 && S_ISDIR(st.st_mode);
+        }
+
+        if (is_dir) {
+            atomic_fetch_add(&dir->pending, 1);
+            push_task(copy, new_dir(dir, entry->d_name), NULL, 0);
+            continue;
+        }
+
+        size_t name_len = strlen(entry->d_name) + 1;
+        if (batch_len + name_len > batch_cap) {
+            batch_cap = (batch_len + name_len) * 2;
+            batch = realloc(batch, batch_cap);
+            if (!batch) {
+                fprintf(stderr, "mv: 메모리 할당 실패\n");
+                exit(1);
+            }
+        }
+        memcpy(batch + batch_len, entry->d_name, name_len);
+        batch_len += name_len;
+
+        // 묶음이 차면 다른 스레드가 복사할 수 있도록 작업으로 넘김
+        if (++batch_count == MV_COPY_BATCH) {
+            atomic_fetch_add(&dir->pending, 1);
+            push_task(copy, dir, batch, batch_count);
+            batch = NULL;
+            batch_len = batch_cap = 0;
+            batch_count = 0;
+        }
+    }
+    if (batch_count > 0) {
+        copy_batch(dir, batch, batch_count);
+    }
+    free(batch);
+}
+
+/**
+ * 작업 스레드 본체
+ * 시작 디렉토리가 끝날 때까지(done) 스택에서 작업을 꺼내 처리
+ */
+static void *copy_worker(void *arg) {
+    mv_copy_t *copy = arg;
+
+    for (;;) {
+        pthread_mutex_lock(&copy->lock);
+        while (copy->stack == NULL && !copy->done) {
+            pthread_cond_wait(&copy->cond, &copy->lock);
+        }
+        if (copy->stack == NULL) {
+            pthread_mutex_unlock(&copy->lock);
+            break;
+        }
+        mv_task_t *task = copy->stack;
+        copy->stack = task->next;
+        pthread_mutex_unlock(&copy->lock);
+
+        if (task->names) {
+            copy_batch(task->dir, task->names, task->name_count);
+            free(task->names);
+        } else {
+            scan_dir(copy, task->dir);
+        }
+        finish_dir(copy, task->dir);
+        free(task);
+    }
+    return NULL;
+}
+
+/**
+ * 디렉토리 트리를 여러 스레드로 병렬 복사하는 함수
+ * @param src 원본 디렉토리 경로
+ * @param dst 만들 복사본 경로 (없어야 함)
+ * @return 성공시 0, 실패시 -1
+ */
+static int copy_tree_parallel(const char *src, const char *dst) {
+    mv_copy_t copy;
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int worker_count = cpus < 1 ? 1 : cpus > MV_COPY_JOBS ? MV_COPY_JOBS : (int)cpus;
+
+    memset(&copy, 0, sizeof(copy));
+    copy.dst_root = dst;
+    pthread_mutex_init(&copy.lock, NULL);
+    pthread_cond_init(&copy.cond, NULL);
+    push_task(&copy, new_dir(NULL, src), NULL, 0);
+
+    // 작업 스레드 실행 (생성에 실패하면 호출 스레드가 직접 처리)
+    pthread_t workers[MV_COPY_JOBS];
+    int started = 0;
+    for (int i = 0; i < worker_count; i++) {
+        if (pthread_create(&workers[started], NULL, copy_worker, &copy) == 0) {
+            started++;
+        }
+    }
+    if (started == 0) {
+        copy_worker(&copy);
+    }
+    for (int i = 0; i < started; i++) {
+        pthread_join(workers[i], NULL);
+    }
+
+    pthread_mutex_destroy(&copy.lock);
+    pthread_cond_destroy(&copy.cond);
+    return copy.result;
+}
+
+/**
+ * 경로가 있는 디렉토리를 fsync하는 함수 (rename 결과를 디스크에 반영)
+ */
+static void sync_parent(const char *path) {
+    size_t dir_len = parent_length(path);
+    char *dir = dir_len > 0 ? strndup(path, dir_len) : strdup(".");
+    if (!dir) {
+        return;
+    }
+    int fd = open(dir, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd >= 0) {
+        fsync(fd);
+        close(fd);
+    }
+    free(dir);
+}
+
+int move_across_filesystems(const char *src, const char *dest, bool no_clobber) {
+    struct stat st;
+    if (lstat(src, &st) != 0) {
+        fprintf(stderr, "mv: '%s'에 접근할 수 없습니다: %s\n", src, strerror(errno));
+        return -1;
+    }
+    // -n: 이미 있는 대상이면 복사하지 않음 (반영할 때 다시 원자적으로 확인)
+    if (no_clobber && lstat(dest, &st) == 0) {
+        return 1;
+    }
+
+    // 1단계: 대상 디렉토리 안의 임시 이름으로 복사 (디렉토리는 병렬, 나머지는 항목 하나)
+    char *tmp = temp_name(dest);
+    int result = S_ISDIR(st.st_mode) ? copy_tree_parallel(src, tmp)
+                                     : copy_entry(AT_FDCWD, src, AT_FDCWD, tmp, &st, src);
+
+    // 2단계: 복사가 모두 성공한 경우에만 rename으로 한 번에 반영
+    // (기존 대상은 원자적으로 교체, -n이면 그 사이에 생긴 대상도 덮어쓰지 않음)
+    if (result == 0 && (no_clobber ? rename_noreplace(tmp, dest) : rename(tmp, dest)) != 0) {
+        if (no_clobber && errno == EEXIST) {
+            result = 1;
+        } else {
+            fprintf(stderr, "mv: '%s'에서 '%s'로 이동할 수 없습니다: %s\n", src, dest, strerror(errno));
+            result = -1;
+        }
+    }
+    if (result != 0) {
+        remove_tree_at(AT_FDCWD, tmp);  // 임시 복사본만 정리하고 원본은 그대로 둠
+        free(tmp);
+        return result;
+    }
+    free(tmp);
+    sync_parent(dest);
+
+    // 3단계: 복사본이 디스크에 반영된 뒤에 원본 삭제
+    if (remove_tree_at(AT_FDCWD, src) != 0) {
+        fprintf(stderr, "mv: '%s'을(를) 복사했지만 원본을 삭제할 수 없습니다: %s\n", src, strerror(errno));
+        return -1;
+    }
+    return 0;
+}
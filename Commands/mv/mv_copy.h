@@ -0,0 +1,34 @@
+#ifndef MV_COPY_H
+#define MV_COPY_H
+
+#include <stdbool.h>
+
+// 디렉토리 복사에 사용할 최대 작업 스레드 수 (CPU 수가 더 적으면 CPU 수)
+#define MV_COPY_JOBS 8
+
+// 복사 작업 하나에 묶는 최대 파일 수 (한 디렉토리의 파일을 여러 스레드가 나눠 복사)
+#define MV_COPY_BATCH 64
+
+// read/write로 복사할 때의 버퍼 크기
+#define MV_COPY_BUFFER (128 * 1024)
+
+/**
+ * 다른 파일시스템으로 이동하는 함수 (rename이 EXDEV로 실패한 경우)
+ *
+ * 1. 대상과 같은 디렉토리에 임시 이름(".이름.mv-<pid>")으로 복사함.
+ *    파일 내용은 FICLONE(reflink) -> copy_file_range -> read/write 순으로
+ *    가능한 방법을 사용하고, 소유자/권한/확장 속성/시각을 보존한 뒤 fsync함.
+ *    디렉토리는 여러 스레드가 하위 디렉토리와 파일 묶음을 나눠 병렬로 복사하고,
+ *    하위 항목이 모두 끝난 디렉토리부터 메타데이터를 적용하고 fsync함.
+ * 2. 복사가 모두 성공하면 rename 한 번으로 임시 이름을 최종 이름으로 바꾸고
+ *    (대상이 이미 있으면 원자적으로 교체) 상위 디렉토리를 fsync함.
+ * 3. 그 다음에야 원본을 삭제함. 중간에 실패하면 임시 복사본을 지우고 원본은 그대로 둠.
+ *
+ * @param src 원본 경로
+ * @param dest 최종 대상 경로
+ * @param no_clobber true면 (-n) 대상이 이미 있을 때 이동하지 않음 (반영도 RENAME_NOREPLACE)
+ * @return 성공시 0, 실패시 -1, no_clobber이고 대상이 이미 있어 이동하지 않았으면 1
+ */
+int move_across_filesystems(const char *src, const char *dest, bool no_clobber);
+
+#endif /* MV_COPY_H */
@@ -18,6 +18,7 @@ void init_options(mv_options_t *opts) {
     opts->no_clobber = false;   // -n 옵션: 덮어쓰기 방지 비활성화
     opts->verbose = false;      // -v 옵션: 상세 출력 비활성화
     opts->suffix = false;       // -s 옵션: 중복 시 숫자 추가 비활성화
+    opts->exchange = false;     // -x 옵션: 교환 비활성화
 }
 
 /**
@@ -28,15 +29,16 @@ void init_options(mv_options_t *opts) {
  * @return 성공시 옵션이 아닌 첫 번째 인자의 인덱스, 실패시 -1
  * 
  * getopt() 함수를 사용하여 POSIX 표준 옵션 파싱을 수행한다.
- * 지원하는 옵션: -i, -f, -n, -v, -s
+ * 지원하는 옵션: -i, -f, -n, -v, -s, -x
  * -f와 -n은 상호 배타적이며, 동시에 사용될 경우 -f가 우선한다.
+ * -x는 대상을 덮어쓰거나 새 이름을 만들지 않으므로 -s와 함께 쓸 수 없다.
  */
 int parse_options(int argc, char *argv[], mv_options_t *opts) {
     int opt;  // getopt()가 반환하는 현재 처리 중인 옵션 문자
     
-    // getopt()를 사용하여 옵션 문자열 "ifnvs"에 정의된 옵션들을 순차 처리
+    // getopt()를 사용하여 옵션 문자열 "ifnvsx"에 정의된 옵션들을 순차 처리
     // 각 문자는 하나의 옵션을 나타내며, ':'이 붙으면 인자가 필요함을 의미
-    while ((opt = getopt(argc, argv, "ifnvs")) != -1) {
+    while ((opt = getopt(argc, argv, "ifnvsx")) != -1) {
         switch (opt) {
             case 'i':
                 // -i: interactive mode - 덮어쓰기 전 사용자에게 확인 요청
@@ -58,13 +60,23 @@ int parse_options(int argc, char *argv[], mv_options_t *opts) {
                 // -s: suffix - 중복 파일명 시 숫자를 추가하여 고유한 이름 생성
                 opts->suffix = true;
                 break;
+            case 'x':
+                // -x: exchange - 원본과 대상을 원자적으로 맞바꿈
+                opts->exchange = true;
+                break;
             case '?':
                 // 알 수 없는 옵션이거나 잘못된 옵션 사용 시
-                fprintf(stderr, "사용법: mv [-ifnvs] 원본 대상\n");
+                fprintf(stderr, "사용법: mv [-ifnvsx] 원본 대상\n");
                 return -1;
         }
     }
     
+    // -x는 두 항목을 맞바꾸기만 하므로 고유 이름 생성(-s)과 함께 쓸 수 없음
+    if (opts->exchange && opts->suffix) {
+        fprintf(stderr, "mv: -x와 -s는 함께 사용할 수 없습니다\n");
+        return -1;
+    }
+    
     // -f(force)와 -n(no-clobber)은 서로 반대되는 기능이므로 상호 배타적
     // 둘 다 지정된 경우 GNU mv와 동일하게 -f가 우선하도록 처리
     if (opts->force && opts->no_clobber) {
@@ -84,10 +96,12 @@ int parse_options(int argc, char *argv[], mv_options_t *opts) {
  * 
  * 옵션에 따른 덮어쓰기 정책:
  * 1. 대상 파일이 존재하지 않으면 무조건 허용
- * 2. -n 옵션: 무조건 거부
- * 3. -f 옵션: 무조건 허용
- * 4. -i 옵션: 사용자에게 확인
- * 5. 기본값: 허용 (전통적인 mv 동작)
+ * 2. -f 옵션: 무조건 허용
+ * 3. -i 옵션: 사용자에게 확인
+ * 4. 기본값: 허용 (전통적인 mv 동작)
+ * 
+ * -n 옵션은 여기서 stat으로 확인하면 확인과 rename 사이에 경합이 생기므로
+ * 호출하지 않고, 이동할 때 renameat2(RENAME_NOREPLACE)로 원자적으로 거부한다.
  */
 bool should_overwrite(const char *dest, mv_options_t *opts) {
     struct stat st;  // 파일 상태 정보를 저장할 구조체
@@ -98,11 +112,6 @@ bool should_overwrite(const char *dest, mv_options_t *opts) {
         return true;
     }
     
-    // -n 옵션: no-clobber, 기존 파일을 절대 덮어쓰지 않음
-    if (opts->no_clobber) {
-        return false;
-    }
-    
     // -f 옵션: force, 어떤 경우에도 강제로 덮어쓰기
     // 파일 권한이나 다른 제약과 관계없이 시도
     if (opts->force) {
@@ -122,64 +131,3 @@ bool should_overwrite(const char *dest, mv_options_t *opts) {
     // 전통적인 mv 명령어는 확인 없이 덮어쓰기를 수행
     return true;
 }
-
-/**
- * 중복 파일명이 있을 때 고유한 파일명을 생성하는 함수 (-s 옵션용)
- * @param dest 원래 대상 파일 경로
- * @return 고유한 파일명이 담긴 새로 할당된 문자열 (호출자가 free 필요)
- * 
- * 알고리즘:
- * 1. 원본 파일명이 존재하지 않으면 그대로 반환
- * 2. 파일명을 기본 이름과 확장자로 분리
- * 3. 기본이름_숫자.확장자 형태로 고유한 이름을 찾을 때까지 시도
- * 4. 예: file.txt -> file_1.txt, file_2.txt, ...
- */
-char* generate_unique_name(const char *dest) {
-    struct stat st;         // 파일 존재 확인용 구조체
-    char *new_name;         // 생성된 새 파일명을 저장할 포인터
-    char *base_name, *extension;  // 기본 파일명과 확장자
-    char *dot_pos;          // 확장자 구분점(마지막 '.')의 위치
-    int counter = 1;        // 고유 번호 생성용 카운터
-    
-    // 원본 파일명이 존재하지 않으면 중복이 아니므로 그대로 사용 가능
-    if (stat(dest, &st) != 0) {
-        new_name = malloc(strlen(dest) + 1);  // null terminator 포함
-        strcpy(new_name, dest);
-        return new_name;
-    }
-    
-    // 파일명과 확장자를 분리하기 위해 원본 문자열 복사
-    base_name = malloc(strlen(dest) + 1);
-    strcpy(base_name, dest);
-    
-    // strrchr()로 마지막 '.' 위치를 찾아 확장자 분리
-    // 예: "file.txt" -> base_name="file", extension="txt"
-    dot_pos = strrchr(base_name, '.');
-    if (dot_pos != NULL) {
-        *dot_pos = '\0';        // '.' 위치에 null 문자 삽입하여 기본명 분리
-        extension = dot_pos + 1; // '.' 다음부터가 확장자
-    } else {
-        // 확장자가 없는 파일 (예: "README")
-        extension = "";
-    }
-    
-    // 고유한 이름을 찾기 위한 충분한 메모리 할당
-    // 원본 길이 + 숫자 부분 + 구분자들을 위한 여유 공간
-    new_name = malloc(strlen(dest) + 20);
-    
-    // 중복되지 않는 파일명을 찾을 때까지 반복
-    do {
-        if (strlen(extension) > 0) {
-            // 확장자가 있는 경우: base_name_counter.extension
-            snprintf(new_name, strlen(dest) + 20, "%s_%d.%s", base_name, counter, extension);
-        } else {
-            // 확장자가 없는 경우: base_name_counter
-            snprintf(new_name, strlen(dest) + 20, "%s_%d", base_name, counter);
-        }
-        counter++;  // 다음 시도를 위해 카운터 증가
-    } while (stat(new_name, &st) == 0);  // 파일이 존재하는 동안 계속 반복
-    
-    // 임시로 할당한 base_name 메모리 해제
-    free(base_name);
-    return new_name;  // 호출자가 free()로 해제해야 함
-}
\ No newline at end of file
@@ -29,6 +29,10 @@ typedef struct {
     bool suffix;       // -s 옵션: 중복 파일명 시 숫자 접미사 추가
                        // true일 때 file.txt가 이미 있으면 file_1.txt로 생성
                        // 파일 손실 없이 안전한 이동을 보장
+    
+    bool exchange;     // -x 옵션: 원본과 대상을 원자적으로 맞바꿈
+                       // true일 때 둘 다 있어야 하며 대상이 디렉토리여도 그 안으로 옮기지 않음
+                       // 사용 중인 설정 디렉토리를 한 번에 교체할 때 유용
 } mv_options_t;
 
 /* ==================== 함수 선언부 ==================== */
@@ -50,7 +54,7 @@ void init_options(mv_options_t *opts);
  * @return 성공 시 파일 인자 시작 인덱스, 실패 시 -1
  * 
  * getopt()를 사용하여 POSIX 표준 방식으로 옵션을 파싱한다.
- * 지원 옵션: -i, -f, -n, -v, -s
+ * 지원 옵션: -i, -f, -n, -v, -s, -x
  * 상호 배타적 옵션들의 충돌도 이 함수에서 해결한다.
  */
 int parse_options(int argc, char *argv[], mv_options_t *opts);
@@ -61,22 +65,12 @@ int parse_options(int argc, char *argv[], mv_options_t *opts);
  * @param opts 현재 설정된 옵션들
  * @return 덮어쓰기 허용 시 true, 거부 시 false
  * 
- * 옵션 우선순위: -n > -f > -i > 기본값(허용)
+ * 옵션 우선순위: -f > -i > 기본값(허용)
  * 대상 파일이 존재하지 않으면 항상 true 반환
+ * -n은 이 함수로 확인하지 않고 이동할 때 원자적으로 처리함 (rename_noreplace)
  */
 bool should_overwrite(const char *dest, mv_options_t *opts);
 
-/**
- * 중복 파일명 시 고유한 이름 생성 (-s 옵션용)
- * @param dest 원래 대상 파일 경로
- * @return 동적 할당된 고유 파일명 문자열 (호출자가 free 필요)
- * 
- * 파일명_숫자.확장자 형태로 중복되지 않는 이름을 생성한다.
- * 예: file.txt -> file_1.txt, data -> data_1
- * 메모리를 동적 할당하므로 사용 후 반드시 free() 해야 한다.
- */
-char* generate_unique_name(const char *dest);
-
 #endif /* MV_OPTIONS_H */
 
 /*
@@ -85,8 +79,8 @@ char* generate_unique_name(const char *dest);
  * 1. main()에서 mv_options_t 구조체 선언
  * 2. init_options()로 초기화
  * 3. parse_options()로 명령줄 옵션 파싱
- * 4. 파일 이동 시 should_overwrite()로 덮어쓰기 검사
- * 5. -s 옵션 시 generate_unique_name()으로 고유명 생성
+ * 4. 파일 이동 시 should_overwrite()로 덮어쓰기 검사 (-n 제외)
+ * 5. -s 옵션 시 unique_next()로 고유명 생성 (mv_unique.h)
  * 
  * 예시:
  * mv_options_t opts;
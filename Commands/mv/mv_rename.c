@@ -0,0 +1,115 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "mv_rename.h"
+
+size_t parent_length(const char *path) {
+    size_t len = strlen(path);
+    while (len > 1 && path[len - 1] == '/') {
+        len--;
+    }
+    while (len > 0 && path[len - 1] != '/') {
+        len--;
+    }
+    return len;
+}
+
+char *temp_name(const char *path) {
+    static unsigned counter = 0;
+    size_t dir_len = parent_length(path);
+    size_t base_len = strlen(path + dir_len);
+    while (base_len > 1 && path[dir_len + base_len - 1] == '/') {
+        base_len--;
+    }
+
+    size_t cap = dir_len + base_len + 48;
+    char *tmp = malloc(cap);
+    if (!tmp) {
+        fprintf(stderr, "mv: 메모리 할당 실패\n");
+        exit(1);
+    }
+    struct stat st;
+    do {
+        snprintf(tmp, cap, "%.*s.%.*s.mv-%ld-%u", (int)dir_len, path, (int)base_len, path + dir_len,
+                 (long)getpid(), counter++);
+    } while (lstat(tmp, &st) == 0);
+    return tmp;
+}
+
+/**
+ * renameat2 실패가 플래그를 지원하지 않는 파일시스템/커널 때문인지 확인하는 내부 함수
+ */
+static int flag_unsupported(int err) {
+    return err == EINVAL || err == ENOSYS || err == EOPNOTSUPP;
+}
+
+int rename_noreplace(const char *src, const char *dest) {
+    if (renameat2(AT_FDCWD, src, AT_FDCWD, dest, RENAME_NOREPLACE) == 0) {
+        return 0;
+    }
+    if (!flag_unsupported(errno)) {
+        return -1;
+    }
+
+    // 대체 1: 디렉토리가 아니면 link가 "없을 때만 만들기"를 원자적으로 보장함
+    struct stat st;
+    if (lstat(src, &st) != 0) {
+        return -1;
+    }
+    if (!S_ISDIR(st.st_mode)) {
+        if (link(src, dest) == 0) {
+            if (unlink(src) != 0) {
+                int err = errno;
+                unlink(dest);
+                errno = err;
+                return -1;
+            }
+            return 0;
+        }
+        // 하드링크를 지원하지 않는 파일시스템(EPERM 등)만 대체 2로 넘어감
+        if (errno == EEXIST || errno == EXDEV || errno == ENOENT || errno == EACCES) {
+            return -1;
+        }
+    }
+
+    // 대체 2: 확인 후 rename (확인과 rename 사이에 다른 프로세스가 만들면 덮어쓸 수 있음)
+    if (lstat(dest, &st) == 0) {
+        errno = EEXIST;
+        return -1;
+    }
+    return rename(src, dest);
+}
+
+int rename_exchange(const char *src, const char *dest) {
+    if (renameat2(AT_FDCWD, src, AT_FDCWD, dest, RENAME_EXCHANGE) == 0) {
+        return 0;
+    }
+    if (!flag_unsupported(errno)) {
+        return -1;
+    }
+
+    // 대체: src -> 임시, dest -> src, 임시 -> dest (단계마다 실패하면 되돌림)
+    char *tmp = temp_name(src);
+    int result = -1;
+    int err;
+    if (rename(src, tmp) != 0) {
+        err = errno;
+    } else if (rename(dest, src) != 0) {
+        err = errno;
+        rename(tmp, src);
+    } else if (rename(tmp, dest) != 0) {
+        err = errno;
+        rename(src, dest);
+        rename(tmp, src);
+    } else {
+        err = 0;
+        result = 0;
+    }
+    free(tmp);
+    errno = err;
+    return result;
+}
@@ -0,0 +1,47 @@
+#ifndef MV_RENAME_H
+#define MV_RENAME_H
+
+#include <stddef.h>
+
+/**
+ * 경로의 상위 디렉토리 부분의 길이를 구하는 함수
+ * @param path 경로
+ * @return 마지막 '/'까지의 길이 (끝의 '/'는 무시, 상위가 현재 디렉토리면 0)
+ */
+size_t parent_length(const char *path);
+
+/**
+ * 경로와 같은 디렉토리에 아직 없는 임시 이름을 만드는 함수 (".이름.mv-<pid>-<번호>")
+ * @param path 기준 경로
+ * @return 동적 할당된 경로 (호출자가 free 필요)
+ */
+char *temp_name(const char *path);
+
+/**
+ * 대상이 없을 때만 이름을 바꾸는 함수 (-n)
+ *
+ * renameat2(RENAME_NOREPLACE)로 확인과 이동을 한 번의 시스템 콜에서 원자적으로 함.
+ * 파일시스템이 플래그를 지원하지 않으면 (EINVAL, ENOSYS) 디렉토리가 아닌 항목은
+ * link + unlink로 (역시 원자적), 디렉토리는 lstat 확인 후 rename으로 대신함.
+ *
+ * @param src 원본 경로
+ * @param dest 대상 경로
+ * @return 성공시 0, 실패시 -1 (대상이 이미 있으면 errno가 EEXIST)
+ */
+int rename_noreplace(const char *src, const char *dest);
+
+/**
+ * 두 경로를 원자적으로 맞바꾸는 함수 (-x)
+ *
+ * renameat2(RENAME_EXCHANGE)로 두 이름이 가리키는 항목을 한 번에 교환함
+ * (종류가 달라도 됨, 예: 디렉토리와 심볼릭 링크). 파일시스템이 지원하지 않으면
+ * 임시 이름을 거친 rename 세 번으로 대신함 (원자적이지 않아 중간에 잠깐
+ * dest 이름이 없으며, 실패하면 원래대로 되돌림).
+ *
+ * @param src 첫 번째 경로
+ * @param dest 두 번째 경로
+ * @return 성공시 0, 실패시 -1
+ */
+int rename_exchange(const char *src, const char *dest);
+
+#endif /* MV_RENAME_H */
@@ -0,0 +1,204 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include "mv_unique.h"
+#include "mv_rename.h"
+
+void unique_cache_init(unique_cache_t *cache) {
+    cache->dir = NULL;
+    cache->slots = NULL;
+    cache->cap = 0;
+    cache->count = 0;
+}
+
+/**
+ * 캐시의 이름들을 모두 지우는 내부 함수 (디렉토리 경로는 유지)
+ */
+static void clear_slots(unique_cache_t *cache) {
+    for (size_t i = 0; i < cache->cap; i++) {
+        free(cache->slots[i].key);
+    }
+    free(cache->slots);
+    cache->slots = NULL;
+    cache->cap = 0;
+    cache->count = 0;
+}
+
+void unique_cache_free(unique_cache_t *cache) {
+    clear_slots(cache);
+    free(cache->dir);
+    cache->dir = NULL;
+}
+
+/**
+ * 메모리 할당 실패 시 프로그램을 종료하는 내부 함수
+ */
+static void *check_alloc(void *ptr) {
+    if (!ptr) {
+        fprintf(stderr, "mv: 메모리 할당 실패\n");
+        exit(1);
+    }
+    return ptr;
+}
+
+/**
+ * 키의 해시 (FNV-1a)
+ */
+static size_t key_hash(const char *key, size_t len) {
+    size_t h = 14695981039346656037ULL;
+    for (size_t i = 0; i < len; i++) {
+        h = (h ^ (unsigned char)key[i]) * 1099511628211ULL;
+    }
+    return h;
+}
+
+/**
+ * 키의 칸을 찾고 없으면 만드는 내부 함수
+ * @param key 키 (len 바이트, '\0'으로 끝나지 않아도 됨)
+ * @return 키의 칸 (새로 만든 칸의 max는 0)
+ */
+static unique_entry_t *find_slot(unique_cache_t *cache, const char *key, size_t len) {
+    // 사용률이 절반을 넘으면 테이블을 두 배로 키움
+    if ((cache->count + 1) * 2 > cache->cap) {
+        size_t old_cap = cache->cap;
+        unique_entry_t *old = cache->slots;
+        cache->cap = old_cap ? old_cap * 2 : 64;
+        cache->slots = check_alloc(calloc(cache->cap, sizeof(unique_entry_t)));
+        for (size_t i = 0; i < old_cap; i++) {
+            if (old[i].key) {
+                size_t j = key_hash(old[i].key, strlen(old[i].key)) & (cache->cap - 1);
+                while (cache->slots[j].key) {
+                    j = (j + 1) & (cache->cap - 1);
+                }
+                cache->slots[j] = old[i];
+            }
+        }
+        free(old);
+    }
+
+    size_t mask = cache->cap - 1;
+    for (size_t i = key_hash(key, len) & mask; ; i = (i + 1) & mask) {
+        unique_entry_t *slot = &cache->slots[i];
+        if (!slot->key) {
+            slot->key = check_alloc(strndup(key, len));
+            slot->max = 0;
+            cache->count++;
+            return slot;
+        }
+        if (strncmp(slot->key, key, len) == 0 && slot->key[len] == '\0') {
+            return slot;
+        }
+    }
+}
+
+/**
+ * 파일 이름을 기본 이름과 확장자로 나누는 내부 함수
+ * @param name 파일 이름 (경로 구성 요소 하나)
+ * @param len 이름 길이
+ * @param stem_len 확장자 앞부분(기본 이름, '.' 제외)의 길이
+ * @return 확장자 시작 위치 ('.' 다음, 확장자가 없으면 name + len)
+ */
+static const char *split_extension(const char *name, size_t len, size_t *stem_len) {
+    const char *dot = memrchr(name, '.', len);
+    if (!dot) {
+        *stem_len = len;
+        return name + len;
+    }
+    *stem_len = dot - name;
+    return dot + 1;
+}
+
+/**
+ * 디렉토리 항목 이름 하나를 캐시에 반영하는 내부 함수
+ * "기본이름_번호.확장자" 또는 "기본이름_번호" 형태면 그 이름의 가장 큰 번호를 갱신
+ */
+static void record_name(unique_cache_t *cache, const char *name) {
+    size_t len = strlen(name);
+    size_t stem_len;
+    const char *ext = split_extension(name, len, &stem_len);
+
+    // 기본 이름 끝의 "_숫자" 찾기
+    size_t digits = 0;
+    while (digits < stem_len && name[stem_len - digits - 1] >= '0' && name[stem_len - digits - 1] <= '9') {
+        digits++;
+    }
+    if (digits == 0 || digits > 18 || digits == stem_len || name[stem_len - digits - 1] != '_') {
+        return;
+    }
+    unsigned long number = strtoul(name + stem_len - digits, NULL, 10);
+
+    // 키: 기본이름 + '/' + 확장자
+    size_t base_len = stem_len - digits - 1;
+    size_t ext_len = name + len - ext;
+    char *key = check_alloc(malloc(base_len + ext_len + 2));
+    memcpy(key, name, base_len);
+    key[base_len] = '/';
+    memcpy(key + base_len + 1, ext, ext_len);
+    key[base_len + 1 + ext_len] = '\0';
+
+    unique_entry_t *slot = find_slot(cache, key, base_len + 1 + ext_len);
+    if (number > slot->max) {
+        slot->max = number;
+    }
+    free(key);
+}
+
+/**
+ * 디렉토리를 한 번 읽어 캐시를 채우는 내부 함수
+ * 읽을 수 없는 디렉토리면 빈 캐시로 두고 (번호 1부터 시도) 충돌은 RENAME_NOREPLACE가 막음
+ */
+static void scan_directory(unique_cache_t *cache, const char *dir) {
+    clear_slots(cache);
+    free(cache->dir);
+    cache->dir = check_alloc(strdup(dir));
+
+    DIR *dp = opendir(*dir ? dir : ".");
+    if (!dp) {
+        return;
+    }
+    struct dirent *entry;
+    while ((entry = readdir(dp)) != NULL) {
+        record_name(cache, entry->d_name);
+    }
+    closedir(dp);
+}
+
+char *unique_next(unique_cache_t *cache, const char *dest) {
+    size_t dir_len = parent_length(dest);
+    size_t name_len = strlen(dest + dir_len);
+    while (name_len > 1 && dest[dir_len + name_len - 1] == '/') {
+        name_len--;
+    }
+
+    // 처음이거나 다른 디렉토리면 한 번 스캔
+    if (!cache->dir || strlen(cache->dir) != dir_len || strncmp(cache->dir, dest, dir_len) != 0) {
+        char *dir = check_alloc(strndup(dest, dir_len));
+        scan_directory(cache, dir);
+        free(dir);
+    }
+
+    const char *name = dest + dir_len;
+    size_t stem_len;
+    const char *ext = split_extension(name, name_len, &stem_len);
+    size_t ext_len = name + name_len - ext;
+
+    char *key = check_alloc(malloc(stem_len + ext_len + 2));
+    memcpy(key, name, stem_len);
+    key[stem_len] = '/';
+    memcpy(key + stem_len + 1, ext, ext_len);
+    unique_entry_t *slot = find_slot(cache, key, stem_len + 1 + ext_len);
+    free(key);
+    unsigned long number = ++slot->max;
+
+    // 기본이름_번호.확장자 (확장자가 없으면 기본이름_번호)
+    size_t cap = dir_len + name_len + 24;
+    char *candidate = check_alloc(malloc(cap));
+    if (ext_len > 0) {
+        snprintf(candidate, cap, "%.*s%.*s_%lu.%.*s", (int)dir_len, dest, (int)stem_len, name, number,
+                 (int)ext_len, ext);
+    } else {
+        snprintf(candidate, cap, "%.*s%.*s_%lu", (int)dir_len, dest, (int)stem_len, name, number);
+    }
+    return candidate;
+}
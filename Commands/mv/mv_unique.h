@@ -0,0 +1,55 @@
+#ifndef MV_UNIQUE_H
+#define MV_UNIQUE_H
+
+#include <stddef.h>
+
+/**
+ * 이름 하나(기본 이름 + 확장자)에 대해 지금까지 본 가장 큰 접미사 번호
+ */
+typedef struct {
+    char *key;                  // "기본이름/확장자" ('/'는 파일 이름에 쓸 수 없어 구분자로 사용, NULL이면 빈 칸)
+    unsigned long max;          // 가장 큰 번호 (file_3.txt가 있으면 3)
+} unique_entry_t;
+
+/**
+ * -s 옵션용 접미사 캐시
+ *
+ * 대상 디렉토리를 처음 충돌이 났을 때 한 번만 읽어 "기본이름_번호.확장자" 형태의
+ * 이름마다 가장 큰 번호를 기록해 두고, 이후 원본들은 stat으로 file_1, file_2, ...를
+ * 차례로 확인하지 않고 바로 다음 번호를 사용함 (같은 이름의 원본 N개가 O(N²)에서 O(N)).
+ * 캐시는 후보 이름만 정하고, 실제 생성은 호출자가 RENAME_NOREPLACE로 하므로
+ * 그 사이에 다른 프로세스가 같은 이름을 만들어도 덮어쓰지 않음 (다음 번호로 재시도).
+ */
+typedef struct {
+    char *dir;                  // 스캔한 디렉토리 경로 (NULL이면 아직 스캔하지 않음)
+    unique_entry_t *slots;      // 열린 주소법 해시 테이블 (크기 cap, 2의 거듭제곱)
+    size_t cap;                 // 테이블 크기
+    size_t count;               // 저장된 이름 수
+} unique_cache_t;
+
+/**
+ * 접미사 캐시 초기화
+ * @param cache 초기화할 캐시
+ */
+void unique_cache_init(unique_cache_t *cache);
+
+/**
+ * 접미사 캐시의 메모리 해제
+ * @param cache 해제할 캐시
+ */
+void unique_cache_free(unique_cache_t *cache);
+
+/**
+ * 대상 이름이 이미 있을 때 시도할 다음 이름을 만드는 함수
+ *
+ * 대상의 디렉토리를 아직 스캔하지 않았다면 한 번 스캔하고, 그 이름의 가장 큰
+ * 번호 + 1로 "기본이름_번호.확장자"를 만든 뒤 캐시의 번호를 올림.
+ * 확장자는 마지막 경로 구성 요소의 마지막 '.' 뒤 (예: file.txt -> file_1.txt, data -> data_1).
+ *
+ * @param cache 접미사 캐시
+ * @param dest 원래 대상 경로
+ * @return 동적 할당된 후보 경로 (호출자가 free 필요)
+ */
+char *unique_next(unique_cache_t *cache, const char *dest);
+
+#endif /* MV_UNIQUE_H */
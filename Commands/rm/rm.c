@@ -1,116 +1,127 @@
 #include "rm_options.h"
+#include "rm_tree.h"
+#include "rm_trash.h"
+#include "rm_filter.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
+#include <fcntl.h>
 #include <sys/stat.h>
 #include <dirent.h>
 #include <string.h>
 #include <errno.h>
 
+int remove_file(const char *filepath, const rm_options_t *opts);
+
+// --dry-run일 때 모든 피연산자가 함께 쓰는 삭제 계획 (아니면 NULL)
+static rm_plan_t *dry_run_plan = NULL;
+
 /**
- * 사용자 확인 입력 받기
- * @param filepath 삭제할 파일의 경로
- * @return true: 사용자가 'y' 또는 'Y' 입력시, false: 그 외의 경우
+ * 메시지 출력용 경로 버퍼
  * 
- * 대화형 모드(-i 옵션)에서 파일을 삭제하기 전에 사용자에게 확인을 요청하는 함수
- * "rm: remove 'filename'? " 형태로 출력하고 사용자 입력을 기다림
+ * 재귀 삭제에서 시스템 콜은 디렉토리 fd 기준 이름으로 하고, 전체 경로는
+ * 메시지(-v, -i, 오류)에만 필요하므로 항목마다 malloc하지 않고
+ * 하나의 버퍼에 이름을 붙였다 떼며 사용함
  */
-static bool get_user_confirmation(const char *filepath) {
-    printf("rm: remove '%s'? ", filepath);
-    fflush(stdout);  // 출력 버퍼를 즉시 비워서 프롬프트가 바로 표시되도록 함
-    
-    char response[10];
-    if (fgets(response, sizeof(response), stdin) == NULL) {
-        return false;  // 입력 오류 시 삭제하지 않음
-    }
-    
-    // 첫 번째 문자가 'y' 또는 'Y'인 경우에만 삭제 승인
-    return (response[0] == 'y' || response[0] == 'Y');
-}
+typedef struct {
+    char *data;         // 현재 경로 ('\0'으로 끝남)
+    size_t len;         // 경로 길이
+    size_t cap;         // 버퍼 크기
+} path_buf_t;
 
 /**
  * 파일 크기가 0인지 확인
- * @param filepath 검사할 파일의 경로
+ * @param st 검사할 파일의 상태 정보
  * @return true: 0바이트 일반 파일인 경우, false: 그 외의 경우
  * 
- * -z 옵션 사용시 0바이트 파일만 삭제하기 위해 파일 크기를 확인하는 함수
- * stat() 시스템 콜을 사용하여 파일 정보를 얻어 크기와 타입을 확인
+ * -z 옵션 사용시 0바이트 파일만 삭제하기 위해 파일 크기와 타입을 확인하는 함수
+ * 이미 얻은 stat 정보를 사용하므로 경로를 다시 해석하지 않음
  */
-static bool is_zero_byte_file(const char *filepath) {
-    struct stat st;
-    if (stat(filepath, &st) != 0) {
-        return false;  // stat 실패시 0바이트 파일이 아닌 것으로 간주
-    }
+static bool is_zero_byte_file(const struct stat *st) {
     // 일반 파일이면서 크기가 0인 경우에만 true 반환
-    return (S_ISREG(st.st_mode) && st.st_size == 0);
-}
-
-/**
- * 디렉토리인지 확인
- * @param filepath 검사할 경로
- * @return true: 디렉토리인 경우, false: 그 외의 경우
- * 
- * 주어진 경로가 디렉토리인지 확인하여 재귀 삭제 여부를 결정하는데 사용
- */
-static bool is_directory(const char *filepath) {
-    struct stat st;
-    if (stat(filepath, &st) != 0) {
-        return false;  // stat 실패시 디렉토리가 아닌 것으로 간주
-    }
-    return S_ISDIR(st.st_mode);  // 디렉토리 타입인지 확인
+    return (S_ISREG(st->st_mode) && st->st_size == 0);
 }
 
 /**
- * 경로 결합 함수
- * @param dir 디렉토리 경로
- * @param name 파일/디렉토리 이름
- * @return 결합된 전체 경로 (동적 할당된 메모리, 사용 후 free 필요)
+ * 경로 버퍼 뒤에 "/이름"을 붙이는 함수
+ * @param path 경로 버퍼
+ * @param name 붙일 항목 이름
+ * @return 붙이기 전의 경로 길이 (path_pop에 넘겨 되돌림), 메모리 부족시 (size_t)-1
  * 
- * 디렉토리 재귀 삭제시 부모 디렉토리 경로와 자식 요소 이름을 결합하여
- * 전체 경로를 생성하는 함수. 필요시 '/' 구분자를 자동으로 추가함
+ * 디렉토리 경로 끝에 이미 '/'가 있으면 구분자를 추가하지 않음
  */
-static char* join_path(const char *dir, const char *name) {
-    size_t dir_len = strlen(dir);
+static size_t path_push(path_buf_t *path, const char *name) {
+    size_t saved = path->len;
     size_t name_len = strlen(name);
-    // +2는 '/' 구분자와 null terminator를 위한 공간
-    char *path = malloc(dir_len + name_len + 2);
+    bool need_slash = path->len > 0 && path->data[path->len - 1] != '/';
+    size_t need = path->len + (need_slash ? 1 : 0) + name_len + 1;
     
-    if (path == NULL) {
-        return NULL;  // 메모리 할당 실패
+    if (need > path->cap) {
+        size_t cap = path->cap ? path->cap : 256;
+        while (cap < need) {
+            cap *= 2;
+        }
+        char *grown = realloc(path->data, cap);
+        if (grown == NULL) {
+            return (size_t)-1;  // 메모리 할당 실패
+        }
+        path->data = grown;
+        path->cap = cap;
     }
     
-    strcpy(path, dir);
-    // 디렉토리 경로 끝에 '/'가 없으면 추가
-    if (dir_len > 0 && dir[dir_len - 1] != '/') {
-        strcat(path, "/");
+    if (need_slash) {
+        path->data[path->len++] = '/';
     }
-    strcat(path, name);
-    
-    return path;
+    memcpy(path->data + path->len, name, name_len + 1);
+    path->len += name_len;
+    return saved;
+}
+
+/**
+ * path_push로 붙인 이름을 떼어 경로 버퍼를 되돌리는 함수
+ * @param path 경로 버퍼
+ * @param saved path_push가 반환한 길이
+ */
+static void path_pop(path_buf_t *path, size_t saved) {
+    path->len = saved;
+    path->data[saved] = '\0';
 }
 
+static int remove_entry_at(int dirfd, const char *name, const struct stat *st,
+                           path_buf_t *path, const rm_options_t *opts);
+
 /**
  * 디렉토리 재귀 삭제
- * @param dirpath 삭제할 디렉토리 경로
+ * @param dirfd 삭제할 디렉토리가 있는 디렉토리의 fd (AT_FDCWD면 현재 디렉토리)
+ * @param name dirfd 기준 디렉토리 이름 (최상위면 명령행에 주어진 경로)
+ * @param path 메시지 출력용 전체 경로 버퍼 (현재 디렉토리의 경로를 담고 있음)
  * @param opts 삭제 옵션
- * @return 0: 성공, -1: 실패
+ * @return 0: 성공, -1: 실패, 1: 필터로 남긴 항목이 있어 디렉토리를 남김
  * 
- * 디렉토리 내의 모든 파일과 하위 디렉토리를 재귀적으로 삭제한 후
- * 디렉토리 자체를 삭제하는 함수. -r 옵션이 활성화된 경우에 호출됨
+ * 디렉토리를 fd로 열어 하위 항목을 그 fd 기준으로 삭제한 후 (경로 재해석 없음)
+ * 디렉토리 자체를 unlinkat(AT_REMOVEDIR)으로 삭제하는 함수. -r 옵션이 활성화된 경우에 호출됨
+ * 하위 항목의 타입은 readdir의 d_type으로 판단하고, 알 수 없거나 -z처럼 크기가
+ * 필요할 때만 fstatat을 한 번 호출함
  */
-static int remove_directory_recursive(const char *dirpath, const rm_options_t *opts) {
-    DIR *dir = opendir(dirpath);
+static int remove_directory_at(int dirfd, const char *name, path_buf_t *path, const rm_options_t *opts) {
+    // O_NOFOLLOW: 확인 후 그 사이에 심볼릭 링크로 바뀐 경우에도 링크를 따라가지 않음
+    int fd = openat(dirfd, name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+    DIR *dir = fd >= 0 ? fdopendir(fd) : NULL;
     if (dir == NULL) {
         // 디렉토리 열기 실패시 에러 메시지 출력 (force 모드가 아닌 경우)
         if (!opts->force) {
             fprintf(stderr, "rm: cannot open directory '%s': %s\n", 
-                    dirpath, strerror(errno));
+                    path->data, strerror(errno));
+        }
+        if (fd >= 0) {
+            close(fd);
         }
         return -1;
     }
     
     struct dirent *entry;
     int result = 0;
+    bool kept = false;  // 필터로 남긴 항목이 있는지
     
     // 디렉토리 내의 모든 항목을 순회
     while ((entry = readdir(dir)) != NULL) {
@@ -120,41 +131,69 @@ static int remove_directory_recursive(const char *dirpath, const rm_options_t *o
             continue;
         }
         
-        // 디렉토리 경로와 항목 이름을 결합하여 전체 경로 생성
-        char *filepath = join_path(dirpath, entry->d_name);
-        if (filepath == NULL) {
+        // 메시지용 경로에 항목 이름을 붙임 (malloc은 버퍼가 커질 때만)
+        size_t saved = path_push(path, entry->d_name);
+        if (saved == (size_t)-1) {
             fprintf(stderr, "rm: memory allocation failed\n");
             result = -1;
             break;
         }
         
-        // 각 항목을 재귀적으로 삭제 (파일이면 파일 삭제, 디렉토리면 재귀 호출)
-        if (remove_file(filepath, opts) != 0) {
+        // 타입은 d_type으로 판단하고, 모르거나 크기가 필요할 때만 fstatat 한 번
+        struct stat st;
+        const struct stat *info = NULL;
+        if (entry->d_type == DT_UNKNOWN || opts->zero_only || filter_needs_stat(opts)) {
+            if (fstatat(fd, entry->d_name, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+                if (!opts->force) {
+                    fprintf(stderr, "rm: cannot remove '%s': %s\n", path->data, strerror(errno));
+                    result = -1;
+                }
+                path_pop(path, saved);
+                continue;
+            }
+            info = &st;
+        } else {
+            // d_type만으로 필요한 정보는 타입뿐이므로 st_mode만 채움
+            memset(&st, 0, sizeof(st));
+            st.st_mode = DTTOIF(entry->d_type);
+            info = &st;
+        }
+        
+        // 각 항목을 삭제 (파일이면 unlinkat, 디렉토리면 재귀 호출)
+        int removed = remove_entry_at(fd, entry->d_name, info, path, opts);
+        if (removed < 0) {
             result = -1;  // 하나라도 실패하면 전체 실패로 간주
+        } else if (removed > 0) {
+            kept = true;
         }
         
-        free(filepath);  // 동적 할당된 경로 메모리 해제
+        path_pop(path, saved);  // 경로를 현재 디렉토리로 되돌림
     }
     
     closedir(dir);
     
+    // 필터로 남긴 항목이 있으면 디렉토리도 남김 (오류 아님)
+    if (result == 0 && kept) {
+        return 1;
+    }
+    
     // 디렉토리 내용을 모두 성공적으로 삭제한 경우에만 디렉토리 자체 삭제
     if (result == 0) {
         // 대화형 모드에서 디렉토리 삭제 확인
-        if (opts->interactive && !get_user_confirmation(dirpath)) {
+        if (opts->interactive && !get_user_confirmation(path->data)) {
             return 0;  // 사용자가 거부하면 삭제하지 않음
         }
         
-        // rmdir() 시스템 콜로 빈 디렉토리 삭제
-        if (rmdir(dirpath) != 0) {
+        // 빈 디렉토리를 부모 디렉토리 fd 기준으로 삭제
+        if (unlinkat(dirfd, name, AT_REMOVEDIR) != 0) {
             if (!opts->force) {
                 fprintf(stderr, "rm: cannot remove directory '%s': %s\n", 
-                        dirpath, strerror(errno));
+                        path->data, strerror(errno));
             }
             result = -1;
         } else if (opts->verbose) {
             // verbose 모드에서 삭제 완료 메시지 출력
-            printf("removed directory '%s'\n", dirpath);
+            printf("removed directory '%s'\n", path->data);
         }
     }
     
@@ -162,70 +201,129 @@ static int remove_directory_recursive(const char *dirpath, const rm_options_t *o
 }
 
 /**
- * 파일 삭제 함수 (메인 삭제 로직)
- * @param filepath 삭제할 파일/디렉토리 경로
+ * 타입을 알고 있는 항목 하나를 삭제하는 함수
+ * @param dirfd 항목이 있는 디렉토리의 fd (AT_FDCWD면 현재 디렉토리)
+ * @param name dirfd 기준 항목 이름
+ * @param st 항목의 상태 정보 (d_type만 알 때는 st_mode의 타입 부분만 유효, -z면 전체 유효)
+ * @param path 메시지 출력용 전체 경로 버퍼
  * @param opts 삭제 옵션 구조체
- * @return 0: 성공, -1: 실패
+ * @return 0: 성공, -1: 실패, 1: 필터로 남김 (디렉토리면 남긴 항목이 있음)
  * 
- * 모든 삭제 옵션을 고려하여 파일이나 디렉토리를 삭제하는 핵심 함수
- * 옵션에 따라 다양한 조건을 확인하고 적절한 삭제 방법을 선택함
+ * 최상위 경로와 재귀 삭제 중의 하위 항목 모두 이 함수로 삭제하므로
+ * -z, 필터, -r, -i, -v 처리가 한 곳에 모여 있음
  */
-int remove_file(const char *filepath, const rm_options_t *opts) {
-    // 1단계: 파일/디렉토리 존재 여부 확인
-    if (access(filepath, F_OK) != 0) {
-        // 파일이 존재하지 않는 경우
-        if (!opts->force) {
-            // force 모드가 아니면 에러 메시지 출력
-            fprintf(stderr, "rm: cannot remove '%s': No such file or directory\n", filepath);
+static int remove_entry_at(int dirfd, const char *name, const struct stat *st,
+                           path_buf_t *path, const rm_options_t *opts) {
+    // -z 옵션 처리 (0바이트 파일만 삭제)
+    if (opts->zero_only && !is_zero_byte_file(st)) {
+        if (opts->verbose) {
+            printf("skipped '%s' (not a zero-byte file)\n", path->data);
         }
-        // force 모드에서는 존재하지 않는 파일을 무시하고 성공으로 처리
-        return opts->force ? 0 : -1;
+        return 0;  // 0바이트가 아닌 파일은 건너뛰고 성공으로 처리
     }
     
-    // 2단계: -z 옵션 처리 (0바이트 파일만 삭제)
-    if (opts->zero_only && !is_zero_byte_file(filepath)) {
-        if (opts->verbose) {
-            printf("skipped '%s' (not a zero-byte file)\n", filepath);
+    // --include, --exclude, 나이, 크기 필터 (걸린 항목이 있는 디렉토리는 비지 않으므로 남음)
+    if (filter_active(opts) && !filter_accepts(opts, name, st)) {
+        if (opts->verbose && !dry_run_plan) {
+            printf("skipped '%s'\n", path->data);
         }
-        return 0;  // 0바이트가 아닌 파일은 건너뛰고 성공으로 처리
+        return 1;
     }
     
-    // 3단계: 디렉토리 처리
-    if (is_directory(filepath)) {
+    // 디렉토리 처리 (심볼릭 링크는 lstat/d_type 기준으로 디렉토리가 아니므로 링크만 삭제됨)
+    if (S_ISDIR(st->st_mode)) {
         if (!opts->recursive) {
             // recursive 옵션 없이 디렉토리를 삭제하려는 경우 에러
             if (!opts->force) {
-                fprintf(stderr, "rm: cannot remove '%s': Is a directory\n", filepath);
+                fprintf(stderr, "rm: cannot remove '%s': Is a directory\n", path->data);
             }
             return -1;
         }
+        // --dry-run: 삭제와 같은 병렬 엔진으로 탐색만 함 (확인 프롬프트 없음)
+        if (dry_run_plan) {
+            return plan_tree_parallel(dirfd, name, path->data, opts, dry_run_plan);
+        }
         // recursive 옵션이 있으면 재귀적으로 디렉토리 삭제
-        return remove_directory_recursive(filepath, opts);
+        // (-j: 병렬 삭제, 단 -i는 확인 순서가 섞이지 않도록 순차로 처리)
+        if (opts->jobs > 1 && !opts->interactive) {
+            return remove_tree_parallel(dirfd, name, path->data, opts);
+        }
+        return remove_directory_at(dirfd, name, path, opts);
+    }
+    
+    // --dry-run: 계획에 더하기만 함 (최상위 피연산자이므로 st는 lstat 전체 정보)
+    if (dry_run_plan) {
+        plan_add_entry(dry_run_plan, st);
+        return 0;
     }
     
-    // 4단계: 대화형 확인 (-i 옵션)
-    if (opts->interactive && !get_user_confirmation(filepath)) {
+    // 대화형 확인 (-i 옵션)
+    if (opts->interactive && !get_user_confirmation(path->data)) {
         return 0;  // 사용자가 삭제를 거부하면 성공으로 처리 (에러가 아님)
     }
     
-    // 5단계: 실제 파일 삭제
-    if (unlink(filepath) != 0) {
-        // unlink() 시스템 콜 실패시
+    // 실제 파일 삭제 (디렉토리 fd 기준)
+    if (unlinkat(dirfd, name, 0) != 0) {
+        // unlinkat() 시스템 콜 실패시
         if (!opts->force) {
-            fprintf(stderr, "rm: cannot remove '%s': %s\n", filepath, strerror(errno));
+            fprintf(stderr, "rm: cannot remove '%s': %s\n", path->data, strerror(errno));
         }
         // force 모드에서는 삭제 실패도 성공으로 처리
         return opts->force ? 0 : -1;
     }
     
-    // 6단계: verbose 출력 (-v 옵션)
+    // verbose 출력 (-v 옵션)
     if (opts->verbose) {
-        printf("removed '%s'\n", filepath);
+        printf("removed '%s'\n", path->data);
     }
     
     return 0;  // 성공
 }
 
+/**
+ * 파일 삭제 함수 (메인 삭제 로직)
+ * @param filepath 삭제할 파일/디렉토리 경로
+ * @param opts 삭제 옵션 구조체
+ * @return 0: 성공(필터로 남긴 경우 포함), -1: 실패
+ * 
+ * 명령행에 주어진 경로 하나를 삭제하는 함수
+ * 경로는 lstat으로 한 번만 해석하며, 심볼릭 링크는 따라가지 않으므로
+ * 디렉토리를 가리키는 링크는 링크 자체만 삭제됨 (-r이어도 대상은 건드리지 않음)
+ */
+int remove_file(const char *filepath, const rm_options_t *opts) {
+    // 1단계: lstat 한 번으로 존재 여부와 타입 확인
+    struct stat st;
+    if (lstat(filepath, &st) != 0) {
+        // 파일이 존재하지 않거나 접근할 수 없는 경우
+        if (!opts->force) {
+            // force 모드가 아니면 에러 메시지 출력
+            fprintf(stderr, "rm: cannot remove '%s': %s\n", filepath, strerror(errno));
+        }
+        // force 모드에서는 존재하지 않는 파일을 무시하고 성공으로 처리
+        return opts->force ? 0 : -1;
+    }
+    
+    // 2단계: --trash면 휴지통으로 옮기고 끝 (휴지통을 쓸 수 없으면 바로 삭제)
+    // 계획 중이거나 필터가 있으면 (트리 일부만 지워야 하므로) 옮기지 않음
+    if (opts->trash && !dry_run_plan && !filter_active(opts)) {
+        int trashed = trash_file(filepath, &st, opts);
+        if (trashed <= 0) {
+            return trashed;
+        }
+    }
+    
+    // 3단계: 메시지용 경로 버퍼를 만들고 현재 디렉토리 기준으로 삭제
+    path_buf_t path = { NULL, 0, 0 };
+    if (path_push(&path, filepath) == (size_t)-1) {
+        fprintf(stderr, "rm: memory allocation failed\n");
+        return -1;
+    }
+    int result = remove_entry_at(AT_FDCWD, filepath, &st, &path, opts);
+    free(path.data);
+    
+    return result < 0 ? -1 : 0;
+}
+
 /**
  * 메인 함수 - 프로그램 진입점
  * @param argc 명령행 인자 개수
@@ -260,7 +358,32 @@ int main(int argc, char *argv[]) {
         return 1;
     }
     
-    // 5단계: 지정된 모든 파일/디렉토리에 대해 삭제 수행
+    // 5단계: --dry-run이나 -I면 삭제와 같은 엔진으로 계획을 세워 디렉토리별 합계 출력
+    if (opts.dry_run || opts.confirm_once) {
+        rm_plan_t plan;
+        plan_init(&plan);
+        dry_run_plan = &plan;
+        for (int i = file_start_index; i < argc; i++) {
+            if (remove_file(argv[i], &opts) != 0) {
+                result = 1;
+            }
+        }
+        dry_run_plan = NULL;
+        plan_report(&plan);
+        
+        // -n이면 여기서 끝, -I면 지울 것이 있을 때 한 번만 확인하고 확인 없이 삭제
+        if (opts.dry_run || atomic_load(&plan.files) + atomic_load(&plan.dirs) == 0) {
+            return result;
+        }
+        printf("rm: remove the files listed above? ");
+        if (!read_confirmation()) {
+            return result;
+        }
+        opts.interactive = false;
+        result = 0;
+    }
+    
+    // 6단계: 지정된 모든 파일/디렉토리에 대해 삭제 수행
     for (int i = file_start_index; i < argc; i++) {
         if (remove_file(argv[i], &opts) != 0) {
             result = 1;  // 하나라도 실패하면 전체 결과를 실패로 설정
@@ -268,5 +391,8 @@ int main(int argc, char *argv[]) {
         }
     }
     
+    // 7단계: --trash로 옮긴 항목들을 백그라운드에서 삭제 (기다리지 않음)
+    trash_start_reaper(&opts);
+    
     return result;  // 전체 실행 결과 반환
-}
\ No newline at end of file
+}
@@ -0,0 +1,54 @@
+#include "rm_filter.h"
+#include <string.h>
+#include <fnmatch.h>
+
+bool filter_active(const rm_options_t *opts) {
+    return opts->include_count > 0 || opts->exclude_count > 0 || filter_needs_stat(opts);
+}
+
+bool filter_needs_stat(const rm_options_t *opts) {
+    return opts->min_size >= 0 || opts->max_size >= 0 || opts->min_age >= 0 || opts->max_age >= 0;
+}
+
+/**
+ * 이름이 글롭 목록 중 하나와 맞는지 확인하는 내부 함수
+ */
+static bool match_any(const char *const *globs, int count, const char *name) {
+    for (int i = 0; i < count; i++) {
+        if (fnmatch(globs[i], name, 0) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool filter_accepts(const rm_options_t *opts, const char *name, const struct stat *st) {
+    // 경로로 주어진 최상위 피연산자는 마지막 구성 요소에 맞춤 ("dir/"처럼 끝나면 전체 사용)
+    const char *slash = strrchr(name, '/');
+    if (slash && slash[1] != '\0') {
+        name = slash + 1;
+    }
+
+    if (match_any(opts->excludes, opts->exclude_count, name)) {
+        return false;
+    }
+    if (S_ISDIR(st->st_mode)) {
+        return true;  // 나머지 조건은 디렉토리 안의 항목에 적용
+    }
+
+    if (opts->include_count > 0 && !match_any(opts->includes, opts->include_count, name)) {
+        return false;
+    }
+    if ((opts->min_size >= 0 && st->st_size < opts->min_size) ||
+        (opts->max_size >= 0 && st->st_size > opts->max_size)) {
+        return false;
+    }
+
+    // 나이는 수정 시각 기준 (--older-than N: N초 이상 지남, --newer-than N: N초 미만)
+    long long age = (long long)opts->now - (long long)st->st_mtime;
+    if ((opts->min_age >= 0 && age < opts->min_age) ||
+        (opts->max_age >= 0 && age >= opts->max_age)) {
+        return false;
+    }
+    return true;
+}
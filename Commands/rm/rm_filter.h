@@ -0,0 +1,35 @@
+#ifndef RM_FILTER_H
+#define RM_FILTER_H
+
+#include "rm_options.h"
+#include <stdbool.h>
+#include <sys/stat.h>
+
+/**
+ * 필터 옵션(--include, --exclude, 나이, 크기)이 하나라도 지정되었는지 확인
+ * @param opts 삭제 옵션
+ * @return true: 필터가 있음 (걸러진 항목이 남은 디렉토리는 삭제하지 않음)
+ */
+bool filter_active(const rm_options_t *opts);
+
+/**
+ * 필터를 판단하는 데 lstat 전체 정보(크기, 수정 시각)가 필요한지 확인
+ * @param opts 삭제 옵션
+ * @return true: 나이나 크기 조건이 있음, false: 이름과 타입만으로 판단 가능
+ */
+bool filter_needs_stat(const rm_options_t *opts);
+
+/**
+ * 항목을 삭제할지 필터로 판단하는 함수
+ *
+ * 디렉토리는 --exclude에 걸릴 때만 (하위 트리 전체가) 남기고, 그 외의 조건은
+ * 디렉토리가 아닌 항목에만 적용함. 글롭은 마지막 경로 구성 요소에 맞춤.
+ *
+ * @param opts 삭제 옵션
+ * @param name 항목 이름 (경로면 마지막 구성 요소를 사용)
+ * @param st 항목의 상태 정보 (filter_needs_stat이 false면 st_mode의 타입 부분만 사용)
+ * @return true: 삭제 대상, false: 남김
+ */
+bool filter_accepts(const rm_options_t *opts, const char *name, const struct stat *st);
+
+#endif // RM_FILTER_H
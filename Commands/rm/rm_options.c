@@ -2,6 +2,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <limits.h>
 
 /**
  * 옵션 구조체 초기화
@@ -16,6 +17,19 @@ void init_options(rm_options_t *opts) {
     opts->interactive = false;   // -i: 대화형 모드 비활성화
     opts->verbose = false;       // -v: 상세 출력 비활성화
     opts->zero_only = false;     // -z: 0바이트 파일만 삭제 비활성화
+    opts->trash = false;         // -T: 휴지통 모드 비활성화
+    opts->dry_run = false;       // -n: 실제로 삭제
+    opts->confirm_once = false;  // -I: 한 번에 확인하지 않음
+    opts->includes = NULL;       // --include: 모든 파일
+    opts->include_count = 0;
+    opts->excludes = NULL;       // --exclude: 제외 없음
+    opts->exclude_count = 0;
+    opts->min_size = -1;         // 크기 제한 없음
+    opts->max_size = -1;
+    opts->min_age = -1;          // 나이 제한 없음
+    opts->max_age = -1;
+    opts->now = time(NULL);
+    opts->jobs = 0;              // -j: 순차 삭제
 }
 
 /**
@@ -34,7 +48,21 @@ void print_usage(const char *program_name) {
     printf("  -i, --interactive prompt before every removal\n");
     printf("  -v, --verbose     explain what is being done\n");
     printf("  -z, --zero        remove only zero-byte files\n");
-    printf("\nOptions can be combined (e.g., -rzv)\n");
+    printf("  -j, --jobs=N      with -r, remove directory trees using N parallel workers\n");
+    printf("  -T, --trash       move FILEs into a per-filesystem trash directory and return\n");
+    printf("                    immediately; a low-priority background process deletes them\n");
+    printf("  -n, --dry-run     remove nothing; print per-directory totals and how many files\n");
+    printf("                    and bytes would be removed (hard links counted once)\n");
+    printf("  -I                show the per-directory plan and prompt once before removing\n");
+    printf("\nFilters (directories left non-empty by a filter are kept):\n");
+    printf("  --include=GLOB    remove only files whose name matches GLOB (repeatable)\n");
+    printf("  --exclude=GLOB    keep files and whole directories whose name matches GLOB\n");
+    printf("  --min-size=SIZE   keep files smaller than SIZE (suffixes K, M, G, T)\n");
+    printf("  --max-size=SIZE   keep files larger than SIZE\n");
+    printf("  --older-than=AGE  keep files modified less than AGE ago (units s, m, h, d, w;\n");
+    printf("                    default d)\n");
+    printf("  --newer-than=AGE  keep files modified AGE or more ago\n");
+    printf("\nOptions can be combined (e.g., -rzv, -rfj8)\n");
 }
 
 /**
@@ -62,6 +90,15 @@ static void process_option_char(char opt, rm_options_t *opts) {
         case 'z':
             opts->zero_only = true;    // 0바이트 파일만 삭제 활성화
             break;
+        case 'T':
+            opts->trash = true;        // 휴지통 모드 활성화
+            break;
+        case 'n':
+            opts->dry_run = true;      // 삭제 계획만 출력
+            break;
+        case 'I':
+            opts->confirm_once = true; // 계획을 보여 주고 한 번만 확인
+            break;
         default:
             // 지원하지 않는 옵션이 입력된 경우
             fprintf(stderr, "Invalid option: -%c\n", opt);
@@ -69,6 +106,88 @@ static void process_option_char(char opt, rm_options_t *opts) {
     }
 }
 
+/**
+ * 작업 스레드 수 인자 파싱 (-j, --jobs)
+ * @param value 인자 문자열
+ * @param opts 설정할 옵션 구조체 포인터
+ * @return 0: 성공, -1: 잘못된 값
+ */
+static int parse_jobs(const char *value, rm_options_t *opts) {
+    char *end;
+    long jobs = value ? strtol(value, &end, 10) : 0;
+    if (!value || end == value || *end != '\0' || jobs < 1 || jobs > 1024) {
+        fprintf(stderr, "rm: invalid number of jobs: '%s'\n", value ? value : "");
+        return -1;
+    }
+    opts->jobs = (int)jobs;
+    return 0;
+}
+
+/**
+ * 글롭 목록에 패턴 하나를 추가 (--include, --exclude)
+ * @param list 글롭 목록
+ * @param count 목록의 패턴 수
+ * @param glob 추가할 패턴 (argv 안을 가리키므로 복사하지 않음)
+ */
+static void add_glob(const char ***list, int *count, const char *glob) {
+    const char **grown = realloc(*list, (*count + 1) * sizeof(char *));
+    if (!grown) {
+        fprintf(stderr, "rm: memory allocation failed\n");
+        exit(1);
+    }
+    grown[(*count)++] = glob;
+    *list = grown;
+}
+
+/**
+ * 크기 인자 파싱 (--min-size, --max-size)
+ * @param value 인자 문자열 (숫자 뒤에 K, M, G, T 단위 가능, 1024 배수)
+ * @param out 바이트 단위 결과
+ * @return 0: 성공, -1: 잘못된 값
+ */
+static int parse_size(const char *value, long long *out) {
+    char *end;
+    long long size = strtoll(value, &end, 10);
+    int shift = 0;
+    switch (*end) {
+        case 'k': case 'K': shift = 10; end++; break;
+        case 'm': case 'M': shift = 20; end++; break;
+        case 'g': case 'G': shift = 30; end++; break;
+        case 't': case 'T': shift = 40; end++; break;
+    }
+    if (end == value || *end != '\0' || size < 0 || size > (LLONG_MAX >> shift)) {
+        fprintf(stderr, "rm: invalid size: '%s'\n", value);
+        return -1;
+    }
+    *out = size << shift;
+    return 0;
+}
+
+/**
+ * 나이 인자 파싱 (--older-than, --newer-than)
+ * @param value 인자 문자열 (숫자 뒤에 s, m, h, d, w 단위 가능, 없으면 일)
+ * @param out 초 단위 결과
+ * @return 0: 성공, -1: 잘못된 값
+ */
+static int parse_age(const char *value, long long *out) {
+    char *end;
+    long long age = strtoll(value, &end, 10);
+    long long unit = 86400;
+    switch (*end) {
+        case 's': unit = 1; end++; break;
+        case 'm': unit = 60; end++; break;
+        case 'h': unit = 3600; end++; break;
+        case 'd': unit = 86400; end++; break;
+        case 'w': unit = 7 * 86400; end++; break;
+    }
+    if (end == value || *end != '\0' || age < 0 || age > LLONG_MAX / unit) {
+        fprintf(stderr, "rm: invalid age: '%s'\n", value);
+        return -1;
+    }
+    *out = age * unit;
+    return 0;
+}
+
 /**
  * 옵션 파싱 함수
  * @param argc 명령행 인자 개수
@@ -111,6 +230,38 @@ int parse_options(int argc, char *argv[], rm_options_t *opts, int *file_start_in
                 opts->verbose = true;
             } else if (strcmp(long_opt, "zero") == 0) {
                 opts->zero_only = true;
+            } else if (strcmp(long_opt, "trash") == 0) {
+                opts->trash = true;
+            } else if (strcmp(long_opt, "dry-run") == 0) {
+                opts->dry_run = true;
+            } else if (strncmp(long_opt, "include=", 8) == 0) {
+                add_glob(&opts->includes, &opts->include_count, long_opt + 8);
+            } else if (strncmp(long_opt, "exclude=", 8) == 0) {
+                add_glob(&opts->excludes, &opts->exclude_count, long_opt + 8);
+            } else if (strncmp(long_opt, "min-size=", 9) == 0) {
+                if (parse_size(long_opt + 9, &opts->min_size) != 0) {
+                    return -1;
+                }
+            } else if (strncmp(long_opt, "max-size=", 9) == 0) {
+                if (parse_size(long_opt + 9, &opts->max_size) != 0) {
+                    return -1;
+                }
+            } else if (strncmp(long_opt, "older-than=", 11) == 0) {
+                if (parse_age(long_opt + 11, &opts->min_age) != 0) {
+                    return -1;
+                }
+            } else if (strncmp(long_opt, "newer-than=", 11) == 0) {
+                if (parse_age(long_opt + 11, &opts->max_age) != 0) {
+                    return -1;
+                }
+            } else if (strncmp(long_opt, "jobs=", 5) == 0) {
+                if (parse_jobs(long_opt + 5, opts) != 0) {
+                    return -1;
+                }
+            } else if (strcmp(long_opt, "jobs") == 0) {
+                if (parse_jobs(i + 1 < argc ? argv[++i] : NULL, opts) != 0) {
+                    return -1;
+                }
             } else if (strcmp(long_opt, "help") == 0) {
                 // 도움말 요청시 사용법 출력 후 정상 종료
                 print_usage(argv[0]);
@@ -133,6 +284,14 @@ int parse_options(int argc, char *argv[], rm_options_t *opts, int *file_start_in
                     print_usage(argv[0]);
                     exit(0);
                 }
+                if (opt_str[j] == 'j') {
+                    // 인자가 필요한 옵션: "-j4"처럼 붙여 쓰거나 다음 인자로 지정
+                    const char *value = opt_str[j + 1] != '\0' ? opt_str + j + 1 : (i + 1 < argc ? argv[++i] : NULL);
+                    if (parse_jobs(value, opts) != 0) {
+                        return -1;
+                    }
+                    break;  // 나머지 문자는 인자이므로 처리 완료
+                }
                 // 각 옵션 문자를 개별적으로 처리
                 process_option_char(opt_str[j], opts);
             }
@@ -142,4 +301,33 @@ int parse_options(int argc, char *argv[], rm_options_t *opts, int *file_start_in
     // 파일 인자가 시작되는 인덱스를 반환 인자에 저장
     *file_start_index = i;
     return 0;  // 성공
+}
+
+/**
+ * 프롬프트에 대한 사용자 응답 읽기
+ * @return true: 사용자가 'y' 또는 'Y' 입력시, false: 그 외의 경우
+ */
+bool read_confirmation(void) {
+    fflush(stdout);  // 출력 버퍼를 즉시 비워서 프롬프트가 바로 표시되도록 함
+    
+    char response[10];
+    if (fgets(response, sizeof(response), stdin) == NULL) {
+        return false;  // 입력 오류 시 삭제하지 않음
+    }
+    
+    // 첫 번째 문자가 'y' 또는 'Y'인 경우에만 삭제 승인
+    return (response[0] == 'y' || response[0] == 'Y');
+}
+
+/**
+ * 사용자 확인 입력 받기
+ * @param filepath 삭제할 파일의 경로
+ * @return true: 사용자가 'y' 또는 'Y' 입력시, false: 그 외의 경우
+ * 
+ * 대화형 모드(-i 옵션)에서 파일을 삭제하기 전에 사용자에게 확인을 요청하는 함수
+ * "rm: remove 'filename'? " 형태로 출력하고 사용자 입력을 기다림
+ */
+bool get_user_confirmation(const char *filepath) {
+    printf("rm: remove '%s'? ", filepath);
+    return read_confirmation();
 }
\ No newline at end of file
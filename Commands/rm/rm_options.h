@@ -2,6 +2,7 @@
 #define RM_OPTIONS_H
 
 #include <stdbool.h>
+#include <time.h>
 
 /**
  * rm 명령어 옵션을 저장하는 구조체
@@ -15,6 +16,19 @@ typedef struct {
     bool interactive;   // -i, --interactive: 각 삭제 전에 사용자 확인 요청
     bool verbose;       // -v, --verbose: 수행되는 작업에 대한 상세한 설명 출력
     bool zero_only;     // -z, --zero: 0바이트 파일만 삭제 (사용자 정의 옵션)
+    bool trash;         // -T, --trash: 바로 삭제하지 않고 휴지통으로 옮긴 뒤 백그라운드에서 삭제
+    bool dry_run;       // -n, --dry-run: 아무것도 삭제하지 않고 삭제될 항목 수와 크기만 출력
+    bool confirm_once;  // -I: 삭제 계획(디렉토리별 합계)을 보여 주고 한 번만 확인한 뒤 삭제
+    const char **includes;  // --include=GLOB: 이름이 하나라도 맞는 파일만 삭제 (디렉토리 제외)
+    int include_count;
+    const char **excludes;  // --exclude=GLOB: 이름이 맞는 항목은 남김 (디렉토리면 하위 트리 전체)
+    int exclude_count;
+    long long min_size;     // --min-size=SIZE: 이보다 작은 파일은 남김 (-1이면 제한 없음)
+    long long max_size;     // --max-size=SIZE: 이보다 큰 파일은 남김 (-1이면 제한 없음)
+    long long min_age;      // --older-than=AGE: 수정된 지 이 초 미만인 파일은 남김 (-1이면 제한 없음)
+    long long max_age;      // --newer-than=AGE: 수정된 지 이 초 이상인 파일은 남김 (-1이면 제한 없음)
+    time_t now;             // 나이 계산 기준 시각 (init_options에서 한 번 정함)
+    int jobs;           // -j N, --jobs=N: -r에서 디렉토리 트리를 N개 스레드로 병렬 삭제 (1 이하면 순차)
 } rm_options_t;
 
 /**
@@ -48,4 +62,22 @@ int parse_options(int argc, char *argv[], rm_options_t *opts, int *file_start_in
  */
 void print_usage(const char *program_name);
 
+/**
+ * 프롬프트에 대한 사용자 응답 읽기
+ * @return true: 사용자가 'y' 또는 'Y' 입력시, false: 그 외의 경우
+ * 
+ * 프롬프트를 출력한 뒤 호출하며, 표준 출력을 먼저 비워서 프롬프트가 바로 보이게 함
+ */
+bool read_confirmation(void);
+
+/**
+ * 사용자 확인 입력 받기
+ * @param filepath 삭제할 파일의 경로
+ * @return true: 사용자가 'y' 또는 'Y' 입력시, false: 그 외의 경우
+ * 
+ * 대화형 모드(-i 옵션)에서 "rm: remove 'filename'? " 형태로 묻고 사용자 입력을 기다림
+ * 바로 삭제할 때와 휴지통으로 옮길 때(-T) 모두 이 함수로 확인함
+ */
+bool get_user_confirmation(const char *filepath);
+
 #endif
\ No newline at end of file
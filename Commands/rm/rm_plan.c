@@ -0,0 +1,180 @@
+#include "rm_plan.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+void plan_init(rm_plan_t *plan) {
+    memset(plan, 0, sizeof(*plan));
+    atomic_init(&plan->files, 0);
+    atomic_init(&plan->dirs, 0);
+    atomic_init(&plan->bytes, 0);
+    atomic_init(&plan->freed_bytes, 0);
+    atomic_init(&plan->freed_blocks, 0);
+    pthread_mutex_init(&plan->dir_lock, NULL);
+    for (int i = 0; i < PLAN_INODE_SHARDS; i++) {
+        pthread_mutex_init(&plan->shards[i].lock, NULL);
+    }
+}
+
+/**
+ * (dev, ino)를 해시하는 내부 함수
+ */
+static size_t inode_hash(dev_t dev, ino_t ino) {
+    unsigned long long h = (unsigned long long)ino * 0x9E3779B97F4A7C15ULL;
+    h ^= (unsigned long long)dev + (h >> 29);
+    return (size_t)(h ^ (h >> 32));
+}
+
+/**
+ * 샤드 테이블에서 (dev, ino)의 칸을 찾거나 빈 칸을 돌려주는 내부 함수 (lock을 잡은 상태에서 호출)
+ */
+static plan_inode_t *shard_slot(plan_shard_t *shard, dev_t dev, ino_t ino, size_t hash) {
+    size_t mask = shard->cap - 1;
+    for (size_t i = hash & mask; ; i = (i + 1) & mask) {
+        plan_inode_t *slot = &shard->slots[i];
+        if (slot->ino == 0 || (slot->ino == ino && slot->dev == dev)) {
+            return slot;
+        }
+    }
+}
+
+/**
+ * 하드링크된 파일의 링크를 하나 기록하는 내부 함수
+ * @return 이 inode를 처음 만났으면 1 (크기를 셈), 이미 만났으면 0
+ */
+static int record_link(rm_plan_t *plan, const struct stat *st) {
+    size_t hash = inode_hash(st->st_dev, st->st_ino);
+    plan_shard_t *shard = &plan->shards[hash % PLAN_INODE_SHARDS];
+    hash /= PLAN_INODE_SHARDS;
+
+    pthread_mutex_lock(&shard->lock);
+
+    // 사용률이 절반을 넘으면 테이블을 두 배로 키움
+    if ((shard->count + 1) * 2 > shard->cap) {
+        plan_shard_t grown = *shard;
+        grown.cap = shard->cap ? shard->cap * 2 : 64;
+        grown.slots = calloc(grown.cap, sizeof(plan_inode_t));
+        if (!grown.slots) {
+            fprintf(stderr, "rm: memory allocation failed\n");
+            exit(1);
+        }
+        for (size_t i = 0; i < shard->cap; i++) {
+            plan_inode_t *old = &shard->slots[i];
+            if (old->ino != 0) {
+                *shard_slot(&grown, old->dev, old->ino,
+                            inode_hash(old->dev, old->ino) / PLAN_INODE_SHARDS) = *old;
+            }
+        }
+        free(shard->slots);
+        shard->slots = grown.slots;
+        shard->cap = grown.cap;
+    }
+
+    plan_inode_t *slot = shard_slot(shard, st->st_dev, st->st_ino, hash);
+    int first = slot->ino == 0;
+    if (first) {
+        slot->dev = st->st_dev;
+        slot->ino = st->st_ino;
+        slot->nlink = st->st_nlink;
+        slot->size = st->st_size;
+        slot->blocks = st->st_blocks;
+        shard->count++;
+    }
+    slot->seen++;
+    pthread_mutex_unlock(&shard->lock);
+    return first;
+}
+
+long long plan_add_entry(rm_plan_t *plan, const struct stat *st) {
+    if (S_ISDIR(st->st_mode)) {
+        atomic_fetch_add(&plan->dirs, 1);
+    } else {
+        atomic_fetch_add(&plan->files, 1);
+    }
+
+    // 하드링크된 파일은 처음 만났을 때만 크기를 셈 (해제 여부는 보고할 때 판단)
+    // inode 0은 빈 칸 표시로 쓰므로 중복 제거 대상에서 제외
+    if (!S_ISDIR(st->st_mode) && st->st_nlink > 1 && st->st_ino != 0) {
+        if (!record_link(plan, st)) {
+            return 0;
+        }
+    } else {
+        atomic_fetch_add(&plan->freed_bytes, st->st_size);
+        atomic_fetch_add(&plan->freed_blocks, st->st_blocks);
+    }
+    atomic_fetch_add(&plan->bytes, st->st_size);
+    return st->st_size;
+}
+
+void plan_add_dir(rm_plan_t *plan, const char *path, long long bytes, long long files) {
+    char *copy = strdup(path);
+    if (!copy) {
+        fprintf(stderr, "rm: memory allocation failed\n");
+        exit(1);
+    }
+
+    pthread_mutex_lock(&plan->dir_lock);
+    if (plan->dir_count == plan->dir_cap) {
+        plan->dir_cap = plan->dir_cap ? plan->dir_cap * 2 : 64;
+        plan_dir_t *grown = realloc(plan->dir_list, plan->dir_cap * sizeof(plan_dir_t));
+        if (!grown) {
+            fprintf(stderr, "rm: memory allocation failed\n");
+            exit(1);
+        }
+        plan->dir_list = grown;
+    }
+    plan->dir_list[plan->dir_count].path = copy;
+    plan->dir_list[plan->dir_count].bytes = bytes;
+    plan->dir_list[plan->dir_count].files = files;
+    plan->dir_count++;
+    pthread_mutex_unlock(&plan->dir_lock);
+}
+
+/**
+ * 디렉토리별 합계를 경로순으로 정렬하기 위한 비교 함수
+ */
+static int compare_dirs(const void *a, const void *b) {
+    return strcmp(((const plan_dir_t *)a)->path, ((const plan_dir_t *)b)->path);
+}
+
+void plan_report(rm_plan_t *plan) {
+    long long freed_bytes = atomic_load(&plan->freed_bytes);
+    long long freed_blocks = atomic_load(&plan->freed_blocks);
+    long long kept_bytes = 0;
+
+    // 하드링크: 모든 링크가 삭제 대상 안에 있어야 공간이 해제됨
+    for (int i = 0; i < PLAN_INODE_SHARDS; i++) {
+        plan_shard_t *shard = &plan->shards[i];
+        for (size_t j = 0; j < shard->cap; j++) {
+            plan_inode_t *slot = &shard->slots[j];
+            if (slot->ino == 0) {
+                continue;
+            }
+            if (slot->seen >= slot->nlink) {
+                freed_bytes += slot->size;
+                freed_blocks += slot->blocks;
+            } else {
+                kept_bytes += slot->size;
+            }
+        }
+        free(shard->slots);
+        pthread_mutex_destroy(&shard->lock);
+    }
+
+    // 디렉토리별 합계 (경로순, 바이트와 항목 수)
+    qsort(plan->dir_list, plan->dir_count, sizeof(plan_dir_t), compare_dirs);
+    for (size_t i = 0; i < plan->dir_count; i++) {
+        printf("%12lld %9lld  %s\n", plan->dir_list[i].bytes, plan->dir_list[i].files,
+               plan->dir_list[i].path);
+        free(plan->dir_list[i].path);
+    }
+    free(plan->dir_list);
+    pthread_mutex_destroy(&plan->dir_lock);
+
+    printf("would remove %lld files and %lld directories (%lld bytes)\n",
+           atomic_load(&plan->files), atomic_load(&plan->dirs), atomic_load(&plan->bytes));
+    printf("would free %lld bytes (%lld bytes on disk)\n", freed_bytes, freed_blocks * 512);
+    if (kept_bytes > 0) {
+        printf("%lld bytes stay allocated through hard links outside the removed files\n", kept_bytes);
+    }
+}
@@ -0,0 +1,93 @@
+#ifndef RM_PLAN_H
+#define RM_PLAN_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+// 하드링크 중복 제거용 (dev, ino) 집합의 샤드 개수 (스레드 간 잠금 경쟁 분산)
+#define PLAN_INODE_SHARDS 64
+
+/**
+ * 하드링크된 inode 하나 (st_nlink > 1인 파일만 기록)
+ */
+typedef struct {
+    dev_t dev;                  // 장치 번호
+    ino_t ino;                  // inode 번호 (0이면 빈 칸)
+    nlink_t nlink;              // 전체 링크 수
+    nlink_t seen;               // 삭제 대상 안에서 만난 링크 수
+    off_t size;                 // 파일 크기
+    blkcnt_t blocks;            // 512바이트 블록 수
+} plan_inode_t;
+
+/**
+ * (dev, ino) 집합의 샤드 하나 (열린 주소법 해시 테이블)
+ */
+typedef struct {
+    pthread_mutex_t lock;
+    plan_inode_t *slots;        // 테이블 (크기 cap, 2의 거듭제곱)
+    size_t cap;                 // 테이블 크기
+    size_t count;               // 저장된 inode 수
+} plan_shard_t;
+
+/**
+ * 디렉토리 하나의 하위 트리 합계 (디렉토리별 내역 출력용)
+ */
+typedef struct {
+    char *path;                 // 디렉토리 경로
+    long long bytes;            // 하위 트리의 크기 합계 (하드링크는 처음 만난 곳에서만 셈)
+    long long files;            // 하위 트리의 디렉토리가 아닌 항목 수
+} plan_dir_t;
+
+/**
+ * 삭제 계획 (--dry-run)
+ *
+ * 실제 삭제와 같은 병렬 탐색 엔진(rm_tree)이 항목마다 unlinkat 대신
+ * 이 구조체에 크기를 더함. 여러 피연산자에 걸쳐 하나의 계획을 사용하므로
+ * 하드링크 중복 제거도 전체 삭제 대상 기준임.
+ */
+typedef struct {
+    atomic_llong files;         // 삭제될 디렉토리가 아닌 항목 수
+    atomic_llong dirs;          // 삭제될 디렉토리 수
+    atomic_llong bytes;         // 크기 합계 (하드링크는 한 번만)
+    atomic_llong freed_bytes;   // 실제로 해제될 크기 (링크가 모두 삭제 대상 안에 있는 inode만)
+    atomic_llong freed_blocks;  // 실제로 해제될 512바이트 블록 수
+    pthread_mutex_t dir_lock;   // dir_list 보호
+    plan_dir_t *dir_list;       // 디렉토리별 합계
+    size_t dir_count;           // dir_list 항목 수
+    size_t dir_cap;             // dir_list 크기
+    plan_shard_t shards[PLAN_INODE_SHARDS];
+} rm_plan_t;
+
+/**
+ * 삭제 계획 초기화
+ * @param plan 초기화할 계획
+ */
+void plan_init(rm_plan_t *plan);
+
+/**
+ * 삭제될 항목 하나를 계획에 더하는 함수 (여러 스레드에서 동시에 호출 가능)
+ * @param plan 삭제 계획
+ * @param st 항목의 lstat 정보
+ * @return 디렉토리별 합계에 더할 크기 (이미 센 하드링크면 0)
+ */
+long long plan_add_entry(rm_plan_t *plan, const struct stat *st);
+
+/**
+ * 디렉토리 하나의 하위 트리 합계를 기록하는 함수 (여러 스레드에서 동시에 호출 가능)
+ * @param plan 삭제 계획
+ * @param path 디렉토리 경로
+ * @param bytes 하위 트리의 크기 합계
+ * @param files 하위 트리의 디렉토리가 아닌 항목 수
+ */
+void plan_add_dir(rm_plan_t *plan, const char *path, long long bytes, long long files);
+
+/**
+ * 디렉토리별 합계(경로순)와 전체 요약을 표준 출력에 출력하고 계획의 메모리를 해제
+ * @param plan 삭제 계획
+ */
+void plan_report(rm_plan_t *plan);
+
+#endif // RM_PLAN_H
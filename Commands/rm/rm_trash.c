@@ -0,0 +1,506 @@
+#include "rm_trash.h"
+#include "rm_tree.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <time.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/file.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+
+// I/O 우선순위 (linux/ioprio.h, 헤더가 없는 환경을 위해 직접 정의)
+#ifndef IOPRIO_CLASS_IDLE
+#define IOPRIO_CLASS_IDLE 3
+#endif
+#ifndef IOPRIO_CLASS_SHIFT
+#define IOPRIO_CLASS_SHIFT 13
+#endif
+#ifndef IOPRIO_WHO_PROCESS
+#define IOPRIO_WHO_PROCESS 1
+#endif
+
+#ifndef RENAME_NOREPLACE
+#define RENAME_NOREPLACE (1 << 0)
+#endif
+
+// 이번 실행에서 항목을 옮긴 휴지통들 (정리 프로세스에 넘김)
+static char **trash_dirs = NULL;
+static int trash_dir_count = 0;
+
+/**
+ * 이름 목록 (정리 프로세스가 지우지 못한 휴지통 항목들, 정렬해서 이진 탐색)
+ */
+typedef struct {
+    char **names;
+    int count;
+    int cap;
+} name_list_t;
+
+/**
+ * 휴지통 목록에 경로를 추가하는 함수 (이미 있으면 추가하지 않음)
+ * @return 새로 추가했으면 true
+ */
+static bool remember_trash(const char *trash) {
+    for (int i = 0; i < trash_dir_count; i++) {
+        if (strcmp(trash_dirs[i], trash) == 0) {
+            return false;
+        }
+    }
+    char **grown = realloc(trash_dirs, (trash_dir_count + 1) * sizeof(char *));
+    char *copy = strdup(trash);
+    if (!grown || !copy) {
+        fprintf(stderr, "rm: memory allocation failed\n");
+        exit(1);
+    }
+    trash_dirs = grown;
+    trash_dirs[trash_dir_count++] = copy;
+    return true;
+}
+
+/**
+ * 이전 정리 프로세스가 지우지 못한 항목이 휴지통에 남아 있으면 경고하는 함수
+ */
+static void warn_reap_failures(const char *trash) {
+    char log_path[PATH_MAX];
+    snprintf(log_path, sizeof(log_path), "%s/%s", trash, RM_TRASH_FAILED_LOG);
+    FILE *log = fopen(log_path, "r");
+    if (!log) {
+        return;
+    }
+    int lines = 0;
+    int c;
+    while ((c = getc(log)) != EOF) {
+        if (c == '\n') {
+            lines++;
+        }
+    }
+    fclose(log);
+    if (lines > 0) {
+        fprintf(stderr, "rm: warning: %d item(s) in trash '%s' could not be removed earlier (see %s)\n",
+                lines, trash, log_path);
+    }
+}
+
+/**
+ * 경로의 상위 디렉토리를 절대 경로로 구하는 함수 ("a/b/" → 현재 디렉토리 기준 "a"의 실제 경로)
+ * @return 성공시 0, 실패시 -1
+ */
+static int parent_realpath(const char *filepath, char *out) {
+    char copy[PATH_MAX];
+    size_t len = strlen(filepath);
+    if (len >= sizeof(copy)) {
+        errno = ENAMETOOLONG;
+        return -1;
+    }
+    memcpy(copy, filepath, len + 1);
+
+    // 끝의 '/'들과 마지막 이름을 떼어냄
+    while (len > 1 && copy[len - 1] == '/') {
+        copy[--len] = '\0';
+    }
+    char *slash = strrchr(copy, '/');
+    const char *parent = ".";
+    if (slash == copy) {
+        parent = "/";
+    } else if (slash) {
+        *slash = '\0';
+        parent = copy;
+    }
+    return realpath(parent, out) ? 0 : -1;
+}
+
+/**
+ * 절대 경로 dir에서 위로 올라가며 같은 장치인 가장 위의 디렉토리(마운트 지점)를 찾는 함수
+ * 결과는 dir 버퍼에 덮어씀
+ */
+static void find_mount_root(char *dir, dev_t dev) {
+    struct stat st;
+    for (;;) {
+        char *slash = strrchr(dir, '/');
+        if (!slash || (slash == dir && dir[1] == '\0')) {
+            return;  // 이미 "/"
+        }
+        char saved = slash == dir ? dir[1] : '\0';
+        if (slash == dir) {
+            dir[1] = '\0';  // "/x" → "/"
+        } else {
+            *slash = '\0';
+        }
+        if (stat(dir, &st) != 0 || st.st_dev != dev) {
+            // 다른 파일시스템: 잘라낸 부분을 되돌리고 멈춤
+            if (slash == dir) {
+                dir[1] = saved;
+            } else {
+                *slash = '/';
+            }
+            return;
+        }
+    }
+}
+
+/**
+ * base 디렉토리 안에 사용자별 휴지통을 만들거나 확인하는 함수
+ * 심볼릭 링크이거나 다른 사용자의 디렉토리면 쓰지 않음
+ * @return 성공시 0, 실패시 -1
+ */
+static int prepare_trash(const char *base, char *trash, size_t size) {
+    struct stat st;
+    int len = snprintf(trash, size, "%s%s%s%u", base, strcmp(base, "/") == 0 ? "" : "/",
+                       RM_TRASH_PREFIX, (unsigned)getuid());
+    if (len < 0 || (size_t)len >= size) {
+        return -1;
+    }
+    if (mkdir(trash, 0700) != 0 && errno != EEXIST) {
+        return -1;
+    }
+    if (lstat(trash, &st) != 0 || !S_ISDIR(st.st_mode) || st.st_uid != getuid()) {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * 경로를 휴지통 안의 겹치지 않는 이름으로 옮기는 함수
+ * RENAME_NOREPLACE로 이미 있는 이름을 덮어쓰지 않으며, 지원하지 않으면 rename으로 대신함
+ * @return 성공시 0, 실패시 -1 (errno 설정)
+ */
+static int move_into_trash(const char *filepath, const char *trash) {
+    char target[PATH_MAX];
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+
+    for (unsigned attempt = 0; attempt < 100; attempt++) {
+        int len = snprintf(target, sizeof(target), "%s/%ld.%09ld.%d.%u", trash,
+                           (long)now.tv_sec, now.tv_nsec, (int)getpid(), attempt);
+        if (len < 0 || (size_t)len >= sizeof(target)) {
+            errno = ENAMETOOLONG;
+            return -1;
+        }
+        if (renameat2(AT_FDCWD, filepath, AT_FDCWD, target, RENAME_NOREPLACE) == 0) {
+            return 0;
+        }
+        if (errno == EINVAL || errno == ENOSYS) {
+            // 파일시스템이나 커널이 RENAME_NOREPLACE를 지원하지 않음 (이름에 pid가 있어 충돌은 드묾)
+            if (access(target, F_OK) == 0) {
+                continue;
+            }
+            return rename(filepath, target);
+        }
+        if (errno != EEXIST) {
+            return -1;
+        }
+    }
+    errno = EEXIST;
+    return -1;
+}
+
+int trash_file(const char *filepath, const struct stat *st, const rm_options_t *opts) {
+    // -z 옵션 처리 (0바이트 파일만 삭제)
+    if (opts->zero_only && !(S_ISREG(st->st_mode) && st->st_size == 0)) {
+        if (opts->verbose) {
+            printf("skipped '%s' (not a zero-byte file)\n", filepath);
+        }
+        return 0;
+    }
+
+    // recursive 옵션 없이 디렉토리를 삭제하려는 경우 에러
+    if (S_ISDIR(st->st_mode) && !opts->recursive) {
+        if (!opts->force) {
+            fprintf(stderr, "rm: cannot remove '%s': Is a directory\n", filepath);
+        }
+        return -1;
+    }
+
+    // 대화형 확인 (-i 옵션)
+    if (opts->interactive && !get_user_confirmation(filepath)) {
+        return 0;  // 사용자가 삭제를 거부하면 성공으로 처리
+    }
+
+    // 1순위: 파일시스템 최상위의 휴지통, 2순위: 상위 디렉토리의 휴지통
+    char parent[PATH_MAX], root[PATH_MAX], trash[PATH_MAX];
+    if (parent_realpath(filepath, parent) != 0) {
+        return 1;
+    }
+    memcpy(root, parent, strlen(parent) + 1);
+    find_mount_root(root, st->st_dev);
+
+    const char *bases[2] = { root, parent };
+    for (int i = 0; i < 2; i++) {
+        if (i == 1 && strcmp(root, parent) == 0) {
+            break;
+        }
+        // 정리 프로세스가 빈 휴지통을 지운 직후일 수 있으므로 ENOENT면 한 번 더 만듦
+        for (int retry = 0; retry < 2; retry++) {
+            if (prepare_trash(bases[i], trash, sizeof(trash)) != 0) {
+                break;
+            }
+            if (move_into_trash(filepath, trash) == 0) {
+                if (remember_trash(trash) && !opts->force) {
+                    warn_reap_failures(trash);
+                }
+                if (opts->verbose) {
+                    printf("moved '%s' to trash '%s'\n", filepath, trash);
+                }
+                return 0;
+            }
+            if (errno == EXDEV) {
+                break;  // bind mount 등으로 최상위가 다른 마운트: 다음 후보로
+            }
+            if (errno != ENOENT) {
+                // 상위 디렉토리 쓰기 권한이 없는 경우 등: 일반 삭제와 같은 오류
+                if (!opts->force) {
+                    fprintf(stderr, "rm: cannot remove '%s': %s\n", filepath, strerror(errno));
+                }
+                return opts->force ? 0 : -1;
+            }
+        }
+    }
+    return 1;  // 휴지통을 쓸 수 없음
+}
+
+/**
+ * 이름 목록 비교 함수 (qsort, bsearch용)
+ */
+static int compare_names(const void *a, const void *b) {
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+/**
+ * 정렬된 이름 목록에 이름이 있는지 확인하는 함수
+ */
+static bool name_listed(const name_list_t *list, const char *name) {
+    return list->count > 0 &&
+           bsearch(&name, list->names, list->count, sizeof(char *), compare_names) != NULL;
+}
+
+/**
+ * 이름 목록에 이름을 추가하는 함수
+ */
+static void name_list_add(name_list_t *list, const char *name) {
+    if (list->count == list->cap) {
+        list->cap = list->cap ? list->cap * 2 : 16;
+        list->names = realloc(list->names, list->cap * sizeof(char *));
+        if (!list->names) {
+            _exit(1);  // 정리 프로세스: 남은 항목은 다음 정리 프로세스가 지움
+        }
+    }
+    list->names[list->count] = strdup(name);
+    if (!list->names[list->count]) {
+        _exit(1);
+    }
+    list->count++;
+}
+
+/**
+ * 이름 목록의 메모리를 해제하는 함수
+ */
+static void name_list_free(name_list_t *list) {
+    for (int i = 0; i < list->count; i++) {
+        free(list->names[i]);
+    }
+    free(list->names);
+    list->names = NULL;
+    list->count = list->cap = 0;
+}
+
+/**
+ * 정리 대상이 아닌 휴지통 안의 이름인지 확인하는 함수 (., .., 실패 기록 파일)
+ */
+static bool is_reserved_name(const char *name) {
+    return strcmp(name, ".") == 0 || strcmp(name, "..") == 0 ||
+           strncmp(name, RM_TRASH_FAILED_LOG, strlen(RM_TRASH_FAILED_LOG)) == 0;
+}
+
+/**
+ * 휴지통의 항목들을 한 번 훑어 지우는 함수 (잠금을 가진 상태에서 호출)
+ * 지우지 못한 항목은 이유와 함께 실패 기록 파일에 쓰고 (없으면 기록 파일을 지움)
+ * 이름을 stuck에 남겨 다음 회차에서 새 항목과 구분함
+ * @param stuck 입력: 이전 회차에서 지우지 못한 이름들, 출력: 이번 회차에서 지우지 못한 이름들
+ * @return 지운 항목이나 새 이름이 있었으면 true (다시 훑을 가치가 있음)
+ */
+static bool reap_pass(int fd, const char *trash, const rm_options_t *opts, name_list_t *stuck) {
+    int scan_fd = dup(fd);
+    DIR *dir = scan_fd >= 0 ? fdopendir(scan_fd) : NULL;
+    if (!dir) {
+        if (scan_fd >= 0) {
+            close(scan_fd);
+        }
+        return false;
+    }
+    rewinddir(dir);  // dup한 fd는 이전 회차와 읽기 위치를 공유하므로 처음부터 다시 읽음
+
+    name_list_t failed = { NULL, 0, 0 };
+    FILE *log = NULL;
+    bool progress = false;
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (is_reserved_name(entry->d_name)) {
+            continue;
+        }
+        if (!name_listed(stuck, entry->d_name)) {
+            progress = true;  // 이전 회차 이후 들어온 항목
+        }
+
+        bool is_dir = entry->d_type == DT_DIR;
+        if (entry->d_type == DT_UNKNOWN) {
+            struct stat st;
+            is_dir = fstatat(fd, entry->d_name, &st, AT_SYMLINK_NOFOLLOW) == 0 && S_ISDIR(st.st_mode);
+        }
+        // -f로 실행하므로 엔진은 실패해도 0을 돌려줌: 항목이 남았는지로 판단
+        const char *reason = NULL;
+        struct stat left;
+        if (is_dir) {
+            char path[PATH_MAX];
+            snprintf(path, sizeof(path), "%s/%s", trash, entry->d_name);
+            remove_tree_parallel(fd, entry->d_name, path, opts);
+            if (fstatat(fd, entry->d_name, &left, AT_SYMLINK_NOFOLLOW) == 0) {
+                reason = "some entries could not be removed";
+            }
+        } else if (unlinkat(fd, entry->d_name, 0) != 0 && errno != ENOENT) {
+            reason = strerror(errno);
+        }
+        if (!reason) {
+            progress = true;
+            continue;
+        }
+
+        name_list_add(&failed, entry->d_name);
+        if (!log) {
+            int log_fd = openat(fd, RM_TRASH_FAILED_LOG ".tmp", O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+            log = log_fd >= 0 ? fdopen(log_fd, "w") : NULL;
+            if (!log && log_fd >= 0) {
+                close(log_fd);
+            }
+        }
+        if (log) {
+            fprintf(log, "%s/%s: %s\n", trash, entry->d_name, reason);
+        }
+    }
+    closedir(dir);
+
+    // 이번 회차의 기록으로 바꿈 (모두 지웠으면 예전 기록도 지움)
+    if (log) {
+        fclose(log);
+        renameat(fd, RM_TRASH_FAILED_LOG ".tmp", fd, RM_TRASH_FAILED_LOG);
+    } else if (failed.count == 0) {
+        unlinkat(fd, RM_TRASH_FAILED_LOG, 0);
+    }
+
+    qsort(failed.names, failed.count, sizeof(char *), compare_names);
+    name_list_free(stuck);
+    *stuck = failed;
+    return progress;
+}
+
+/**
+ * 휴지통에 stuck에 없는 (정리 대상인) 항목이 있는지 확인하는 함수
+ */
+static bool has_new_entries(const char *trash, const name_list_t *stuck) {
+    DIR *dir = opendir(trash);
+    if (!dir) {
+        return false;
+    }
+    struct dirent *entry;
+    bool found = false;
+    while ((entry = readdir(dir)) != NULL) {
+        if (!is_reserved_name(entry->d_name) && !name_listed(stuck, entry->d_name)) {
+            found = true;
+            break;
+        }
+    }
+    closedir(dir);
+    return found;
+}
+
+/**
+ * 휴지통 하나를 비우는 함수 (정리 프로세스에서 실행)
+ * 다른 정리 프로세스가 잠금을 가지고 있으면 그 프로세스에 맡기고 바로 반환
+ */
+static void reap_trash(const char *trash, const rm_options_t *opts) {
+    name_list_t stuck = { NULL, 0, 0 };
+
+    for (;;) {
+        int fd = open(trash, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+        if (fd < 0) {
+            break;  // 이미 비워져 지워진 휴지통
+        }
+        if (flock(fd, LOCK_EX | LOCK_NB) != 0) {
+            close(fd);
+            break;  // 다른 정리 프로세스가 처리 중
+        }
+
+        // 잠금을 가진 동안 지운 항목이 있거나 새 항목이 들어오면 다시 훑음
+        // (지울 수 없는 항목만 남았는데 계속 돌면 잠금을 놓지 않아 다른 정리 프로세스도 막힘)
+        while (reap_pass(fd, trash, opts, &stuck)) {
+        }
+
+        // 빈 휴지통은 지우고 (남은 항목이 있으면 ENOTEMPTY로 실패) 잠금을 놓음
+        unlinkat(AT_FDCWD, trash, AT_REMOVEDIR);
+        flock(fd, LOCK_UN);
+        close(fd);
+
+        // 잠금을 놓기 직전에 들어와 다른 정리 프로세스가 포기한 항목이 있으면 다시 정리
+        if (!has_new_entries(trash, &stuck)) {
+            break;
+        }
+    }
+    name_list_free(&stuck);
+}
+
+void trash_start_reaper(const rm_options_t *opts) {
+    if (trash_dir_count == 0) {
+        return;
+    }
+    fflush(stdout);
+    fflush(stderr);
+
+    // 두 번 fork하여 정리 프로세스를 init의 자식으로 만듦 (rm은 기다리지 않고 종료)
+    pid_t child = fork();
+    if (child < 0) {
+        return;  // 휴지통에 남은 항목은 다음 rm --trash의 정리 프로세스가 지움
+    }
+    if (child > 0) {
+        waitpid(child, NULL, 0);
+        return;
+    }
+
+    setsid();
+    if (fork() != 0) {
+        _exit(0);
+    }
+
+    // 터미널과 분리하고 CPU, I/O 우선순위를 가장 낮춤
+    int null_fd = open("/dev/null", O_RDWR);
+    if (null_fd >= 0) {
+        dup2(null_fd, STDIN_FILENO);
+        dup2(null_fd, STDOUT_FILENO);
+        dup2(null_fd, STDERR_FILENO);
+        if (null_fd > STDERR_FILENO) {
+            close(null_fd);
+        }
+    }
+    if (chdir("/") != 0) {
+        _exit(1);
+    }
+    setpriority(PRIO_PROCESS, 0, 19);
+    syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, 0, IOPRIO_CLASS_IDLE << IOPRIO_CLASS_SHIFT);
+
+    // 메시지 없이 병렬 삭제 엔진으로 지움
+    rm_options_t reaper_opts = *opts;
+    reaper_opts.force = true;
+    reaper_opts.verbose = false;
+    reaper_opts.interactive = false;
+    reaper_opts.zero_only = false;
+    reaper_opts.jobs = opts->jobs > 1 ? opts->jobs : RM_REAPER_JOBS;
+
+    for (int i = 0; i < trash_dir_count; i++) {
+        reap_trash(trash_dirs[i], &reaper_opts);
+    }
+    _exit(0);
+}
@@ -0,0 +1,47 @@
+#ifndef RM_TRASH_H
+#define RM_TRASH_H
+
+#include "rm_options.h"
+#include <sys/stat.h>
+
+// 휴지통 디렉토리 이름 접두어 (실제 이름은 ".rm-trash-<uid>", 파일시스템의 최상위에 만듦)
+#define RM_TRASH_PREFIX ".rm-trash-"
+
+// 정리 프로세스가 -j 없이 사용할 작업 스레드 수
+#define RM_REAPER_JOBS 4
+
+// 정리 프로세스가 지우지 못한 항목과 이유를 남기는 파일 (휴지통 안, 정리 대상에서 제외)
+#define RM_TRASH_FAILED_LOG ".reap-failed"
+
+/**
+ * 경로를 같은 파일시스템의 휴지통으로 옮기는 함수 (--trash, -T)
+ *
+ * 경로가 있는 파일시스템의 최상위 디렉토리에 사용자별 휴지통을 만들고
+ * rename 한 번으로 옮기므로 트리 크기와 무관하게 바로 끝남.
+ * 최상위에 만들 수 없으면 (권한, bind mount 등) 경로의 상위 디렉토리에 만듦.
+ * -z, -r, -i 처리는 일반 삭제와 같음.
+ * 이전 정리 프로세스가 지우지 못한 항목이 남아 있는 휴지통이면 (-f가 아닐 때) 경고함.
+ *
+ * @param filepath 옮길 경로
+ * @param st filepath의 lstat 정보
+ * @param opts 삭제 옵션
+ * @return 0: 성공(건너뜀 포함), -1: 실패, 1: 휴지통을 쓸 수 없음 (호출자가 바로 삭제해야 함)
+ */
+int trash_file(const char *filepath, const struct stat *st, const rm_options_t *opts);
+
+/**
+ * 휴지통을 비우는 정리 프로세스를 백그라운드로 시작하는 함수
+ *
+ * trash_file로 옮긴 휴지통들에 대해 터미널과 분리된 프로세스를 만들고 바로 반환함.
+ * 정리 프로세스는 nice 19, I/O 우선순위 IDLE로 낮춘 뒤 휴지통마다 flock을 잡고
+ * 항목들을 병렬 삭제 엔진으로 지움. 이미 다른 정리 프로세스가 잠금을 가진
+ * 휴지통은 그 프로세스에 맡김 (잠금을 놓은 뒤 새 항목이 있으면 다시 정리함).
+ * 한 번 훑을 때 지운 항목도 새 항목도 없으면 (권한, immutable 등으로 지울 수 없는
+ * 항목만 남음) 그 이유를 RM_TRASH_FAILED_LOG에 남기고 잠금을 놓은 뒤 끝냄.
+ * 옮긴 항목이 없으면 아무것도 하지 않음.
+ *
+ * @param opts 삭제 옵션 (opts->jobs가 2 이상이면 그만큼, 아니면 RM_REAPER_JOBS개 스레드)
+ */
+void trash_start_reaper(const rm_options_t *opts);
+
+#endif // RM_TRASH_H
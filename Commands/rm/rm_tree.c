@@ -0,0 +1,483 @@
+#include "rm_tree.h"
+#include "rm_filter.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <sys/stat.h>
+
+/**
+ * 삭제 중인 디렉토리 하나
+ */
+typedef struct rm_dir {
+    struct rm_dir *parent;      // 상위 디렉토리 (시작 디렉토리면 NULL)
+    char *path;                 // 디렉토리 경로 (메시지 출력용)
+    size_t path_len;            // 경로 길이
+    const char *name;           // 상위 디렉토리 fd 기준 이름 (path 안을 가리킴)
+    DIR *dp;                    // 읽기 작업이 연 디렉토리 (rmdir 직전까지 열어 두고 fd를 하위 작업이 사용)
+    atomic_long pending;        // 끝나지 않은 작업 수 (0이 되면 rmdir)
+    atomic_int failed;          // 하위 항목 중 삭제하지 못한 것이 있으면 1
+    atomic_int kept;            // 필터로 남긴 하위 항목이 있으면 1 (오류 없이 디렉토리를 남김)
+    atomic_llong bytes;         // 계획 모드: 하위 트리의 크기 합계
+    atomic_llong files;         // 계획 모드: 하위 트리의 디렉토리가 아닌 항목 수
+} rm_dir_t;
+
+/**
+ * 작업 하나 (디렉토리 읽기 또는 파일 묶음 삭제)
+ */
+typedef struct rm_task {
+    rm_dir_t *dir;              // 작업 대상 디렉토리
+    char *names;                // 삭제할 파일 이름들 ('\0'으로 구분, NULL이면 디렉토리 읽기 작업)
+    int name_count;             // names의 이름 수
+    struct rm_task *next;       // 작업 스택의 다음 작업
+} rm_task_t;
+
+/**
+ * 작업 스레드들이 공유하는 삭제 상태
+ */
+typedef struct {
+    const rm_options_t *opts;
+    rm_plan_t *plan;            // 계획 모드(--dry-run)면 삭제 대신 크기를 더할 계획, 아니면 NULL
+    int root_dirfd;             // 시작 디렉토리가 있는 디렉토리의 fd (AT_FDCWD 가능)
+    pthread_mutex_t lock;       // 작업 스택과 done 보호
+    pthread_cond_t cond;        // 새 작업 또는 삭제 종료를 알림
+    rm_task_t *stack;           // 작업 스택 (깊이 우선에 가깝게 진행되어 메모리 사용이 적음)
+    bool filtered;              // 필터 옵션이 있는지 (filter_active)
+    bool done;                  // 시작 디렉토리까지 처리가 끝났는지
+    int result;                 // 시작 디렉토리의 결과 (0: 성공, -1: 실패, 1: 필터로 남김)
+} rm_tree_t;
+
+/**
+ * 작업 스택에 작업을 추가하는 함수
+ * 호출 전에 dir->pending을 미리 늘려 두어야 함
+ */
+static void push_task(rm_tree_t *tree, rm_dir_t *dir, char *names, int name_count) {
+    rm_task_t *task = malloc(sizeof(rm_task_t));
+    if (!task) {
+        fprintf(stderr, "rm: memory allocation failed\n");
+        exit(1);
+    }
+    task->dir = dir;
+    task->names = names;
+    task->name_count = name_count;
+
+    pthread_mutex_lock(&tree->lock);
+    task->next = tree->stack;
+    tree->stack = task;
+    pthread_cond_signal(&tree->cond);
+    pthread_mutex_unlock(&tree->lock);
+}
+
+/**
+ * 디렉토리 경로 뒤에 이름을 붙일 때 '/'가 필요한지 확인하는 함수 ("dir/"처럼 주어진 경우 제외)
+ */
+static size_t needs_slash(const rm_dir_t *dir) {
+    return dir->path_len > 0 && dir->path[dir->path_len - 1] != '/';
+}
+
+/**
+ * 새 디렉토리 노드를 만드는 함수 (자기 읽기 작업 하나를 pending으로 가짐)
+ * 시작 디렉토리는 parent가 NULL이고 name을 그대로 메시지용 경로로 사용
+ */
+static rm_dir_t *new_dir(rm_dir_t *parent, const char *name) {
+    rm_dir_t *dir = malloc(sizeof(rm_dir_t));
+    size_t name_len = strlen(name);
+    size_t prefix = parent ? parent->path_len + needs_slash(parent) : 0;
+    char *path = malloc(prefix + name_len + 1);
+    if (!dir || !path) {
+        fprintf(stderr, "rm: memory allocation failed\n");
+        exit(1);
+    }
+    if (parent) {
+        memcpy(path, parent->path, parent->path_len);
+        path[prefix - 1] = '/';
+    }
+    memcpy(path + prefix, name, name_len + 1);
+    dir->parent = parent;
+    dir->path = path;
+    dir->path_len = prefix + name_len;
+    dir->name = path + prefix;
+    dir->dp = NULL;
+    atomic_init(&dir->pending, 1);
+    atomic_init(&dir->failed, 0);
+    atomic_init(&dir->kept, 0);
+    atomic_init(&dir->bytes, 0);
+    atomic_init(&dir->files, 0);
+    return dir;
+}
+
+/**
+ * 디렉토리가 있는 상위 디렉토리의 fd를 구하는 함수
+ * 상위 디렉토리는 하위 작업이 모두 끝날 때까지 열려 있으므로 항상 유효함
+ */
+static int parent_fd(const rm_tree_t *tree, const rm_dir_t *dir) {
+    return dir->parent ? dirfd(dir->parent->dp) : tree->root_dirfd;
+}
+
+/**
+ * 메시지 출력용으로 "디렉토리 경로/이름"을 버퍼에 만드는 함수
+ */
+static const char *entry_path(const rm_dir_t *dir, const char *name, char **buf, size_t *cap) {
+    size_t name_len = strlen(name);
+    size_t prefix = dir->path_len + needs_slash(dir);
+    size_t need = prefix + name_len + 1;
+    if (need > *cap) {
+        *cap = need * 2;
+        *buf = realloc(*buf, *cap);
+        if (!*buf) {
+            fprintf(stderr, "rm: memory allocation failed\n");
+            exit(1);
+        }
+    }
+    memcpy(*buf, dir->path, dir->path_len);
+    (*buf)[prefix - 1] = '/';
+    memcpy(*buf + prefix, name, name_len + 1);
+    return *buf;
+}
+
+/**
+ * 필터에 걸린 항목을 남기는 함수 (디렉토리는 비지 않으므로 삭제하지 않게 표시)
+ */
+static void keep_entry(rm_tree_t *tree, rm_dir_t *dir, const char *name, char **path, size_t *path_cap) {
+    atomic_store(&dir->kept, 1);
+    if (tree->opts->verbose && !tree->plan) {
+        printf("skipped '%s'\n", entry_path(dir, name, path, path_cap));
+    }
+}
+
+/**
+ * 디렉토리의 작업 하나가 끝났음을 알리는 함수
+ * 마지막 작업이었다면 디렉토리를 닫고 상위 디렉토리 fd 기준으로 rmdir한 뒤
+ * 부모에게 같은 처리를 이어감 (계획 모드에서는 rmdir 대신 하위 트리 합계를
+ * 기록하고 부모의 합계에 더함)
+ */
+static void finish_dir(rm_tree_t *tree, rm_dir_t *dir) {
+    while (dir && atomic_fetch_sub(&dir->pending, 1) == 1) {
+        rm_dir_t *parent = dir->parent;
+        int ok = !atomic_load(&dir->failed);
+        int kept = atomic_load(&dir->kept);
+
+        if (tree->plan) {
+            long long bytes = atomic_load(&dir->bytes);
+            long long files = atomic_load(&dir->files);
+            struct stat st;
+
+            // 비게 될 디렉토리만 자체 크기를 더함 (dp는 읽기에 성공했으면 열려 있음)
+            bool removed = ok && !kept && fstat(dirfd(dir->dp), &st) == 0;
+            if (removed) {
+                bytes += plan_add_entry(tree->plan, &st);
+            }
+            if (removed || files > 0) {
+                plan_add_dir(tree->plan, dir->path, bytes, files);
+            }
+            if (parent) {
+                atomic_fetch_add(&parent->bytes, bytes);
+                atomic_fetch_add(&parent->files, files);
+            }
+        }
+
+        if (dir->dp) {
+            closedir(dir->dp);
+        }
+
+        if (!tree->plan && ok && !kept) {
+            // 하위 항목을 모두 지운 경우에만 디렉토리 자체 삭제
+            if (unlinkat(parent_fd(tree, dir), dir->name, AT_REMOVEDIR) != 0) {
+                if (!tree->opts->force) {
+                    fprintf(stderr, "rm: cannot remove directory '%s': %s\n",
+                            dir->path, strerror(errno));
+                }
+                ok = 0;
+            } else if (tree->opts->verbose) {
+                printf("removed directory '%s'\n", dir->path);
+            }
+        }
+
+        if (parent) {
+            if (!ok) {
+                atomic_store(&parent->failed, 1);
+            }
+            if (kept) {
+                atomic_store(&parent->kept, 1);
+            }
+        } else {
+            // 시작 디렉토리까지 끝남: 대기 중인 스레드들을 모두 종료시킴
+            pthread_mutex_lock(&tree->lock);
+            tree->result = !ok ? -1 : kept ? 1 : 0;
+            tree->done = true;
+            pthread_cond_broadcast(&tree->cond);
+            pthread_mutex_unlock(&tree->lock);
+        }
+
+        free(dir->path);
+        free(dir);
+        dir = parent;
+    }
+}
+
+/**
+ * 파일 이름 묶음을 삭제하는 함수
+ */
+static void unlink_batch(rm_tree_t *tree, rm_dir_t *dir, const char *names, int name_count) {
+    int fd = dirfd(dir->dp);
+    char *path = NULL;  // 메시지를 출력할 때만 만듦
+    size_t path_cap = 0;
+
+    for (int i = 0; i < name_count; i++) {
+        // 필터: 크기나 나이 조건이 있을 때만 fstatat (묶음의 항목은 디렉토리가 아님)
+        if (tree->filtered) {
+            struct stat st;
+            memset(&st, 0, sizeof(st));
+            if (filter_needs_stat(tree->opts) && fstatat(fd, names, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+                if (!tree->opts->force) {
+                    int err = errno;
+                    fprintf(stderr, "rm: cannot remove '%s': %s\n",
+                            entry_path(dir, names, &path, &path_cap), strerror(err));
+                    atomic_store(&dir->failed, 1);
+                }
+                names += strlen(names) + 1;
+                continue;
+            }
+            if (!filter_accepts(tree->opts, names, &st)) {
+                keep_entry(tree, dir, names, &path, &path_cap);
+                names += strlen(names) + 1;
+                continue;
+            }
+        }
+
+        if (unlinkat(fd, names, 0) != 0) {
+            // force 모드에서는 삭제 실패도 성공으로 처리 (디렉토리 rmdir은 시도)
+            if (!tree->opts->force) {
+                int err = errno;
+                fprintf(stderr, "rm: cannot remove '%s': %s\n",
+                        entry_path(dir, names, &path, &path_cap), strerror(err));
+                atomic_store(&dir->failed, 1);
+            }
+        } else if (tree->opts->verbose) {
+            printf("removed '%s'\n", entry_path(dir, names, &path, &path_cap));
+        }
+        names += strlen(names) + 1;
+    }
+    free(path);
+}
+
+/**
+ * 파일 이름 묶음을 삭제하지 않고 계획에 더하는 함수 (계획 모드)
+ */
+static void plan_batch(rm_tree_t *tree, rm_dir_t *dir, const char *names, int name_count) {
+    int fd = dirfd(dir->dp);
+    char *path = NULL;
+    size_t path_cap = 0;
+    long long bytes = 0;
+    long long files = 0;
+
+    for (int i = 0; i < name_count; i++) {
+        struct stat st;
+        if (fstatat(fd, names, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+            if (!tree->opts->force) {
+                int err = errno;
+                fprintf(stderr, "rm: cannot stat '%s': %s\n",
+                        entry_path(dir, names, &path, &path_cap), strerror(err));
+                atomic_store(&dir->failed, 1);
+            }
+        } else if (tree->filtered && !filter_accepts(tree->opts, names, &st)) {
+            keep_entry(tree, dir, names, &path, &path_cap);
+        } else {
+            bytes += plan_add_entry(tree->plan, &st);
+            files++;
+        }
+        names += strlen(names) + 1;
+    }
+    atomic_fetch_add(&dir->bytes, bytes);
+    atomic_fetch_add(&dir->files, files);
+    free(path);
+}
+
+/**
+ * 파일 이름 묶음을 모드에 맞게 처리하는 함수
+ */
+static void run_batch(rm_tree_t *tree, rm_dir_t *dir, const char *names, int name_count) {
+    if (tree->plan) {
+        plan_batch(tree, dir, names, name_count);
+    } else {
+        unlink_batch(tree, dir, names, name_count);
+    }
+}
+
+/**
+ * 디렉토리를 읽어 하위 디렉토리와 파일 묶음을 작업으로 나누는 함수
+ * 마지막 묶음은 작업으로 넘기지 않고 읽은 스레드가 바로 삭제함
+ */
+static void scan_dir(rm_tree_t *tree, rm_dir_t *dir) {
+    // O_NOFOLLOW: 읽는 사이에 심볼릭 링크로 바뀐 경우에도 링크를 따라가지 않음
+    int fd = openat(parent_fd(tree, dir), dir->name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+    DIR *dp = fd >= 0 ? fdopendir(fd) : NULL;
+    if (!dp) {
+        if (!tree->opts->force) {
+            fprintf(stderr, "rm: cannot open directory '%s': %s\n", dir->path, strerror(errno));
+        }
+        if (fd >= 0) {
+            close(fd);
+        }
+        atomic_store(&dir->failed, 1);
+        return;
+    }
+    dir->dp = dp;  // 하위 작업들이 fd를 쓰므로 rmdir 직전까지 열어 둠
+
+    char *batch = NULL;
+    size_t batch_len = 0, batch_cap = 0;
+    int batch_count = 0;
+    struct dirent *entry;
+
+    while ((entry = readdir(dp)) != NULL) {
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+            continue;
+        }
+
+        // d_type을 모르는 파일시스템에서만 fstatat (심볼릭 링크는 따라가지 않음)
+        bool is_dir = entry->d_type == DT_DIR;
+        if (entry->d_type == DT_UNKNOWN) {
+            struct stat st;
+            is_dir = fstatat(fd, entry->d_name, &st, AT_SYMLINK_NOFOLLOW) == 0 && S_ISDIR(st.st_mode);
+        }
+
+        if (is_dir) {
+            // --exclude에 걸린 디렉토리는 하위 트리 전체를 남김
+            if (tree->filtered) {
+                struct stat st;
+                memset(&st, 0, sizeof(st));
+                st.st_mode = S_IFDIR;
+                if (!filter_accepts(tree->opts, entry->d_name, &st)) {
+                    char *path = NULL;
+                    size_t path_cap = 0;
+                    keep_entry(tree, dir, entry->d_name, &path, &path_cap);
+                    free(path);
+                    continue;
+                }
+            }
+            // 하위 디렉토리는 다른 스레드도 가져갈 수 있도록 작업으로 추가
+            atomic_fetch_add(&dir->pending, 1);
+            push_task(tree, new_dir(dir, entry->d_name), NULL, 0);
+            continue;
+        }
+
+        size_t name_len = strlen(entry->d_name) + 1;
+        if (batch_len + name_len > batch_cap) {
+            batch_cap = (batch_len + name_len) * 2;
+            batch = realloc(batch, batch_cap);
+            if (!batch) {
+                fprintf(stderr, "rm: memory allocation failed\n");
+                exit(1);
+            }
+        }
+        memcpy(batch + batch_len, entry->d_name, name_len);
+        batch_len += name_len;
+
+        // 묶음이 차면 다른 스레드가 지울 수 있도록 작업으로 넘김
+        if (++batch_count == RM_BATCH_FILES) {
+            atomic_fetch_add(&dir->pending, 1);
+            push_task(tree, dir, batch, batch_count);
+            batch = NULL;
+            batch_len = batch_cap = 0;
+            batch_count = 0;
+        }
+    }
+    if (batch_count > 0) {
+        run_batch(tree, dir, batch, batch_count);
+    }
+    free(batch);
+}
+
+/**
+ * 작업 스레드 본체
+ * 시작 디렉토리가 삭제될 때까지(done) 스택에서 작업을 꺼내 처리
+ */
+static void *rm_worker(void *arg) {
+    rm_tree_t *tree = arg;
+
+    for (;;) {
+        pthread_mutex_lock(&tree->lock);
+        while (tree->stack == NULL && !tree->done) {
+            pthread_cond_wait(&tree->cond, &tree->lock);
+        }
+        if (tree->stack == NULL) {
+            pthread_mutex_unlock(&tree->lock);
+            break;  // 남은 작업이 없음
+        }
+        rm_task_t *task = tree->stack;
+        tree->stack = task->next;
+        pthread_mutex_unlock(&tree->lock);
+
+        if (task->names) {
+            run_batch(tree, task->dir, task->names, task->name_count);
+            free(task->names);
+        } else {
+            scan_dir(tree, task->dir);
+        }
+        finish_dir(tree, task->dir);
+        free(task);
+    }
+    return NULL;
+}
+
+/**
+ * 작업 스레드들로 트리를 처리하는 공통 함수 (plan이 NULL이면 삭제, 아니면 계획)
+ */
+static int run_tree(int dirfd, const char *name, const char *dirpath, const rm_options_t *opts,
+                    rm_plan_t *plan, int worker_count) {
+    rm_tree_t tree;
+
+    memset(&tree, 0, sizeof(tree));
+    tree.opts = opts;
+    tree.plan = plan;
+    tree.filtered = filter_active(opts);
+    tree.root_dirfd = dirfd;
+    pthread_mutex_init(&tree.lock, NULL);
+    pthread_cond_init(&tree.cond, NULL);
+
+    // 시작 디렉토리의 메시지용 경로는 dirpath, 시스템 콜에 쓰는 이름은 name
+    rm_dir_t *root = new_dir(NULL, dirpath);
+    root->name = name;
+    push_task(&tree, root, NULL, 0);
+
+    // 작업 스레드 실행 (생성에 실패하면 호출 스레드가 직접 처리)
+    pthread_t *workers = malloc(worker_count * sizeof(pthread_t));
+    int started = 0;
+    for (int i = 0; workers && i < worker_count; i++) {
+        if (pthread_create(&workers[started], NULL, rm_worker, &tree) == 0) {
+            started++;
+        }
+    }
+    if (started == 0) {
+        rm_worker(&tree);
+    }
+    for (int i = 0; i < started; i++) {
+        pthread_join(workers[i], NULL);
+    }
+    free(workers);
+
+    pthread_mutex_destroy(&tree.lock);
+    pthread_cond_destroy(&tree.cond);
+    return tree.result;
+}
+
+int remove_tree_parallel(int dirfd, const char *name, const char *dirpath, const rm_options_t *opts) {
+    return run_tree(dirfd, name, dirpath, opts, NULL, opts->jobs);
+}
+
+int plan_tree_parallel(int dirfd, const char *name, const char *dirpath, const rm_options_t *opts,
+                       rm_plan_t *plan) {
+    int worker_count = opts->jobs;
+
+    // -j가 없으면 CPU 수만큼 (최대 RM_PLAN_JOBS) 병렬로 탐색
+    if (worker_count <= 1) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        worker_count = cpus < 1 ? 1 : cpus > RM_PLAN_JOBS ? RM_PLAN_JOBS : (int)cpus;
+    }
+    return run_tree(dirfd, name, dirpath, opts, plan, worker_count);
+}
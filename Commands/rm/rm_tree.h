@@ -0,0 +1,52 @@
+#ifndef RM_TREE_H
+#define RM_TREE_H
+
+#include "rm_options.h"
+#include "rm_plan.h"
+
+// 파일 삭제 작업 하나에 묶는 최대 파일 수 (한 디렉토리의 파일을 여러 스레드가 나눠 지움)
+#define RM_BATCH_FILES 256
+
+// 계획 모드에서 -j 없이 사용할 최대 작업 스레드 수
+#define RM_PLAN_JOBS 16
+
+/**
+ * 디렉토리 트리를 여러 스레드로 병렬 삭제하는 함수 (-r -j N)
+ *
+ * 작업 스레드들이 디렉토리를 읽어 하위 디렉토리는 새 작업으로, 파일은
+ * RM_BATCH_FILES개씩 묶어 삭제 작업으로 나누어 동시에 처리함.
+ * 각 디렉토리는 남은 작업 수(자기 읽기 + 하위 디렉토리 + 파일 묶음)를
+ * 원자적 카운터로 세고, 0이 되는 순간 그 작업을 끝낸 스레드가 바로 rmdir한 뒤
+ * 부모의 카운터를 줄임 (아래에서 위로 삭제).
+ * 하위 항목 삭제에 실패한 디렉토리와 그 상위 디렉토리는 삭제하지 않음.
+ * 필터 옵션(rm_filter)에 걸린 항목은 남기고, 그 항목이 있는 디렉토리들도
+ * 오류 없이 남김.
+ * 모든 시스템 콜은 열어 둔 상위 디렉토리 fd 기준(openat, fstatat, unlinkat)으로
+ * 하므로 항목마다 전체 경로를 다시 해석하지 않음 (경로는 메시지 출력에만 사용).
+ *
+ * @param dirfd 삭제할 디렉토리가 있는 디렉토리의 fd (AT_FDCWD면 현재 디렉토리)
+ * @param name dirfd 기준 디렉토리 이름
+ * @param dirpath 메시지 출력용 디렉토리 경로
+ * @param opts 삭제 옵션 (opts->jobs개의 작업 스레드 사용)
+ * @return 0: 성공, -1: 하나라도 실패, 1: 필터로 남긴 항목이 있어 디렉토리를 남김
+ */
+int remove_tree_parallel(int dirfd, const char *name, const char *dirpath, const rm_options_t *opts);
+
+/**
+ * 디렉토리 트리를 삭제하지 않고 삭제 계획만 세우는 함수 (--dry-run)
+ *
+ * remove_tree_parallel과 같은 엔진으로 탐색하되 파일 묶음마다 unlinkat 대신
+ * fstatat으로 크기를 계획에 더하고, 디렉토리가 끝나면 rmdir 대신 하위 트리
+ * 합계를 기록해 부모에게 넘김. 파일시스템은 전혀 바꾸지 않음.
+ *
+ * @param dirfd 디렉토리가 있는 디렉토리의 fd (AT_FDCWD면 현재 디렉토리)
+ * @param name dirfd 기준 디렉토리 이름
+ * @param dirpath 메시지와 내역 출력용 디렉토리 경로
+ * @param opts 삭제 옵션 (opts->jobs가 2 이상이면 그만큼, 아니면 CPU 수만큼 스레드 사용)
+ * @param plan 크기를 더할 삭제 계획
+ * @return 0: 성공, -1: 읽지 못한 항목이 있음, 1: 필터로 남길 항목이 있음
+ */
+int plan_tree_parallel(int dirfd, const char *name, const char *dirpath, const rm_options_t *opts,
+                       rm_plan_t *plan);
+
+#endif // RM_TREE_H